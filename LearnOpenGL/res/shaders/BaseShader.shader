@@ -1,34 +1,33 @@
 #shader vertex
 #version 330 core
 
-layout(location = 0) in vec3 v_position;
-layout(location = 1) in vec3 v_color;
-layout(location = 2) in vec2 v_texCoord;
+layout(location = 0) in vec2 v_position;
+layout(location = 1) in vec2 v_texCoord;
+
+#include "include/UniformBlocks.glsl"
 
-out vec3 vs_position;
-out vec3 vs_color;
 out vec2 vs_texCoord;
 
 void main()
 {
-   vs_position = v_position;
-   vs_color = v_color;
-   v_texCoord = vec2(v_texCoord.x, v_texCoord.y * -1.f);
+   vs_texCoord = v_texCoord;
 
-   gl_Position = vec4(v_position, 1.f);
+   gl_Position = u_ViewProj * u_Model * vec4(v_position, 0.f, 1.f);
 }
  
 
 #shader fragment
 #version 330 core
 
-in vec3 vs_position;
-in vec3 vs_color;
+#include "include/UniformBlocks.glsl"
+
 in vec2 vs_texCoord;
 
+uniform sampler2D u_Texture;
+
 out vec4 fs_color;
 
 void main()
 {
-	fs_color = vec4(vs_color, 1.f);
+	fs_color = texture(u_Texture, vs_texCoord) * u_Color;
 }
\ No newline at end of file
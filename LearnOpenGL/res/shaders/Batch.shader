@@ -0,0 +1,69 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec3 v_position;
+layout(location = 1) in vec4 v_color;
+layout(location = 2) in vec2 v_texCoord;
+layout(location = 3) in float v_texIndex;
+
+uniform mat4 u_ViewProj;
+
+out vec4 vs_color;
+out vec2 vs_texCoord;
+flat out int vs_texIndex;
+
+void main()
+{
+   vs_color = v_color;
+   vs_texCoord = v_texCoord;
+   vs_texIndex = int(v_texIndex);
+
+   gl_Position = u_ViewProj * vec4(v_position, 1.f);
+}
+ 
+
+#shader fragment
+#version 330 core
+
+in vec4 vs_color;
+in vec2 vs_texCoord;
+flat in int vs_texIndex;
+
+#ifdef TEXTURE_ARRAY
+uniform sampler2DArray u_TextureArray;		//The index is a layer
+#else
+uniform sampler2D u_Textures[16];
+#endif
+
+out vec4 fs_color;
+
+void main()
+{
+#ifdef TEXTURE_ARRAY
+	vec4 texColor = texture(u_TextureArray, vec3(vs_texCoord, vs_texIndex));
+#else
+	//GLSL 3.30 only allows constant indices into sampler arrays
+	vec4 texColor;
+	switch (vs_texIndex)
+	{
+		case  0: texColor = texture(u_Textures[ 0], vs_texCoord); break;
+		case  1: texColor = texture(u_Textures[ 1], vs_texCoord); break;
+		case  2: texColor = texture(u_Textures[ 2], vs_texCoord); break;
+		case  3: texColor = texture(u_Textures[ 3], vs_texCoord); break;
+		case  4: texColor = texture(u_Textures[ 4], vs_texCoord); break;
+		case  5: texColor = texture(u_Textures[ 5], vs_texCoord); break;
+		case  6: texColor = texture(u_Textures[ 6], vs_texCoord); break;
+		case  7: texColor = texture(u_Textures[ 7], vs_texCoord); break;
+		case  8: texColor = texture(u_Textures[ 8], vs_texCoord); break;
+		case  9: texColor = texture(u_Textures[ 9], vs_texCoord); break;
+		case 10: texColor = texture(u_Textures[10], vs_texCoord); break;
+		case 11: texColor = texture(u_Textures[11], vs_texCoord); break;
+		case 12: texColor = texture(u_Textures[12], vs_texCoord); break;
+		case 13: texColor = texture(u_Textures[13], vs_texCoord); break;
+		case 14: texColor = texture(u_Textures[14], vs_texCoord); break;
+		default: texColor = texture(u_Textures[15], vs_texCoord); break;
+	}
+#endif
+
+	fs_color = texColor * vs_color;
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec2 v_position;
+layout(location = 1) in vec2 v_texCoord;
+layout(location = 2) in mat4 i_model;		//Per instance, takes up locations 2 to 5
+#ifdef TEXTURE_ARRAY
+layout(location = 6) in float i_layer;		//Per instance
+#endif
+
+uniform mat4 u_ViewProj;
+
+out vec2 vs_texCoord;
+#ifdef TEXTURE_ARRAY
+flat out float vs_layer;
+#endif
+
+void main()
+{
+   vs_texCoord = v_texCoord;
+#ifdef TEXTURE_ARRAY
+   vs_layer = i_layer;
+#endif
+
+   gl_Position = u_ViewProj * i_model * vec4(v_position, 0.f, 1.f);
+}
+ 
+
+#shader fragment
+#version 330 core
+
+in vec2 vs_texCoord;
+#ifdef TEXTURE_ARRAY
+flat in float vs_layer;
+
+uniform sampler2DArray u_TextureArray;
+#else
+uniform sampler2D u_Texture;
+#endif
+
+out vec4 fs_color;
+
+void main()
+{
+#ifdef TEXTURE_ARRAY
+	fs_color = texture(u_TextureArray, vec3(vs_texCoord, vs_layer));
+#else
+	fs_color = texture(u_Texture, vs_texCoord);
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec4 v_position;	//Quantized formats pad xyz with w = 0, only xyz is used
+layout(location = 1) in vec4 v_normal;
+layout(location = 2) in vec2 v_texCoord;
+layout(location = 3) in uint v_material;	//Integer attribute (glVertexAttribIPointer)
+
+uniform mat4 u_MVP;		//Includes the dequantization scale & offset of the positions
+
+out vec2 vs_texCoord;
+out vec3 vs_normal;
+flat out vec3 vs_color;
+
+const vec3 materialColors[4] = vec3[4](vec3(1.0, 0.4, 0.4), vec3(0.4, 1.0, 0.4), vec3(0.4, 0.4, 1.0), vec3(1.0, 1.0, 0.4));
+
+void main()
+{
+   vs_texCoord = v_texCoord;
+   vs_normal = v_normal.xyz;
+   vs_color = materialColors[v_material & 3u];
+
+   gl_Position = u_MVP * vec4(v_position.xyz, 1.f);
+}
+ 
+
+#shader fragment
+#version 330 core
+
+in vec2 vs_texCoord;
+in vec3 vs_normal;
+flat in vec3 vs_color;
+
+uniform sampler2D u_Texture;
+
+out vec4 fs_color;
+
+void main()
+{
+	float light = max(dot(normalize(vs_normal), normalize(vec3(0.4, 0.6, 1.0))), 0.0) * 0.8 + 0.2;
+	fs_color = vec4(texture(u_Texture, vs_texCoord).rgb * vs_color * light, 1.0);
+}
\ No newline at end of file
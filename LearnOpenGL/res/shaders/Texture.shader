@@ -0,0 +1,36 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec2 v_position;
+layout(location = 1) in vec2 v_texCoord;
+
+uniform mat4 u_MVP;
+
+out vec2 vs_texCoord;
+
+void main()
+{
+   vs_texCoord = v_texCoord;
+
+   gl_Position = u_MVP * vec4(v_position, 0.f, 1.f);
+}
+ 
+
+#shader fragment
+#version 330 core
+
+in vec2 vs_texCoord;
+
+uniform sampler2D u_Texture;
+
+out vec4 fs_color;
+
+void main()
+{
+	fs_color = texture(u_Texture, vs_texCoord);
+
+#ifdef ALPHA_TEST
+	if (fs_color.a < 0.5)
+		discard;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+//Shared uniform blocks, the layouts have to match the structs in UniformBuffer.h
+
+layout(std140) uniform PerFrame
+{
+	float u_Time;
+	float u_DeltaTime;
+	vec2 u_Resolution;
+};
+
+layout(std140) uniform PerView
+{
+	mat4 u_View;
+	mat4 u_Proj;
+	mat4 u_ViewProj;
+};
+
+layout(std140) uniform PerObject
+{
+	mat4 u_Model;
+	vec4 u_Color;
+};
\ No newline at end of file
@@ -13,12 +13,47 @@
 #include <sstream>
 #include <memory>
 
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "UniformBuffer.h"
+#include "SamplerCache.h"
+#include "VertexArrayCache.h"
+#include "ProgramBinaryCache.h"
+#include "ShaderLibrary.h"
+#include "ShaderHotReloader.h"
+#include "AsyncTextureLoader.h"
+#include "ResourceCache.h"
+#include "UploadManager.h"
+#include "TextureStreamer.h"
 #include "tests/TestClearColor.h"
 #include "tests/TestTexture2D.h"
-
-
-int main(void)
+#include "tests/TestBatchRendering.h"
+#include "tests/TestInstancing.h"
+#include "tests/TestRenderQueue.h"
+#include "tests/TestErrorChecking.h"
+#include "tests/TestShaderLoading.h"
+#include "tests/TestAsyncTextures.h"
+#include "tests/TestCompressedTextures.h"
+#include "tests/TestMipmaps.h"
+#include "tests/TestTextureStreaming.h"
+#include "tests/TestTextureAtlas.h"
+#include "tests/TestTextureArrays.h"
+#include "tests/TestGpuHeap.h"
+#include "tests/TestVertexFormats.h"
+#include "tests/TestVertexArrayCache.h"
+#include "tests/TestIndexBuffers.h"
+#include "tools/TextureEncoder.h"
+#include "tools/AtlasPacker.h"
+
+
+int main(int argc, char** argv)
 {
+    //Offline tools run without a window
+    if (argc > 1 && std::string(argv[1]) == "--encode-texture")
+        return tools::RunTextureEncoder(argc - 2, argv + 2);
+    if (argc > 1 && std::string(argv[1]) == "--pack-atlas")
+        return tools::RunAtlasPacker(argc - 2, argv + 2);
+
     GLFWwindow* window;
 
     //Initializing GLFW
@@ -29,6 +64,10 @@ int main(void)
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);  //Setting OpenGL version: 3._
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);  //Setting OpenGL version: 3.3
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);  
+    glfwWindowHint(GLFW_SRGB_CAPABLE, GL_TRUE);  //So GL_FRAMEBUFFER_SRGB can encode the output of sRGB textures
+#if defined(_DEBUG) || GL_ERROR_CHECK == GL_ERROR_CHECK_DEBUG_OUTPUT_ASYNC || GL_ERROR_CHECK == GL_ERROR_CHECK_DEBUG_OUTPUT_SYNC
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);  //Debug output is only guaranteed in a debug context
+#endif
 
 
     //Creating Window
@@ -49,12 +88,44 @@ int main(void)
         std::cout << "ERROR::Application.cpp::Main():: Failed to initialize GLEW" << std::endl;
 
     std::cout << glGetString(GL_VERSION) << std::endl;
+    SetGLErrorMode((GLErrorMode)GL_ERROR_CHECK);
+
+    //Texture containers are loaded on worker threads, they get the size limit from here
+    GLint maxTextureSize = 0;
+    glErrorCall( glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize) );
+    TextureCompressor::SetMaxDimension(maxTextureSize);
 
     {
-        glErrorCall( glEnable(GL_BLEND) );
-        glErrorCall( glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA) );
+        GLStateCache::Get().Enable(GL_BLEND);
+        GLStateCache::Get().BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
         Renderer renderer;
+        FrameUniforms frameUniforms;
+        SamplerCache samplerCache;
+        VertexArrayCache vertexArrayCache;
+        UploadManager uploadManager;
+        AsyncTextureLoader textureLoader;
+        TextureStreamer textureStreamer;
+        ResourceCache resourceCache;	//Last, so it lets go of its resources while the loaders still exist
+        float lastTime = (float)glfwGetTime();
+
+        //Setting every shader up once, the first run compiles them (cold) & later runs load the cached binaries (warm)
+        {
+            const char* shaderFiles[] = { "res/shaders/BaseShader.shader", "res/shaders/Batch.shader",
+                "res/shaders/Instanced.shader", "res/shaders/Texture.shader" };
+            //Submitting them all before waiting on any, so a driver with parallel compilation builds them side by side
+            ShaderLibrary shaderLibrary;
+            for (const char* shaderFile : shaderFiles)
+                shaderLibrary.Load(shaderFile);
+            shaderLibrary.WaitAll();
+
+            const ProgramBinaryCache::Stats& shaderStats = ProgramBinaryCache::Get().GetStats();
+            std::cout << "Shader setup: " << shaderStats.warmCount << " warm in " << shaderStats.warmTime << " ms, "
+                << shaderStats.coldCount << " cold in " << shaderStats.coldTime << " ms";
+            if (!ProgramBinaryCache::Get().IsSupported())
+                std::cout << " (program binaries not supported)";
+            std::cout << std::endl;
+        }
 
 
         //  ImGui   //
@@ -72,6 +143,21 @@ int main(void)
         //Creating new test in the menu
         testMenu->RegisterTest<test::TestClearColor>("Clear Color Test");
         testMenu->RegisterTest<test::TestTexture2D>("2D Texture Test");
+        testMenu->RegisterTest<test::TestBatchRendering>("Batch Rendering Test");
+        testMenu->RegisterTest<test::TestInstancing>("Instancing Test");
+        testMenu->RegisterTest<test::TestRenderQueue>("Render Queue Test");
+        testMenu->RegisterTest<test::TestErrorChecking>("Error Checking Overhead Test");
+        testMenu->RegisterTest<test::TestShaderLoading>("Shader Loading Test");
+        testMenu->RegisterTest<test::TestAsyncTextures>("Async Texture Loading Test");
+        testMenu->RegisterTest<test::TestCompressedTextures>("Compressed Texture Test");
+        testMenu->RegisterTest<test::TestMipmaps>("Mipmap Test");
+        testMenu->RegisterTest<test::TestTextureStreaming>("Texture Streaming Test");
+        testMenu->RegisterTest<test::TestTextureAtlas>("Texture Atlas Test");
+        testMenu->RegisterTest<test::TestTextureArrays>("Texture Array Test");
+        testMenu->RegisterTest<test::TestGpuHeap>("GPU Heap Test");
+        testMenu->RegisterTest<test::TestVertexFormats>("Vertex Format Test");
+        testMenu->RegisterTest<test::TestVertexArrayCache>("Vertex Array Cache Test");
+        testMenu->RegisterTest<test::TestIndexBuffers>("Index Buffer Test");
 
 
         //  Game Loop   //
@@ -79,8 +165,30 @@ int main(void)
         {
             glErrorCall( glClearColor(0.0f, 0.0f, 0.0f, 1.0f) );
             renderer.Clear();
-
+            GLStateCache::Get().ResetStats();
+            vertexArrayCache.ResetStats();
+
+            //Uploading the per frame block once, every shader reads it from there
+            float time = (float)glfwGetTime();
+            int width, height;
+            glfwGetFramebufferSize(window, &width, &height);
+            frameUniforms.SetFrame({ time, time - lastTime, glm::vec2(width, height) });
+            lastTime = time;
+
+            //Textures decoded since the last frame, then this frame's share of the queued uploads
+            textureLoader.Update();
+            uploadManager.Update();
+            resourceCache.Update();
+            textureStreamer.Update();
+
+#if SHADER_HOT_RELOAD
+            //Picking up edited shader files before anything is drawn with them
+            ShaderHotReloader::Get().Update();
+#endif
+
+            //The ImGui backend binds its own objects, so whatever the cache remembers can't be trusted afterwards
             ImGui_ImplGlfwGL3_NewFrame();
+            GLStateCache::Get().Invalidate();
 
             //Handling the deletion of test pointer
             if (currentTest)
@@ -97,11 +205,39 @@ int main(void)
                 }
                 
                 currentTest->OnImGuiRender();
+
+                const GLStateCache::Stats& cacheStats = GLStateCache::Get().GetStats();
+                ImGui::Text("GL state cache: %u hits, %u misses", cacheStats.hits, cacheStats.misses);
+                ImGui::Text("Vertex arrays: %u cached (%s), %u switches this frame", vertexArrayCache.GetCount(),
+                    vertexArrayCache.UsesAttribBinding() ? "per format" : "per buffer set", cacheStats.vertexArraySwitches);
+
+                const UploadManager::Stats& uploadStats = uploadManager.GetStats();
+                ImGui::Text("Uploads: %u KB in %u chunks this frame, %u pending (%u KB)", uploadStats.bytesUploaded / 1024, uploadStats.chunks,
+                    uploadStats.pendingJobs, uploadStats.pendingBytes / 1024);
+
+                const ProgramBinaryCache::Stats& shaderStats = ProgramBinaryCache::Get().GetStats();
+                ImGui::Text("Shader setup: %u warm (%.2f ms avg), %u cold (%.2f ms avg), %u rejected",
+                    shaderStats.warmCount, shaderStats.warmCount ? shaderStats.warmTime / shaderStats.warmCount : 0.0f,
+                    shaderStats.coldCount, shaderStats.coldCount ? shaderStats.coldTime / shaderStats.coldCount : 0.0f,
+                    shaderStats.rejected);
+
+#if SHADER_HOT_RELOAD
+                const ShaderHotReloader::Stats& reloadStats = ShaderHotReloader::Get().GetStats();
+                ImGui::Text("Shader hot reload: %u shaders, %u files watched, %u reloads, %u failed (last took %.2f ms)",
+                    ShaderHotReloader::Get().GetShaderCount(), ShaderHotReloader::Get().GetWatchedFileCount(),
+                    reloadStats.reloads, reloadStats.failures, reloadStats.lastReloadTime);
+#endif
+                ImGui::End();
+
+                ImGui::Begin("Resources");
+                resourceCache.OnImGuiRender();
                 ImGui::End();
             }
 
             ImGui::Render();
             ImGui_ImplGlfwGL3_RenderDrawData(ImGui::GetDrawData());
+            GLStateCache::Get().Invalidate();
+            frameUniforms.EndFrame();
 
 
             //Swaping front and back buffers
@@ -0,0 +1,213 @@
+#include "AsyncTextureLoader.h"
+#include "stb_image/stb_image.h"
+
+#include <iostream>
+
+
+AsyncTextureLoader* AsyncTextureLoader::instance = nullptr;
+
+//Shown until the real image arrives
+static const unsigned char placeholderPixel[4] = { 128, 128, 128, 255 };
+
+
+//Constructor
+AsyncTextureLoader::AsyncTextureLoader(unsigned int worker_count)
+	: stopping(false), decoded(decodedCapacity), decodedCount(0),
+	decodeLatencyTotal(0.0f), uploadLatencyTotal(0.0f)
+{
+	if (worker_count == 0)
+	{
+		unsigned int hardwareThreads = std::thread::hardware_concurrency();
+		worker_count = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+	}
+
+	for (unsigned int i = 0; i < worker_count; i++)
+		workers.emplace_back(&AsyncTextureLoader::WorkerLoop, this);
+
+	instance = this;
+}
+
+//Destructor
+AsyncTextureLoader::~AsyncTextureLoader()
+{
+	{
+		std::lock_guard<std::mutex> lock(requestMutex);
+		stopping = true;
+	}
+	requestSignal.notify_all();
+
+	for (std::thread& worker : workers)
+		worker.join();
+
+	//Whatever was still on its way
+	for (Request* request : requests)
+		delete request;
+
+	DecodedImage image;
+	while (decoded.Pop(image))
+	{
+		stbi_image_free(image.pixels);
+		delete image.levels;
+		delete image.request;
+	}
+
+	if (instance == this)
+		instance = nullptr;
+}
+
+
+AsyncTextureLoader& AsyncTextureLoader::Get()
+{
+	ASSERT(instance);
+	return *instance;
+}
+
+
+AsyncTextureLoader* AsyncTextureLoader::TryGet()
+{
+	return instance;
+}
+
+
+std::shared_ptr<Texture> AsyncTextureLoader::Load(const std::string& file_path, const TextureParams& params)
+{
+	std::shared_ptr<Texture> texture = std::make_shared<Texture>(1, 1, placeholderPixel, params);
+	texture->filePath = file_path;
+	texture->loaded = false;
+
+	Request* request = new Request{ file_path, params, texture, Clock::now() };
+	{
+		std::lock_guard<std::mutex> lock(requestMutex);
+		requests.push_back(request);
+	}
+	requestSignal.notify_one();
+
+	return texture;
+}
+
+
+void AsyncTextureLoader::Update(unsigned int max_uploads)
+{
+	DecodedImage image;
+	for (unsigned int i = 0; i < max_uploads && decoded.Pop(image); i++)
+	{
+		decodedCount--;
+		std::shared_ptr<Texture> texture = image.request->texture.lock();
+
+		if (!image.pixels && !image.levels)
+		{
+			std::cout << "ERROR::AsyncTextureLoader.cpp::Update():: Failed to decode '" << image.request->filePath << "'" << std::endl;
+			stats.failed++;
+		}
+		else if (texture)
+		{
+			if (image.levels)
+				texture->SetImage(*image.levels);
+			else
+				texture->SetData(image.width, image.height, image.pixels);
+
+			Clock::time_point now = Clock::now();
+			stats.uploaded++;
+			decodeLatencyTotal += std::chrono::duration<float, std::milli>(image.decoded - image.request->start).count();
+			uploadLatencyTotal += std::chrono::duration<float, std::milli>(now - image.request->start).count();
+		}
+
+		if (image.pixels)
+			stbi_image_free(image.pixels);
+		delete image.levels;
+		delete image.request;
+	}
+}
+
+
+void AsyncTextureLoader::ResetStats()
+{
+	stats = Stats();
+	decodeLatencyTotal = uploadLatencyTotal = 0.0f;
+}
+
+
+const AsyncTextureLoader::Stats& AsyncTextureLoader::GetStats()
+{
+	{
+		std::lock_guard<std::mutex> lock(requestMutex);
+		stats.queued = (unsigned int)requests.size();
+	}
+	stats.decoded = decodedCount.load();
+
+	stats.decodeLatency = stats.uploaded ? decodeLatencyTotal / stats.uploaded : 0.0f;
+	stats.uploadLatency = stats.uploaded ? uploadLatencyTotal / stats.uploaded : 0.0f;
+	return stats;
+}
+
+
+void AsyncTextureLoader::WorkerLoop()
+{
+	stbi_set_flip_vertically_on_load_thread(1);
+
+	while (true)
+	{
+		Request* request;
+		{
+			std::unique_lock<std::mutex> lock(requestMutex);
+			requestSignal.wait(lock, [this]() { return stopping || !requests.empty(); });
+			if (stopping)
+				return;
+
+			request = requests.front();
+			requests.pop_front();
+		}
+
+		//Nobody wants the texture anymore, not worth decoding
+		if (request->texture.expired())
+		{
+			delete request;
+			continue;
+		}
+
+		DecodedImage image = { request, nullptr, nullptr, 0, 0, Clock::now() };
+		if (TextureCompressor::IsContainerFile(request->filePath))
+		{
+			image.levels = new TextureImage();
+			if (!TextureCompressor::Load(request->filePath, *image.levels))
+			{
+				delete image.levels;
+				image.levels = nullptr;
+			}
+		}
+		else
+		{
+			int bpp = 0;
+			image.pixels = stbi_load(request->filePath.c_str(), &image.width, &image.height, &bpp, 4);
+
+			//Filtering the chain is the slow part of a CPU mipmapped load, it stays off the GL thread too
+			if (image.pixels && request->params.mipmaps == MipmapSource::CPU)
+			{
+				image.levels = new TextureImage();
+				image.levels->width = image.width;
+				image.levels->height = image.height;
+				image.levels->levels.emplace_back(image.pixels, image.pixels + image.width * image.height * 4);
+				MipGenerator::Generate(*image.levels, request->params.mipFilter, request->params.srgb);
+
+				stbi_image_free(image.pixels);
+				image.pixels = nullptr;
+			}
+		}
+		image.decoded = Clock::now();
+
+		//The GL thread is behind, waiting for room is all a worker can do
+		decodedCount++;
+		while (!decoded.Push(image))
+		{
+			if (stopping)
+			{
+				if (image.pixels)
+					stbi_image_free(image.pixels);
+				delete image.levels;
+				delete request;
+				return;
+			}
+			std::this_thread::yield();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Texture.h"
+#include "LockFreeQueue.h"
+
+
+/*
+Decodes image files (or reads compressed containers) on a pool of worker threads & uploads them on the GL thread.
+Load() hands out a texture at once, it holds a 1x1 placeholder (safe to bind & draw) until Update() uploads the real image.
+Decoded images reach the GL thread through a lock-free queue, so workers never wait on the render loop.
+The application creates one of these after the context, Get() hands it out to the rest of the code.
+*/
+class AsyncTextureLoader
+{
+public:
+	//queued & decoded are live, the rest counts since the last ResetStats()
+	struct Stats
+	{
+		unsigned int queued = 0;			//Waiting for a worker
+		unsigned int decoded = 0;			//Decoded, waiting for the GL thread
+		unsigned int uploaded = 0;
+		unsigned int failed = 0;
+		float decodeLatency = 0.0f;		//ms from Load() until the pixels were decoded, averaged
+		float uploadLatency = 0.0f;		//ms from Load() until the texture was uploaded, averaged
+	};
+
+private:
+	typedef std::chrono::high_resolution_clock Clock;
+
+	struct Request
+	{
+		std::string filePath;
+		TextureParams params;
+		std::weak_ptr<Texture> texture;		//Textures dropped before their upload are skipped
+		Clock::time_point start;
+	};
+
+	struct DecodedImage
+	{
+		Request* request;
+		unsigned char* pixels;
+		TextureImage* levels;		//Instead of pixels for .dds & .ktx files & for CPU mipmaps (built on the worker)
+		int width, height;
+		Clock::time_point decoded;
+	};
+
+	static AsyncTextureLoader* instance;
+	static const unsigned int decodedCapacity = 256;
+
+	std::vector<std::thread> workers;
+	std::deque<Request*> requests;
+	std::mutex requestMutex;
+	std::condition_variable requestSignal;
+	std::atomic<bool> stopping;
+
+	LockFreeQueue<DecodedImage> decoded;
+	std::atomic<unsigned int> decodedCount;
+
+	Stats stats;
+	float decodeLatencyTotal, uploadLatencyTotal;
+
+public:
+	//Constructor & Destructor
+	AsyncTextureLoader(unsigned int worker_count = 0);		//0 = one less than the hardware threads
+	~AsyncTextureLoader();
+
+	static AsyncTextureLoader& Get();
+	static AsyncTextureLoader* TryGet();		//nullptr if there is no loader (yet)
+
+	std::shared_ptr<Texture> Load(const std::string& file_path, const TextureParams& params = TextureParams());
+
+	//Uploads decoded images, at most max_uploads per call so a burst doesn't stall one frame
+	void Update(unsigned int max_uploads = 8);
+
+	inline unsigned int GetQueueDepth() const { return stats.queued + stats.decoded; };
+	inline unsigned int GetWorkerCount() const { return (unsigned int)workers.size(); };
+	void ResetStats();
+	const Stats& GetStats();
+
+private:
+	void WorkerLoop();
+};
\ No newline at end of file
@@ -0,0 +1,192 @@
+#include "BatchRenderer.h"
+
+
+//Constructor
+BatchRenderer::BatchRenderer()
+	: batchMemory({ nullptr, 0, 0 }), quadCount(0), textureSlots(), textureSlotCount(1), textureSlotLimit(maxTextureSlots),
+	textureArray(nullptr)
+{
+	//Setting up the vertex stream, every region fits a few full batches
+	va = std::make_unique<VertexArray>();
+	vertexStream = std::make_unique<StreamingBuffer>(GL_ARRAY_BUFFER, 4 * maxVertices * (unsigned int)sizeof(BatchVertex));
+	va->AddBuffer<BatchVertex>(*vertexStream);
+
+	//Indices never change, since every quad is 2 triangles over its own 4 vertices
+	std::vector<unsigned int> indices(maxIndices);
+	for (unsigned int quad = 0, offset = 0; quad < maxQuads; quad++, offset += 4)
+	{
+		indices[quad * 6 + 0] = offset + 0;
+		indices[quad * 6 + 1] = offset + 1;
+		indices[quad * 6 + 2] = offset + 2;
+		indices[quad * 6 + 3] = offset + 2;
+		indices[quad * 6 + 4] = offset + 3;
+		indices[quad * 6 + 5] = offset + 0;
+	}
+	ib = std::make_unique<IndexBuffer>(indices.data(), maxIndices);
+
+	//Untextured quads sample a white texture so that they don't need their own shader
+	const unsigned char white[] = { 255, 255, 255, 255 };
+	whiteTexture = std::make_unique<Texture>(1, 1, white);
+	textureSlots[0] = whiteTexture.get();
+
+	//Not every GPU has 16 texture units in the fragment shader
+	int maxUnits = 0;
+	glErrorCall( glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxUnits) );
+	if ((unsigned int)maxUnits < maxTextureSlots)
+		textureSlotLimit = maxUnits;
+
+	int samplers[maxTextureSlots];
+	for (unsigned int i = 0; i < maxTextureSlots; i++)
+		samplers[i] = i;
+
+	shader = std::make_unique<Shader>("res/shaders/Batch.shader");
+	shader->Bind();
+	shader->SetUniform1iv("u_Textures", maxTextureSlots, samplers);
+
+	arrayShader = std::make_unique<Shader>("res/shaders/Batch.shader", ShaderDefines{ "TEXTURE_ARRAY" });
+	arrayShader->Bind();
+	arrayShader->SetUniform1i("u_TextureArray", 0);
+}
+
+//Destructor
+BatchRenderer::~BatchRenderer()
+{
+}
+
+
+void BatchRenderer::BeginBatch(const glm::mat4& view_proj)
+{
+	shader->Bind();
+	shader->SetUniformMat4f(UNIFORM_ID("u_ViewProj"), view_proj);
+	arrayShader->Bind();
+	arrayShader->SetUniformMat4f(UNIFORM_ID("u_ViewProj"), view_proj);
+
+	StartBatch();
+}
+
+
+//Adding a quad to the batch, the unit quad (-0.5 to 0.5) is moved into place by transform
+void BatchRenderer::SubmitQuad(const glm::mat4& transform, const glm::vec4& uv, const glm::vec4& color, const Texture* texture)
+{
+	//Flushing when the buffer is full or the batch is drawing from an array
+	if (quadCount == maxQuads || textureArray)
+	{
+		Flush();
+		StartBatch();
+	}
+
+	//Looking up the texture slot can flush too, so it has to happen before writing the vertices
+	WriteQuad(transform, uv, color, GetTextureSlot(texture));
+}
+
+
+void BatchRenderer::SubmitQuad(const glm::mat4& transform, const glm::vec4& uv, const glm::vec4& color, const TextureArray& texture_array, int layer)
+{
+	//A batch is either 2D textures in slots or a single array
+	if (quadCount == maxQuads || (quadCount > 0 && textureArray != &texture_array))
+	{
+		Flush();
+		StartBatch();
+	}
+
+	textureArray = &texture_array;
+	WriteQuad(transform, uv, color, (float)layer);
+}
+
+
+void BatchRenderer::WriteQuad(const glm::mat4& transform, const glm::vec4& uv, const glm::vec4& color, float tex_index)
+{
+	const glm::vec4 corners[4] = {
+		{ -0.5f, -0.5f, 0.0f, 1.0f },	//Lower left
+		{  0.5f, -0.5f, 0.0f, 1.0f },	//Lower right
+		{  0.5f,  0.5f, 0.0f, 1.0f },	//Upper right
+		{ -0.5f,  0.5f, 0.0f, 1.0f }	//Upper left
+	};
+	const glm::vec2 texCoords[4] = {
+		{ uv.x, uv.y }, { uv.z, uv.y }, { uv.z, uv.w }, { uv.x, uv.w }
+	};
+
+	BatchVertex* vertex = (BatchVertex*)batchMemory.data + quadCount * 4;
+	for (int i = 0; i < 4; i++)
+	{
+		vertex[i].position = glm::vec3(transform * corners[i]);
+		vertex[i].color = color;
+		vertex[i].texCoord = texCoords[i];
+		vertex[i].texIndex = tex_index;
+	}
+
+	quadCount++;
+	stats.quadCount++;
+}
+
+
+void BatchRenderer::EndBatch()
+{
+	Flush();
+	vertexStream->EndFrame();
+}
+
+
+void BatchRenderer::ResetStats()
+{
+	stats = Stats();
+	vertexStream->ResetStats();
+}
+
+
+//Reserving stream memory for a full batch, Flush() keeps only the quads that were written & hands the rest back
+void BatchRenderer::StartBatch()
+{
+	batchMemory = vertexStream->Allocate(maxVertices * sizeof(BatchVertex), sizeof(BatchVertex));
+	quadCount = 0;
+	textureSlotCount = 1;
+	textureArray = nullptr;
+}
+
+
+//Handing the written vertices to GL & drawing everything in the batch with one call
+void BatchRenderer::Flush()
+{
+	vertexStream->Commit(batchMemory, quadCount * 4 * (unsigned int)sizeof(BatchVertex));
+
+	if (quadCount == 0)
+		return;
+
+	if (textureArray)
+	{
+		textureArray->Bind(0);
+	}
+	else
+	{
+		for (unsigned int i = 0; i < textureSlotCount; i++)
+			textureSlots[i]->Bind(i);
+	}
+
+	//The batch starts wherever the stream placed it
+	Renderer renderer;
+	renderer.Draw(*va, *ib, textureArray ? *arrayShader : *shader, quadCount * 6, batchMemory.offset / sizeof(BatchVertex));
+	stats.flushCount++;
+}
+
+
+//Finding the slot of the texture in the current batch, flushing if the slot table is full
+float BatchRenderer::GetTextureSlot(const Texture* texture)
+{
+	if (!texture)
+		return 0.0f;
+
+	for (unsigned int i = 1; i < textureSlotCount; i++)
+	{
+		if (textureSlots[i] == texture)
+			return (float)i;
+	}
+
+	if (textureSlotCount == textureSlotLimit)
+	{
+		Flush();
+		StartBatch();
+	}
+
+	textureSlots[textureSlotCount] = texture;
+	return (float)textureSlotCount++;
+}
\ No newline at end of file
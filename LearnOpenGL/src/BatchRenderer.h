@@ -0,0 +1,85 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <memory>
+#include <vector>
+
+#include "Renderer.h"
+#include "StreamingBuffer.h"
+#include "StaticVertexLayout.h"
+#include "Texture.h"
+#include "TextureArray.h"
+
+
+//Vertex written by the batch renderer for every corner of a quad
+struct BatchVertex
+{
+	glm::vec3 position;
+	glm::vec4 color;
+	glm::vec2 texCoord;
+	float texIndex;		//Slot of the texture, or the layer when the batch draws from a texture array
+};
+
+VERTEX_LAYOUT(BatchVertex,
+	VERTEX_ATTRIBUTE(BatchVertex, position),
+	VERTEX_ATTRIBUTE(BatchVertex, color),
+	VERTEX_ATTRIBUTE(BatchVertex, texCoord),
+	VERTEX_ATTRIBUTE(BatchVertex, texIndex));
+
+
+class BatchRenderer
+{
+public:
+	//Counters, reset by the user with ResetStats() (usually once per frame)
+	struct Stats
+	{
+		unsigned int quadCount = 0;
+		unsigned int flushCount = 0;	//Every flush is exactly one draw call
+	};
+
+	static const unsigned int maxQuads = 10000;
+	static const unsigned int maxVertices = maxQuads * 4;
+	static const unsigned int maxIndices = maxQuads * 6;
+	static const unsigned int maxTextureSlots = 16;		//Has to match the size of u_Textures in Batch.shader
+
+private:
+	std::unique_ptr<VertexArray> va;
+	std::unique_ptr<StreamingBuffer> vertexStream;
+	std::unique_ptr<IndexBuffer> ib;
+	std::unique_ptr<Shader> shader;
+	std::unique_ptr<Shader> arrayShader;		//Batch.shader with TEXTURE_ARRAY
+	std::unique_ptr<Texture> whiteTexture;	//Slot 0, used by untextured quads
+
+	//Vertices are written straight into the mapped stream
+	StreamingBuffer::Allocation batchMemory;
+	unsigned int quadCount;
+
+	const Texture* textureSlots[maxTextureSlots];
+	unsigned int textureSlotCount;
+	unsigned int textureSlotLimit;		//maxTextureSlots clamped to what the GPU supports
+	const TextureArray* textureArray;		//Bound for the whole batch instead of the slots, null for a batch of 2D textures
+
+	Stats stats;
+
+public:
+	//Constructor & Destructor
+	BatchRenderer();
+	~BatchRenderer();
+
+	void BeginBatch(const glm::mat4& view_proj);
+	void SubmitQuad(const glm::mat4& transform, const glm::vec4& uv, const glm::vec4& color, const Texture* texture);
+	//Quads of one array never flush each other, whatever their layers
+	void SubmitQuad(const glm::mat4& transform, const glm::vec4& uv, const glm::vec4& color, const TextureArray& texture_array, int layer);
+	void EndBatch();
+
+	void ResetStats();
+	inline const Stats& GetStats() const { return stats; };
+	inline const StreamingBuffer& GetVertexStream() const { return *vertexStream; };
+
+private:
+	void StartBatch();
+	void Flush();
+	float GetTextureSlot(const Texture* texture);
+	void WriteQuad(const glm::mat4& transform, const glm::vec4& uv, const glm::vec4& color, float tex_index);
+};
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "FileWatcher.h"
+
+#include <algorithm>
+#include <iostream>
+
+#ifdef __linux__
+	#include <sys/inotify.h>
+	#include <unistd.h>
+	#include <cerrno>
+#elif defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <sys/types.h>
+	#include <sys/stat.h>
+#endif
+
+
+#ifdef __linux__
+
+//  inotify //
+//Constructor
+FileWatcher::FileWatcher()
+	: inotifyFD(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+{
+	if (inotifyFD < 0)
+		std::cout << "WARNING::FileWatcher.cpp::FileWatcher():: inotify isn't available, no file will be watched" << std::endl;
+}
+
+//Destructor
+FileWatcher::~FileWatcher()
+{
+	if (inotifyFD >= 0)
+		close(inotifyFD);
+}
+
+
+void FileWatcher::Watch(const std::string& file_path)
+{
+	if (!files.insert(file_path).second || inotifyFD < 0)
+		return;
+
+	//inotify watches directories, one watch covers every file in there
+	std::string directory = GetDirectory(file_path);
+	for (const auto& watched : directories)
+	{
+		if (watched.second == directory)
+			return;
+	}
+
+	int wd = inotify_add_watch(inotifyFD, directory.empty() ? "." : directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+	if (wd < 0)
+	{
+		std::cout << "WARNING::FileWatcher.cpp::Watch():: Can't watch '" << directory << "'" << std::endl;
+		return;
+	}
+
+	directories[wd] = directory;
+}
+
+
+std::vector<std::string> FileWatcher::Poll()
+{
+	std::vector<std::string> changed;
+	if (inotifyFD < 0)
+		return changed;
+
+	//Events are variable sized, the buffer has to be aligned for the header
+	alignas(inotify_event) char buffer[4096];
+	while (true)
+	{
+		ssize_t length = read(inotifyFD, buffer, sizeof(buffer));
+		if (length <= 0)
+			break;		//EAGAIN, nothing left to read
+
+		for (char* ptr = buffer; ptr < buffer + length;)
+		{
+			const inotify_event* event = (const inotify_event*)ptr;
+			ptr += sizeof(inotify_event) + event->len;
+
+			auto directory = directories.find(event->wd);
+			if (event->len == 0 || directory == directories.end())
+				continue;
+
+			std::string filePath = directory->second + event->name;
+			if (files.count(filePath) && std::find(changed.begin(), changed.end(), filePath) == changed.end())
+				changed.push_back(filePath);
+		}
+	}
+
+	return changed;
+}
+
+#else
+
+//  Polling //
+static const float pollInterval = 0.25f;	//Seconds between two checks of the modification times
+
+
+//Constructor
+FileWatcher::FileWatcher()
+	: lastCheck(std::chrono::steady_clock::now())
+{
+}
+
+//Destructor
+FileWatcher::~FileWatcher()
+{
+}
+
+
+void FileWatcher::Watch(const std::string& file_path)
+{
+	if (files.insert(file_path).second)
+		fileStates[file_path] = GetFileState(file_path);
+}
+
+
+std::vector<std::string> FileWatcher::Poll()
+{
+	std::vector<std::string> changed;
+
+	auto now = std::chrono::steady_clock::now();
+	if (std::chrono::duration<float>(now - lastCheck).count() < pollInterval)
+		return changed;
+	lastCheck = now;
+
+	for (auto& file : fileStates)
+	{
+		FileState state = GetFileState(file.first);
+		if (state != file.second)
+		{
+			file.second = state;
+			changed.push_back(file.first);
+		}
+	}
+
+	return changed;
+}
+
+
+//-1 for files that can't be read, so that a file appearing again counts as a change.
+//Whole seconds (st_mtime) would miss a second save within the same second, the size catches rewrites the clock doesn't tell apart
+FileWatcher::FileState FileWatcher::GetFileState(const std::string& file_path)
+{
+#ifdef _WIN32
+	WIN32_FILE_ATTRIBUTE_DATA info;
+	if (!GetFileAttributesExA(file_path.c_str(), GetFileExInfoStandard, &info))
+		return { -1, -1 };
+
+	long long modified = ((long long)info.ftLastWriteTime.dwHighDateTime << 32) | info.ftLastWriteTime.dwLowDateTime;
+	long long size = ((long long)info.nFileSizeHigh << 32) | info.nFileSizeLow;
+	return { modified, size };
+#else
+	struct stat info;
+	if (stat(file_path.c_str(), &info) != 0)
+		return { -1, -1 };
+
+	#ifdef __APPLE__
+		const timespec& time = info.st_mtimespec;
+	#else
+		const timespec& time = info.st_mtim;
+	#endif
+	return { (long long)time.tv_sec * 1000000000LL + time.tv_nsec, (long long)info.st_size };
+#endif
+}
+
+#endif
+
+
+std::string FileWatcher::GetDirectory(const std::string& file_path)
+{
+	size_t slash = file_path.find_last_of("/\\");
+	return slash != std::string::npos ? file_path.substr(0, slash + 1) : "";
+}
\ No newline at end of file
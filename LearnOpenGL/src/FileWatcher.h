@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+/*
+Reports which of the watched files changed since the last Poll(), without ever blocking.
+On Linux it listens to inotify events on the files' directories (which also catches editors that save by renaming),
+everywhere else it compares modification times (sub-second) & sizes a few times a second.
+*/
+class FileWatcher
+{
+private:
+	std::unordered_set<std::string> files;
+
+#ifdef __linux__
+	int inotifyFD;
+	std::unordered_map<int, std::string> directories;		//Watch descriptor -> directory (with a trailing slash)
+#else
+	//Modification time in the platform's finest unit (100 ns on Windows, ns elsewhere) & size, -1 while the file can't be read
+	struct FileState
+	{
+		long long modified;
+		long long size;
+
+		inline bool operator==(const FileState& other) const { return modified == other.modified && size == other.size; };
+		inline bool operator!=(const FileState& other) const { return !(*this == other); };
+	};
+
+	std::unordered_map<std::string, FileState> fileStates;
+	std::chrono::steady_clock::time_point lastCheck;
+#endif
+
+public:
+	//Constructor & Destructor
+	FileWatcher();
+	~FileWatcher();
+
+	FileWatcher(const FileWatcher&) = delete;
+	FileWatcher& operator=(const FileWatcher&) = delete;
+
+	void Watch(const std::string& file_path);
+
+	//Every changed file once, no matter how many times it was written
+	std::vector<std::string> Poll();
+
+	inline unsigned int GetFileCount() const { return (unsigned int)files.size(); };
+
+private:
+	static std::string GetDirectory(const std::string& file_path);
+#ifndef __linux__
+	static FileState GetFileState(const std::string& file_path);
+#endif
+};
\ No newline at end of file
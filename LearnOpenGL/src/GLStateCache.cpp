@@ -0,0 +1,320 @@
+#include "GLStateCache.h"
+#include "Renderer.h"
+
+
+GLStateCache& GLStateCache::Get()
+{
+	static GLStateCache cache;
+	return cache;
+}
+
+
+//Constructor
+GLStateCache::GLStateCache()
+{
+	Invalidate();
+}
+
+
+void GLStateCache::UseProgram(unsigned int id)
+{
+	if (program == id)
+	{
+		stats.hits++;
+		return;
+	}
+
+	glErrorCall( glUseProgram(id) );
+	program = id;
+	stats.misses++;
+}
+
+
+void GLStateCache::BindVertexArray(unsigned int id)
+{
+	if (vertexArray == id)
+	{
+		stats.hits++;
+		return;
+	}
+
+	glErrorCall( glBindVertexArray(id) );
+	vertexArray = id;
+	buffers[GetBufferTargetIndex(GL_ELEMENT_ARRAY_BUFFER)] = unknown;	//The element array binding belongs to the vertex array
+	stats.misses++;
+	stats.vertexArraySwitches++;
+}
+
+
+void GLStateCache::BindBuffer(unsigned int target, unsigned int id)
+{
+	int index = GetBufferTargetIndex(target);
+	if (index >= 0 && buffers[index] == id)
+	{
+		stats.hits++;
+		return;
+	}
+
+	glErrorCall( glBindBuffer(target, id) );
+	if (index >= 0)
+		buffers[index] = id;
+	stats.misses++;
+}
+
+
+//Indexed bindings aren't cached, but they change the generic binding of the target as well
+void GLStateCache::BindBufferBase(unsigned int target, unsigned int index, unsigned int id)
+{
+	glErrorCall( glBindBufferBase(target, index, id) );
+
+	int slot = GetBufferTargetIndex(target);
+	if (slot >= 0)
+		buffers[slot] = id;
+	stats.misses++;
+}
+
+
+void GLStateCache::BindBufferRange(unsigned int target, unsigned int index, unsigned int id, unsigned int offset, unsigned int size)
+{
+	glErrorCall( glBindBufferRange(target, index, id, offset, size) );
+
+	int slot = GetBufferTargetIndex(target);
+	if (slot >= 0)
+		buffers[slot] = id;
+	stats.misses++;
+}
+
+
+void GLStateCache::ActiveTexture(unsigned int unit)
+{
+	if (activeTexture == unit)
+	{
+		stats.hits++;
+		return;
+	}
+
+	glErrorCall( glActiveTexture(GL_TEXTURE0 + unit) );
+	activeTexture = unit;
+	stats.misses++;
+}
+
+
+//Binding to the active texture unit
+void GLStateCache::BindTexture(unsigned int target, unsigned int id)
+{
+	int index = GetTextureTargetIndex(target);
+	bool cached = index >= 0 && activeTexture < maxTextureUnits;
+	if (cached && textures[activeTexture][index] == id)
+	{
+		stats.hits++;
+		return;
+	}
+
+	glErrorCall( glBindTexture(target, id) );
+	if (cached)
+		textures[activeTexture][index] = id;
+	stats.misses++;
+}
+
+
+void GLStateCache::BindSampler(unsigned int unit, unsigned int id)
+{
+	bool cached = unit < maxTextureUnits;
+	if (cached && samplers[unit] == id)
+	{
+		stats.hits++;
+		return;
+	}
+
+	glErrorCall( glBindSampler(unit, id) );
+	if (cached)
+		samplers[unit] = id;
+	stats.misses++;
+}
+
+
+void GLStateCache::Enable(unsigned int capability)
+{
+	SetCapability(capability, true);
+}
+
+
+void GLStateCache::Disable(unsigned int capability)
+{
+	SetCapability(capability, false);
+}
+
+
+void GLStateCache::BlendFunc(unsigned int src, unsigned int dst)
+{
+	if (blendSrc == src && blendDst == dst)
+	{
+		stats.hits++;
+		return;
+	}
+
+	glErrorCall( glBlendFunc(src, dst) );
+	blendSrc = src;
+	blendDst = dst;
+	stats.misses++;
+}
+
+
+void GLStateCache::PrimitiveRestartIndex(unsigned int index)
+{
+	if (restartIndexKnown && restartIndex == index)
+	{
+		stats.hits++;
+		return;
+	}
+
+	glErrorCall( glPrimitiveRestartIndex(index) );
+	restartIndex = index;
+	restartIndexKnown = true;
+	stats.misses++;
+}
+
+
+void GLStateCache::OnDeleteProgram(unsigned int id)
+{
+	if (program == id)
+		program = unknown;
+}
+
+
+void GLStateCache::OnDeleteVertexArray(unsigned int id)
+{
+	if (vertexArray == id)
+		vertexArray = unknown;
+}
+
+
+void GLStateCache::OnDeleteBuffer(unsigned int id)
+{
+	for (unsigned int& buffer : buffers)
+	{
+		if (buffer == id)
+			buffer = unknown;
+	}
+}
+
+
+void GLStateCache::OnDeleteTexture(unsigned int id)
+{
+	for (auto& unit : textures)
+	{
+		for (unsigned int& texture : unit)
+		{
+			if (texture == id)
+				texture = unknown;
+		}
+	}
+}
+
+
+void GLStateCache::OnDeleteSampler(unsigned int id)
+{
+	for (unsigned int& sampler : samplers)
+	{
+		if (sampler == id)
+			sampler = unknown;
+	}
+}
+
+
+void GLStateCache::Invalidate()
+{
+	program = unknown;
+	vertexArray = unknown;
+	activeTexture = unknown;
+	blendSrc = blendDst = unknown;
+	restartIndexKnown = false;
+
+	for (unsigned int& buffer : buffers)
+		buffer = unknown;
+	for (auto& unit : textures)
+	{
+		for (unsigned int& texture : unit)
+			texture = unknown;
+	}
+	for (unsigned int& sampler : samplers)
+		sampler = unknown;
+	for (unsigned int& capability : capabilities)
+		capability = unknown;
+}
+
+
+void GLStateCache::ResetStats()
+{
+	stats = Stats();
+}
+
+
+void GLStateCache::SetCapability(unsigned int capability, bool enabled)
+{
+	int index = GetCapabilityIndex(capability);
+	if (index >= 0 && capabilities[index] == (unsigned int)enabled)
+	{
+		stats.hits++;
+		return;
+	}
+
+	if (enabled)
+	{
+		glErrorCall( glEnable(capability) );
+	}
+	else
+	{
+		glErrorCall( glDisable(capability) );
+	}
+
+	if (index >= 0)
+		capabilities[index] = enabled;
+	stats.misses++;
+}
+
+
+//Slots of the tracked targets, -1 for targets that are passed through uncached
+int GLStateCache::GetBufferTargetIndex(unsigned int target)
+{
+	switch (target)
+	{
+		case GL_ARRAY_BUFFER:			return 0;
+		case GL_ELEMENT_ARRAY_BUFFER:	return 1;
+		case GL_UNIFORM_BUFFER:			return 2;
+		case GL_PIXEL_UNPACK_BUFFER:	return 3;
+		case GL_COPY_READ_BUFFER:		return 4;
+		case GL_COPY_WRITE_BUFFER:		return 5;
+	}
+
+	return -1;
+}
+
+
+int GLStateCache::GetTextureTargetIndex(unsigned int target)
+{
+	switch (target)
+	{
+		case GL_TEXTURE_2D:			return 0;
+		case GL_TEXTURE_2D_ARRAY:	return 1;
+		case GL_TEXTURE_CUBE_MAP:	return 2;
+	}
+
+	return -1;
+}
+
+
+int GLStateCache::GetCapabilityIndex(unsigned int capability)
+{
+	switch (capability)
+	{
+		case GL_BLEND:			return 0;
+		case GL_DEPTH_TEST:		return 1;
+		case GL_CULL_FACE:		return 2;
+		case GL_SCISSOR_TEST:	return 3;
+		case GL_PRIMITIVE_RESTART:	return 4;
+		case GL_PRIMITIVE_RESTART_FIXED_INDEX:	return 5;
+	}
+
+	return -1;
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <GL/glew.h>
+
+
+/*
+Shadow copy of the GL binding state, so that binding what is already bound never reaches the driver.
+Every bind in the project has to go through here, otherwise the copy goes stale.
+Code that changes GL state behind our back (e.g. the ImGui backend) has to be followed by Invalidate().
+*/
+class GLStateCache
+{
+public:
+	//Counters, reset by the user with ResetStats() (usually once per frame)
+	struct Stats
+	{
+		unsigned int hits = 0;		//Calls skipped because the state was already set
+		unsigned int misses = 0;	//Calls that went to GL
+		unsigned int vertexArraySwitches = 0;	//Misses of BindVertexArray(), also counted in misses
+	};
+
+private:
+	static const unsigned int maxTextureUnits = 32;
+	static const unsigned int textureTargetCount = 3;	//2D, 2D array & cube map
+	static const unsigned int capabilityCount = 6;		//Blend, depth test, cull face, scissor test & both primitive restarts
+	static const unsigned int bufferTargetCount = 6;	//Array, element array, uniform, pixel unpack, copy read & copy write
+	static const unsigned int unknown = 0xFFFFFFFF;		//Forces the next call through
+
+	unsigned int program;
+	unsigned int vertexArray;
+	unsigned int buffers[bufferTargetCount];
+	unsigned int activeTexture;
+	unsigned int textures[maxTextureUnits][textureTargetCount];
+	unsigned int samplers[maxTextureUnits];
+	unsigned int capabilities[capabilityCount];		//0 = disabled, 1 = enabled, or unknown
+	unsigned int blendSrc, blendDst;
+	unsigned int restartIndex;
+	bool restartIndexKnown;			//0xFFFFFFFF is a real restart index, so it can't double as unknown
+
+	Stats stats;
+
+public:
+	//The application only creates one GL context, so there is one cache
+	static GLStateCache& Get();
+
+	void UseProgram(unsigned int id);
+	void BindVertexArray(unsigned int id);
+	void BindBuffer(unsigned int target, unsigned int id);
+	void BindBufferBase(unsigned int target, unsigned int index, unsigned int id);		//Indexed bindings also move the generic one
+	void BindBufferRange(unsigned int target, unsigned int index, unsigned int id, unsigned int offset, unsigned int size);
+	void ActiveTexture(unsigned int unit);		//unit = 0, 1, ... (not GL_TEXTURE0 + unit)
+	void BindTexture(unsigned int target, unsigned int id);
+	void BindSampler(unsigned int unit, unsigned int id);		//Sampler objects are bound per unit, not to the active one
+	void Enable(unsigned int capability);
+	void Disable(unsigned int capability);
+	void BlendFunc(unsigned int src, unsigned int dst);
+	void PrimitiveRestartIndex(unsigned int index);		//Only used with GL_PRIMITIVE_RESTART, the fixed index variant needs none
+
+	//Deleting a bound object unbinds it in GL, and its name can be handed out again
+	void OnDeleteProgram(unsigned int id);
+	void OnDeleteVertexArray(unsigned int id);
+	void OnDeleteBuffer(unsigned int id);
+	void OnDeleteTexture(unsigned int id);
+	void OnDeleteSampler(unsigned int id);
+
+	//Forgets everything, the next call of each kind goes to GL
+	void Invalidate();
+
+	void ResetStats();
+	inline const Stats& GetStats() const { return stats; };
+
+private:
+	GLStateCache();
+
+	void SetCapability(unsigned int capability, bool enabled);
+	static int GetBufferTargetIndex(unsigned int target);
+	static int GetTextureTargetIndex(unsigned int target);
+	static int GetCapabilityIndex(unsigned int capability);
+};
\ No newline at end of file
@@ -0,0 +1,201 @@
+#include "GpuHeap.h"
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "VertexArrayCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+
+//Constructor
+GpuHeap::GpuHeap(unsigned int index_capacity)
+	: indexBuffer(CreateBuffer(index_capacity * sizeof(unsigned int))), indexAllocator(index_capacity)
+{
+}
+
+//Destructor
+GpuHeap::~GpuHeap()
+{
+	for (auto& pool : pools)
+	{
+		pool->va.reset();
+		DeleteBuffer(pool->buffer);
+	}
+	DeleteBuffer(indexBuffer);
+}
+
+
+unsigned int GpuHeap::AddFormat(const VertexBufferLayout& layout, unsigned int vertex_capacity)
+{
+	pools.push_back(std::make_unique<VertexPool>(layout, vertex_capacity));
+	VertexPool& pool = *pools.back();
+	pool.buffer = CreateBuffer(vertex_capacity * layout.GetStride());
+	SetupVertexArray(pool);
+
+	return (unsigned int)pools.size() - 1;
+}
+
+
+GpuHeap::MeshID GpuHeap::Allocate(unsigned int format, const void* vertices, unsigned int vertex_count,
+	const unsigned int* indices, unsigned int index_count)
+{
+	if (format >= pools.size())
+		return invalidMesh;
+
+	VertexPool& pool = *pools[format];
+	Mesh mesh;
+	mesh.format = format;
+	mesh.live = true;
+	mesh.vertices = pool.allocator.Allocate(vertex_count);
+	mesh.indices = indexAllocator.Allocate(index_count);
+	if (!mesh.vertices.IsValid() || !mesh.indices.IsValid())
+	{
+		std::cout << "ERROR::GpuHeap.cpp::Allocate():: No room for " << vertex_count << " vertices & " << index_count
+			<< " indices, the heap is full or too fragmented" << std::endl;
+		pool.allocator.Free(mesh.vertices);
+		indexAllocator.Free(mesh.indices);
+		return invalidMesh;
+	}
+
+	//Copy targets, so that filling the buffers doesn't disturb the array or element array bindings
+	unsigned int stride = pool.layout.GetStride();
+	GLStateCache::Get().BindBuffer(GL_COPY_WRITE_BUFFER, pool.buffer);
+	glErrorCall( glBufferSubData(GL_COPY_WRITE_BUFFER, mesh.vertices.offset * stride, vertex_count * stride, vertices) );
+	GLStateCache::Get().BindBuffer(GL_COPY_WRITE_BUFFER, indexBuffer);
+	glErrorCall( glBufferSubData(GL_COPY_WRITE_BUFFER, mesh.indices.offset * sizeof(unsigned int), index_count * sizeof(unsigned int), indices) );
+
+	MeshID id;
+	if (!freeMeshes.empty())
+	{
+		id = freeMeshes.back();
+		freeMeshes.pop_back();
+		meshes[id] = mesh;
+	}
+	else
+	{
+		id = (MeshID)meshes.size();
+		meshes.push_back(mesh);
+	}
+
+	return id;
+}
+
+
+void GpuHeap::Free(MeshID mesh)
+{
+	if (mesh >= meshes.size() || !meshes[mesh].live)
+		return;
+
+	pools[meshes[mesh].format]->allocator.Free(meshes[mesh].vertices);
+	indexAllocator.Free(meshes[mesh].indices);
+	meshes[mesh].live = false;
+	freeMeshes.push_back(mesh);
+}
+
+
+void GpuHeap::Compact()
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	//Live ranges of one allocator in the order they sit in the buffer, re-allocated from an empty allocator they pack from 0 up.
+	//The copies go into a new buffer, source & destination ranges of a copy within one buffer mustn't overlap
+	auto compactBuffer = [this](unsigned int& buffer, OffsetAllocator& allocator, unsigned int unit_size,
+		OffsetAllocator::Allocation Mesh::* range, int format)
+	{
+		std::vector<Mesh*> live;
+		for (Mesh& mesh : meshes)
+		{
+			if (mesh.live && (format < 0 || mesh.format == (unsigned int)format))
+				live.push_back(&mesh);
+		}
+		std::sort(live.begin(), live.end(), [range](const Mesh* a, const Mesh* b) { return (a->*range).offset < (b->*range).offset; });
+
+		std::vector<unsigned int> sizes;
+		for (const Mesh* mesh : live)
+			sizes.push_back(allocator.GetAllocationSize(mesh->*range));
+
+		unsigned int newBuffer = CreateBuffer(allocator.GetCapacity() * unit_size);
+		GLStateCache::Get().BindBuffer(GL_COPY_READ_BUFFER, buffer);
+		GLStateCache::Get().BindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+
+		allocator.Reset();
+		for (size_t i = 0; i < live.size(); i++)
+		{
+			OffsetAllocator::Allocation moved = allocator.Allocate(sizes[i]);
+			glErrorCall( glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, (live[i]->*range).offset * unit_size,
+				moved.offset * unit_size, sizes[i] * unit_size) );
+			live[i]->*range = moved;
+			stats.bytesMoved += sizes[i] * unit_size;
+		}
+
+		DeleteBuffer(buffer);
+		buffer = newBuffer;
+	};
+
+	compactBuffer(indexBuffer, indexAllocator, sizeof(unsigned int), &Mesh::indices, -1);
+	for (unsigned int format = 0; format < pools.size(); format++)
+	{
+		VertexPool& pool = *pools[format];
+		compactBuffer(pool.buffer, pool.allocator, pool.layout.GetStride(), &Mesh::vertices, (int)format);
+		SetupVertexArray(pool);		//Also picks up the new index buffer
+	}
+
+	stats.compactions++;
+	auto end = std::chrono::high_resolution_clock::now();
+	stats.compactTime = std::chrono::duration<float, std::milli>(end - start).count();
+}
+
+
+GpuHeap::DrawRange GpuHeap::GetDrawRange(MeshID mesh) const
+{
+	const Mesh& entry = meshes[mesh];
+	DrawRange range;
+	range.format = entry.format;
+	range.firstIndex = entry.indices.offset;
+	range.indexCount = indexAllocator.GetAllocationSize(entry.indices);
+	range.baseVertex = (int)entry.vertices.offset;
+	return range;
+}
+
+
+void GpuHeap::Bind(unsigned int format) const
+{
+	pools[format]->va->Bind();
+	GLStateCache::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);		//Already part of the vertex array, a cache hit after the first draw
+}
+
+
+unsigned int GpuHeap::GetStride(unsigned int format) const
+{
+	return pools[format]->layout.GetStride();
+}
+
+
+unsigned int GpuHeap::CreateBuffer(unsigned int size)
+{
+	unsigned int buffer;
+	glErrorCall( glGenBuffers(1, &buffer) );
+	GLStateCache::Get().BindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+	glErrorCall( glBufferData(GL_COPY_WRITE_BUFFER, size, nullptr, GL_STATIC_DRAW) );
+	return buffer;
+}
+
+
+void GpuHeap::DeleteBuffer(unsigned int buffer)
+{
+	if (VertexArrayCache* vertexArrays = VertexArrayCache::TryGet())
+		vertexArrays->OnDeleteBuffer(buffer);
+
+	GLStateCache::Get().OnDeleteBuffer(buffer);
+	glErrorCall( glDeleteBuffers(1, &buffer) );
+}
+
+
+//A vertex array can't be pointed at another buffer without respecifying every attribute, so a new one is made
+void GpuHeap::SetupVertexArray(VertexPool& pool)
+{
+	pool.va = std::make_unique<VertexArray>();
+	pool.va->AddBuffer(pool.buffer, pool.layout);
+	GLStateCache::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "OffsetAllocator.h"
+#include "VertexArray.h"
+#include "VertexBufferLayout.h"
+
+#include <memory>
+#include <vector>
+
+
+/*
+Vertex & index memory for many small meshes, carved out of a few large buffers:
+one index buffer for everything & one vertex buffer + vertex array per vertex format.
+Drawing a mesh is then a base vertex draw from its format's vertex array, so meshes of the same format
+never switch buffers or vertex arrays between draws (Renderer::Draw(heap, mesh, shader)).
+
+Indices are stored relative to the mesh's first vertex (0 = first vertex of the mesh), the base vertex adds the rest,
+which is also why Compact() can move meshes around without touching their indices.
+Capacities are fixed, Allocate() fails when a buffer is full (or too fragmented, Compact() may help).
+*/
+class GpuHeap
+{
+public:
+	typedef unsigned int MeshID;
+	static const MeshID invalidMesh = 0xFFFFFFFF;
+
+	//What a draw of a mesh needs
+	struct DrawRange
+	{
+		unsigned int format;
+		unsigned int firstIndex;
+		unsigned int indexCount;
+		int baseVertex;
+	};
+
+	//Counters that add up over the heap's lifetime
+	struct Stats
+	{
+		unsigned int compactions = 0;
+		unsigned int bytesMoved = 0;		//By all compactions
+		float compactTime = 0.0f;			//ms, CPU time of the last compaction
+	};
+
+private:
+	struct VertexPool
+	{
+		VertexBufferLayout layout;
+		std::unique_ptr<VertexArray> va;
+		unsigned int buffer;
+		OffsetAllocator allocator;		//In vertices
+
+		VertexPool(const VertexBufferLayout& layout, unsigned int capacity)
+			: layout(layout), buffer(0), allocator(capacity)
+		{
+
+		}
+	};
+
+	struct Mesh
+	{
+		unsigned int format;
+		OffsetAllocator::Allocation vertices, indices;
+		bool live;
+	};
+
+	std::vector<std::unique_ptr<VertexPool>> pools;
+	unsigned int indexBuffer;
+	OffsetAllocator indexAllocator;		//In indices (unsigned int)
+
+	std::vector<Mesh> meshes;
+	std::vector<MeshID> freeMeshes;
+
+	Stats stats;
+
+public:
+	//Constructor & Destructor
+	GpuHeap(unsigned int index_capacity);
+	~GpuHeap();
+
+	//Adds a vertex buffer of vertex_capacity vertices for a layout, returns the format to allocate meshes with
+	unsigned int AddFormat(const VertexBufferLayout& layout, unsigned int vertex_capacity);
+
+	//Copies the mesh into the heap, returns invalidMesh if it doesn't fit
+	MeshID Allocate(unsigned int format, const void* vertices, unsigned int vertex_count, const unsigned int* indices, unsigned int index_count);
+	void Free(MeshID mesh);
+
+	//Moves every mesh of every buffer down to the start of it, leaving the free space in one piece at the end.
+	//Copies on the GPU into fresh buffers, MeshIDs stay valid
+	void Compact();
+
+	DrawRange GetDrawRange(MeshID mesh) const;
+	void Bind(unsigned int format) const;		//The format's vertex array with the shared index buffer
+
+	inline unsigned int GetFormatCount() const { return (unsigned int)pools.size(); };
+	unsigned int GetStride(unsigned int format) const;		//Bytes per vertex
+	inline OffsetAllocator::Stats GetVertexStats(unsigned int format) const { return pools[format]->allocator.GetStats(); };
+	inline OffsetAllocator::Stats GetIndexStats() const { return indexAllocator.GetStats(); };
+	inline const Stats& GetStats() const { return stats; };
+
+private:
+	static unsigned int CreateBuffer(unsigned int size);
+	static void DeleteBuffer(unsigned int buffer);
+	void SetupVertexArray(VertexPool& pool);
+};
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "GpuTimer.h"
+#include "Renderer.h"
+
+
+//Constructor
+GpuTimer::GpuTimer()
+	: query(0), pending(false), stale(false), milliseconds(0.0f)
+{
+	glErrorCall( glGenQueries(1, &query) );
+}
+
+//Destructor
+GpuTimer::~GpuTimer()
+{
+	glErrorCall( glDeleteQueries(1, &query) );
+}
+
+
+bool GpuTimer::Begin()
+{
+	if (pending)
+	{
+		GLint available = 0;
+		glErrorCall( glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available) );
+		if (!available)
+			return false;
+
+		GLuint64 elapsed = 0;
+		glErrorCall( glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed) );
+		pending = false;
+
+		float time = elapsed / 1.0e6f;
+		if (!stale)
+			milliseconds = milliseconds == 0.0f ? time : milliseconds * 0.9f + time * 0.1f;
+		stale = false;
+	}
+
+	glErrorCall( glBeginQuery(GL_TIME_ELAPSED, query) );
+	return true;
+}
+
+
+void GpuTimer::End()
+{
+	glErrorCall( glEndQuery(GL_TIME_ELAPSED) );
+	pending = true;
+}
+
+
+void GpuTimer::Reset()
+{
+	milliseconds = 0.0f;
+	stale = pending;
+}
\ No newline at end of file
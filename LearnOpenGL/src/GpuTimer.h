@@ -0,0 +1,33 @@
+#pragma once
+
+
+/*
+GPU time of the commands between Begin() & End(), measured with a GL_TIME_ELAPSED query.
+The result is picked up once the GPU is done with it (usually a frame or two later) so the CPU never waits:
+while the last measurement is still in flight Begin() returns false & the caller draws without timing, or not at all.
+GetMilliseconds() is smoothed over the measurements.
+*/
+class GpuTimer
+{
+private:
+	unsigned int query;
+	bool pending;			//Begun & ended, result not read yet
+	bool stale;				//The pending result was measured before Reset()
+	float milliseconds;		//Smoothed, 0 until the first result
+
+public:
+	//Constructor & Destructor
+	GpuTimer();
+	~GpuTimer();
+
+	GpuTimer(const GpuTimer&) = delete;
+	GpuTimer& operator=(const GpuTimer&) = delete;
+
+	bool Begin();		//False while the previous measurement is pending, End() mustn't be called then
+	void End();
+
+	//Forgets the smoothed time, e.g. after what is measured changed
+	void Reset();
+
+	inline float GetMilliseconds() const { return milliseconds; };
+};
\ No newline at end of file
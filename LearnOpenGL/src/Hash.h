@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+//  Hashing //
+static const uint64_t hashSeed = 14695981039346656037ull;
+
+//64 bit FNV-1a, chained through hash so several inputs can go into one key
+inline uint64_t HashBytes(const void* data, size_t size, uint64_t hash = hashSeed)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+inline uint64_t HashString(const std::string& string, uint64_t hash = hashSeed)
+{
+	//The length keeps ("ab", "c") & ("a", "bc") apart
+	uint64_t length = string.size();
+	hash = HashBytes(&length, sizeof(length), hash);
+	return HashBytes(string.data(), string.size(), hash);
+}
\ No newline at end of file
@@ -1,19 +1,60 @@
 #include "IndexBuffer.h"
 #include "Renderer.h"
+#include "GLStateCache.h"
+#include "VertexArrayCache.h"
+
+#include <vector>
 
 
 //Constructor
-IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int count)
-    : count(count)
+IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int count, unsigned int primitive, unsigned int smallest_type)
+    : count(count), type(GL_UNSIGNED_INT), primitive(primitive), primitiveRestart(false)
 {
+    unsigned int maxIndex = 0;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        if (data[i] == restartIndex)
+            primitiveRestart = true;
+        else if (data[i] > maxIndex)
+            maxIndex = data[i];
+    }
+
+    //The top value of a type is its restart index, so it can't be a vertex
+    if (maxIndex < 0xFF && smallest_type == GL_UNSIGNED_BYTE)
+        type = GL_UNSIGNED_BYTE;
+    else if (maxIndex < 0xFFFF && smallest_type != GL_UNSIGNED_INT)
+        type = GL_UNSIGNED_SHORT;
+
     glErrorCall( glGenBuffers(1, &rendererID) );       //Generating a buffer
-    glErrorCall( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, rendererID) );      //Binding the buffer
-    glErrorCall( glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data, GL_STATIC_DRAW));    //Updating vertex data
+    GLStateCache::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, rendererID);      //Binding the buffer
+
+    if (type == GL_UNSIGNED_INT)
+    {
+        glErrorCall( glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data, GL_STATIC_DRAW));    //Updating vertex data
+        return;
+    }
+
+    //Narrowing, restart indices become the narrow type's top value
+    std::vector<unsigned char> narrow(count * GetIndexSize());
+    unsigned int restartValue = GetRestartValue();
+    for (unsigned int i = 0; i < count; i++)
+    {
+        unsigned int index = data[i] == restartIndex ? restartValue : data[i];
+        if (type == GL_UNSIGNED_BYTE)
+            narrow[i] = (unsigned char)index;
+        else
+            ((unsigned short*)narrow.data())[i] = (unsigned short)index;
+    }
+    glErrorCall( glBufferData(GL_ELEMENT_ARRAY_BUFFER, narrow.size(), narrow.data(), GL_STATIC_DRAW) );
 }
 
 //Destructor
 IndexBuffer::~IndexBuffer()
 {
+    if (VertexArrayCache* vertexArrays = VertexArrayCache::TryGet())
+        vertexArrays->OnDeleteBuffer(rendererID);
+
+    GLStateCache::Get().OnDeleteBuffer(rendererID);
     glErrorCall( glDeleteBuffers(1, &rendererID) );
 }
 
@@ -21,7 +62,12 @@ IndexBuffer::~IndexBuffer()
 //Binding the buffers
 void IndexBuffer::Bind() const
 {
-    glErrorCall( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, rendererID) );
+    GLStateCache::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, rendererID);
+
+    if (primitiveRestart)
+        EnablePrimitiveRestart(GetRestartValue());
+    else
+        DisablePrimitiveRestart();
 
 }
 
@@ -29,6 +75,47 @@ void IndexBuffer::Bind() const
 //Unbinding the buffers
 void IndexBuffer::Unbind() const
 {
-    glErrorCall( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
+    GLStateCache::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
+}
+
+
+unsigned int IndexBuffer::GetSizeOfType(unsigned int type)
+{
+    switch (type)
+    {
+        case GL_UNSIGNED_BYTE:      return 1;
+        case GL_UNSIGNED_SHORT:     return 2;
+        case GL_UNSIGNED_INT:       return 4;
+    }
+
+    ASSERT(false);
+    return 0;
+}
+
+
+//GL 4.3 (or ARB_ES3_compatibility) restarts at the top value of whatever type is drawn, older versions need the value set
+static bool HasFixedRestartIndex()
+{
+    static const bool fixedIndex = GLEW_VERSION_4_3 || GLEW_ARB_ES3_compatibility;
+    return fixedIndex;
+}
+
+
+void IndexBuffer::EnablePrimitiveRestart(unsigned int restart_value)
+{
+    if (HasFixedRestartIndex())
+    {
+        GLStateCache::Get().Enable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
+        return;
+    }
+
+    GLStateCache::Get().Enable(GL_PRIMITIVE_RESTART);
+    GLStateCache::Get().PrimitiveRestartIndex(restart_value);
+}
+
+
+void IndexBuffer::DisablePrimitiveRestart()
+{
+    GLStateCache::Get().Disable(HasFixedRestartIndex() ? GL_PRIMITIVE_RESTART_FIXED_INDEX : GL_PRIMITIVE_RESTART);
 }
\ No newline at end of file
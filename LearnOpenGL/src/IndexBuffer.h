@@ -1,20 +1,50 @@
 #pragma once
 
+#include <GL/glew.h>
 
+
+/*
+Indices are passed as unsigned int & stored in the smallest type that holds the largest one, starting at smallest_type:
+GL_UNSIGNED_SHORT below 65535, GL_UNSIGNED_INT otherwise (the top value of each type is kept for restarts).
+Byte indices (below 255) are opt-in with smallest_type = GL_UNSIGNED_BYTE, many drivers convert them on the CPU or run them slower.
+GL_UNSIGNED_INT opts out.
+Indices equal to restartIndex end the current strip / fan, they become the top value of the stored type
+& Bind() turns primitive restart on for the draws, so all strips of a mesh go in one call.
+*/
 class IndexBuffer
 {
+public:
+	static const unsigned int restartIndex = 0xFFFFFFFF;
+
 private:
 	unsigned int rendererID;
 	unsigned int count;
+	unsigned int type;				//GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+	unsigned int primitive;			//GL_TRIANGLES, GL_TRIANGLE_STRIP, ...
+	bool primitiveRestart;			//Has restart indices
 
 public:
 	//Constructor & Destructor
-	IndexBuffer(const unsigned int* data, unsigned int count);
+	IndexBuffer(const unsigned int* data, unsigned int count, unsigned int primitive = GL_TRIANGLES, unsigned int smallest_type = GL_UNSIGNED_SHORT);
 	~IndexBuffer();
 
-	void Bind() const;
+	void Bind() const;		//Also turns primitive restart on or off for this buffer's draws
 	void Unbind() const;
 
 	//Getter
 	inline unsigned int GetCount() const { return count; }
+	inline unsigned int GetRendererID() const { return rendererID; }
+	inline unsigned int GetType() const { return type; }
+	inline unsigned int GetPrimitive() const { return primitive; }
+	inline bool UsesPrimitiveRestart() const { return primitiveRestart; }
+	inline unsigned int GetIndexSize() const { return GetSizeOfType(type); }
+	inline unsigned int GetRestartValue() const { return type == GL_UNSIGNED_BYTE ? 0xFF : type == GL_UNSIGNED_SHORT ? 0xFFFF : restartIndex; }	//As stored
+
+	static unsigned int GetSizeOfType(unsigned int type);
+
+	//For draws with indices that don't come from an IndexBuffer
+	static void DisablePrimitiveRestart();
+
+private:
+	static void EnablePrimitiveRestart(unsigned int restart_value);
 };
\ No newline at end of file
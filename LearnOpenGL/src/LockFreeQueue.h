@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+
+/*
+Bounded multi producer / multi consumer queue without locks (Dmitry Vyukov's design).
+Every cell carries a sequence number that says whose turn it is, so producers & consumers
+only ever race on the two position counters with a compare-exchange.
+Capacity has to be a power of two.
+*/
+template<typename T>
+class LockFreeQueue
+{
+private:
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		T data;
+	};
+
+	//Keeping the counters on separate cache lines, producers & consumers would fight over one otherwise
+	alignas(64) std::unique_ptr<Cell[]> cells;
+	size_t mask;
+	alignas(64) std::atomic<size_t> enqueuePos;
+	alignas(64) std::atomic<size_t> dequeuePos;
+
+public:
+	//Constructor
+	LockFreeQueue(size_t capacity)
+		: cells(new Cell[capacity]), mask(capacity - 1), enqueuePos(0), dequeuePos(0)
+	{
+		for (size_t i = 0; i < capacity; i++)
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	LockFreeQueue(const LockFreeQueue&) = delete;
+	LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+	//Returns false if the queue is full
+	bool Push(const T& data)
+	{
+		size_t pos = enqueuePos.load(std::memory_order_relaxed);
+		Cell* cell;
+		while (true)
+		{
+			cell = &cells[pos & mask];
+			size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+
+			if (diff == 0)
+			{
+				if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+				return false;
+			else
+				pos = enqueuePos.load(std::memory_order_relaxed);
+		}
+
+		cell->data = data;
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	//Returns false if the queue is empty
+	bool Pop(T& data)
+	{
+		size_t pos = dequeuePos.load(std::memory_order_relaxed);
+		Cell* cell;
+		while (true)
+		{
+			cell = &cells[pos & mask];
+			size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+
+			if (diff == 0)
+			{
+				if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+				return false;
+			else
+				pos = dequeuePos.load(std::memory_order_relaxed);
+		}
+
+		data = cell->data;
+		cell->sequence.store(pos + mask + 1, std::memory_order_release);
+		return true;
+	}
+
+	//Only a snapshot, other threads may change it right after
+	size_t GetSize() const
+	{
+		size_t enqueued = enqueuePos.load(std::memory_order_relaxed);
+		size_t dequeued = dequeuePos.load(std::memory_order_relaxed);
+		return enqueued >= dequeued ? enqueued - dequeued : 0;
+	}
+};
\ No newline at end of file
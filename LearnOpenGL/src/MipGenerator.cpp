@@ -0,0 +1,267 @@
+#include "MipGenerator.h"
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+//  sRGB    //
+//Decoding is exact per byte, encoding goes through 12 bits of linear light which is finer than any 8 bit step
+struct SRGBTables
+{
+	float toLinear[256];
+	unsigned char fromLinear[4096];
+
+	SRGBTables()
+	{
+		for (int i = 0; i < 256; i++)
+		{
+			float c = i / 255.0f;
+			toLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+		}
+
+		for (int i = 0; i < 4096; i++)
+		{
+			float c = i / 4095.0f;
+			float encoded = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+			fromLinear[i] = (unsigned char)(encoded * 255.0f + 0.5f);
+		}
+	}
+};
+
+static const SRGBTables& GetSRGBTables()
+{
+	static SRGBTables tables;
+	return tables;
+}
+
+
+//One pixel as 4 floats in 0 - 1, colour as linear light if srgb
+static inline __m128 LoadPixel(const unsigned char* pixel, bool srgb, const SRGBTables& tables)
+{
+	if (srgb)
+		return _mm_set_ps(pixel[3] / 255.0f, tables.toLinear[pixel[2]], tables.toLinear[pixel[1]], tables.toLinear[pixel[0]]);
+
+	int packed;
+	std::memcpy(&packed, pixel, 4);
+	__m128i bytes = _mm_cvtsi32_si128(packed);
+	__m128i ints = _mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, _mm_setzero_si128()), _mm_setzero_si128());
+	return _mm_mul_ps(_mm_cvtepi32_ps(ints), _mm_set1_ps(1.0f / 255.0f));
+}
+
+static inline void StorePixel(__m128 value, unsigned char* pixel, bool srgb, const SRGBTables& tables)
+{
+	value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+
+	if (srgb)
+	{
+		float channels[4];
+		_mm_storeu_ps(channels, value);
+		for (int c = 0; c < 3; c++)
+			pixel[c] = tables.fromLinear[(int)(channels[c] * 4095.0f + 0.5f)];
+		pixel[3] = (unsigned char)(channels[3] * 255.0f + 0.5f);
+		return;
+	}
+
+	__m128i ints = _mm_cvtps_epi32(_mm_mul_ps(value, _mm_set1_ps(255.0f)));
+	__m128i bytes = _mm_packus_epi16(_mm_packs_epi32(ints, ints), _mm_setzero_si128());
+	int packed = _mm_cvtsi128_si32(bytes);
+	std::memcpy(pixel, &packed, 4);
+}
+
+
+//  Kaiser  //
+//Output pixel x covers source pixels 2x & 2x + 1, the taps reach 5 pixels further to each side
+static const int kaiserTaps = 12;
+static const int kaiserReach = kaiserTaps / 2 - 1;
+
+static double BesselI0(double x)
+{
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 32; k++)
+	{
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+//Windowed sinc at the distances of the taps, measured in output pixels, normalized to a sum of 1
+static const float* GetKaiserWeights()
+{
+	struct Weights
+	{
+		float values[kaiserTaps];
+
+		Weights()
+		{
+			const double pi = 3.14159265358979323846, beta = 4.0, radius = kaiserTaps / 4.0;
+			double sum = 0.0;
+			for (int t = 0; t < kaiserTaps; t++)
+			{
+				double distance = (t - kaiserReach - 0.5) / 2.0;
+				double sinc = distance == 0.0 ? 1.0 : std::sin(pi * distance) / (pi * distance);
+				double ratio = distance / radius;
+				double window = BesselI0(beta * std::sqrt(std::max(0.0, 1.0 - ratio * ratio))) / BesselI0(beta);
+				values[t] = (float)(sinc * window);
+				sum += values[t];
+			}
+
+			for (float& value : values)
+				value = (float)(value / sum);
+		}
+	};
+
+	static Weights weights;
+	return weights.values;
+}
+
+
+//  MipGenerator    //
+void MipGenerator::Generate(TextureImage& image, MipFilter filter, bool srgb)
+{
+	if (image.format != TextureFormat::RGBA8 || image.levels.empty())
+		return;
+
+	int levelWidth = image.width, levelHeight = image.height;
+	for (size_t level = 1; level < image.levels.size(); level++)
+	{
+		levelWidth = std::max(1, levelWidth / 2);
+		levelHeight = std::max(1, levelHeight / 2);
+	}
+
+	while (levelWidth > 1 || levelHeight > 1)
+	{
+		std::vector<unsigned char> next;
+		Downsample(image.levels.back().data(), levelWidth, levelHeight, next, filter, srgb);
+		image.levels.push_back(std::move(next));
+
+		levelWidth = std::max(1, levelWidth / 2);
+		levelHeight = std::max(1, levelHeight / 2);
+	}
+}
+
+
+void MipGenerator::Downsample(const unsigned char* pixels, int width, int height, std::vector<unsigned char>& out, MipFilter filter, bool srgb)
+{
+	out.resize(std::max(1, width / 2) * std::max(1, height / 2) * 4);
+
+	if (filter == MipFilter::Kaiser)
+		DownsampleKaiser(pixels, width, height, out, srgb);
+	else if (srgb)
+		DownsampleBoxSRGB(pixels, width, height, out);
+	else
+		DownsampleBox(pixels, width, height, out);
+}
+
+
+int MipGenerator::GetLevelCount(int width, int height)
+{
+	int levels = 1;
+	for (int size = std::max(width, height); size > 1; size /= 2)
+		levels++;
+	return levels;
+}
+
+
+//Integer average of 2x2 pixels, in 16 bit lanes: both rows added, then both columns, rounded & divided by 4
+void MipGenerator::DownsampleBox(const unsigned char* pixels, int width, int height, std::vector<unsigned char>& out)
+{
+	int outWidth = std::max(1, width / 2), outHeight = std::max(1, height / 2);
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i rounding = _mm_set1_epi16(2);
+
+	for (int y = 0; y < outHeight; y++)
+	{
+		const unsigned char* row0 = pixels + std::min(y * 2, height - 1) * width * 4;
+		const unsigned char* row1 = pixels + std::min(y * 2 + 1, height - 1) * width * 4;
+
+		for (int x = 0; x < outWidth; x++)
+		{
+			int x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+			int corners[4];
+			std::memcpy(&corners[0], row0 + x0 * 4, 4);
+			std::memcpy(&corners[1], row0 + x1 * 4, 4);
+			std::memcpy(&corners[2], row1 + x0 * 4, 4);
+			std::memcpy(&corners[3], row1 + x1 * 4, 4);
+			__m128i top = _mm_unpacklo_epi32(_mm_cvtsi32_si128(corners[0]), _mm_cvtsi32_si128(corners[1]));
+			__m128i bottom = _mm_unpacklo_epi32(_mm_cvtsi32_si128(corners[2]), _mm_cvtsi32_si128(corners[3]));
+
+			__m128i sum = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+			sum = _mm_add_epi16(sum, _mm_srli_si128(sum, 8));
+			sum = _mm_srli_epi16(_mm_add_epi16(sum, rounding), 2);
+
+			int packed = _mm_cvtsi128_si32(_mm_packus_epi16(sum, zero));
+			std::memcpy(&out[(y * outWidth + x) * 4], &packed, 4);
+		}
+	}
+}
+
+
+void MipGenerator::DownsampleBoxSRGB(const unsigned char* pixels, int width, int height, std::vector<unsigned char>& out)
+{
+	const SRGBTables& tables = GetSRGBTables();
+	int outWidth = std::max(1, width / 2), outHeight = std::max(1, height / 2);
+	const __m128 quarter = _mm_set1_ps(0.25f);
+
+	for (int y = 0; y < outHeight; y++)
+	{
+		const unsigned char* row0 = pixels + std::min(y * 2, height - 1) * width * 4;
+		const unsigned char* row1 = pixels + std::min(y * 2 + 1, height - 1) * width * 4;
+
+		for (int x = 0; x < outWidth; x++)
+		{
+			int x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+			__m128 sum = _mm_add_ps(_mm_add_ps(LoadPixel(row0 + x0 * 4, true, tables), LoadPixel(row0 + x1 * 4, true, tables)),
+				_mm_add_ps(LoadPixel(row1 + x0 * 4, true, tables), LoadPixel(row1 + x1 * 4, true, tables)));
+			StorePixel(_mm_mul_ps(sum, quarter), &out[(y * outWidth + x) * 4], true, tables);
+		}
+	}
+}
+
+
+//Separable: every source row is filtered horizontally once into a ring of the 12 rows the current output row needs
+void MipGenerator::DownsampleKaiser(const unsigned char* pixels, int width, int height, std::vector<unsigned char>& out, bool srgb)
+{
+	const SRGBTables& tables = GetSRGBTables();
+	const float* weights = GetKaiserWeights();
+	int outWidth = std::max(1, width / 2), outHeight = std::max(1, height / 2);
+
+	//Plain floats with unaligned loads, vectors of __m128 aren't guaranteed 16 byte alignment before C++17
+	std::vector<float> source(width * 4);
+	std::vector<std::vector<float>> ring(kaiserTaps, std::vector<float>(outWidth * 4));
+	int nextRow = -kaiserReach;		//Rows above & below the image repeat the edge
+
+	for (int y = 0; y < outHeight; y++)
+	{
+		int firstRow = y * 2 - kaiserReach;
+		for (; nextRow < firstRow + kaiserTaps; nextRow++)
+		{
+			const unsigned char* row = pixels + std::min(std::max(nextRow, 0), height - 1) * width * 4;
+			for (int x = 0; x < width; x++)
+				_mm_storeu_ps(&source[x * 4], LoadPixel(row + x * 4, srgb, tables));
+
+			std::vector<float>& filtered = ring[(nextRow + kaiserTaps * 2) % kaiserTaps];
+			for (int x = 0; x < outWidth; x++)
+			{
+				__m128 sum = _mm_setzero_ps();
+				for (int t = 0; t < kaiserTaps; t++)
+				{
+					int sourceX = std::min(std::max(x * 2 - kaiserReach + t, 0), width - 1);
+					sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(&source[sourceX * 4]), _mm_set1_ps(weights[t])));
+				}
+				_mm_storeu_ps(&filtered[x * 4], sum);
+			}
+		}
+
+		for (int x = 0; x < outWidth; x++)
+		{
+			__m128 sum = _mm_setzero_ps();
+			for (int t = 0; t < kaiserTaps; t++)
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(&ring[(firstRow + t + kaiserTaps * 2) % kaiserTaps][x * 4]), _mm_set1_ps(weights[t])));
+			StorePixel(sum, &out[(y * outWidth + x) * 4], srgb, tables);
+		}
+	}
+}
\ No newline at end of file
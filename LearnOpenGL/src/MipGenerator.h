@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+
+#include "TextureCompressor.h"
+
+
+enum class MipFilter
+{
+	Box,		//Average of each 2x2 block, fast
+	Kaiser		//Kaiser windowed sinc over 12x12 texels, keeps smaller levels sharper
+};
+
+
+/*
+CPU mip chain generation for RGBA8 images, at load time or when textures are cooked by the encoder.
+Both filters run on SSE2, one pixel (4 channels) per register.
+With srgb the colour channels are averaged as linear light & converted back, alpha is always linear,
+otherwise a checkerboard of black & white turns into sRGB 128 (far too dark) instead of 188.
+*/
+class MipGenerator
+{
+public:
+	//Appends every level below the last one of an RGBA8 image, down to 1x1
+	static void Generate(TextureImage& image, MipFilter filter = MipFilter::Box, bool srgb = false);
+
+	//One level: max(1, width / 2) x max(1, height / 2)
+	static void Downsample(const unsigned char* pixels, int width, int height, std::vector<unsigned char>& out,
+		MipFilter filter = MipFilter::Box, bool srgb = false);
+
+	static int GetLevelCount(int width, int height);		//Of a full chain
+
+private:
+	static void DownsampleBox(const unsigned char* pixels, int width, int height, std::vector<unsigned char>& out);
+	static void DownsampleBoxSRGB(const unsigned char* pixels, int width, int height, std::vector<unsigned char>& out);
+	static void DownsampleKaiser(const unsigned char* pixels, int width, int height, std::vector<unsigned char>& out, bool srgb);
+};
\ No newline at end of file
@@ -0,0 +1,298 @@
+#include "OffsetAllocator.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+
+//Constructor
+OffsetAllocator::OffsetAllocator(uint32_t capacity)
+	: capacity(capacity)
+{
+	Reset();
+}
+
+
+void OffsetAllocator::Reset()
+{
+	used = 0;
+	allocationCount = 0;
+	freeRangeCount = 0;
+	topBinMask = 0;
+	for (uint8_t& mask : binMasks)
+		mask = 0;
+	for (uint32_t& head : binHeads)
+		head = noSpace;
+
+	nodes.clear();
+	unusedNodes.clear();
+
+	if (capacity > 0)
+		InsertIntoBin(CreateNode(0, capacity));
+}
+
+
+OffsetAllocator::Allocation OffsetAllocator::Allocate(uint32_t size)
+{
+	Allocation allocation;
+	if (size == 0)
+		return allocation;
+
+	//Smallest bin guaranteed to fit: first the rest of its top level bin, then the next top level bin with anything in it
+	uint32_t minBin = GetBinRoundUp(size);
+	uint32_t topIndex = minBin >> mantissaBits;
+	if (topIndex >= topBinCount)
+		return allocation;
+
+	uint32_t bin = noSpace;
+	uint32_t leafMask = binMasks[topIndex] & (0xFFu << (minBin & (binsPerLevel - 1)));
+	if (leafMask)
+	{
+		bin = (topIndex << mantissaBits) | FindLowestBit(leafMask);
+	}
+	else
+	{
+		uint32_t topMask = topIndex + 1 < topBinCount ? topBinMask & (0xFFFFFFFFu << (topIndex + 1)) : 0;
+		if (topMask)
+		{
+			uint32_t top = FindLowestBit(topMask);
+			bin = (top << mantissaBits) | FindLowestBit(binMasks[top]);
+		}
+	}
+
+	//Taking the first range of the bin, what is left over goes back as a free range right after it
+	uint32_t index = bin != noSpace ? binHeads[bin] : FindInBin(GetBinRoundDown(size), size);
+	if (index == noSpace)
+		return allocation;
+	RemoveFromBin(index);
+
+	uint32_t remainder = nodes[index].size - size;
+	nodes[index].size = size;
+	nodes[index].used = true;
+
+	if (remainder > 0)
+	{
+		uint32_t rest = CreateNode(nodes[index].offset + size, remainder);
+		nodes[rest].neighborPrev = index;
+		nodes[rest].neighborNext = nodes[index].neighborNext;
+		if (nodes[index].neighborNext != noSpace)
+			nodes[nodes[index].neighborNext].neighborPrev = rest;
+		nodes[index].neighborNext = rest;
+		InsertIntoBin(rest);
+	}
+
+	used += size;
+	allocationCount++;
+
+	allocation.offset = nodes[index].offset;
+	allocation.node = index;
+	return allocation;
+}
+
+
+void OffsetAllocator::Free(const Allocation& allocation)
+{
+	if (!allocation.IsValid() || allocation.node >= nodes.size() || !nodes[allocation.node].used)
+		return;
+
+	uint32_t index = allocation.node;
+	used -= nodes[index].size;
+	allocationCount--;
+	nodes[index].used = false;
+
+	//Swallowing free neighbours, the node keeps standing for the merged range
+	uint32_t prev = nodes[index].neighborPrev;
+	if (prev != noSpace && !nodes[prev].used)
+	{
+		RemoveFromBin(prev);
+		nodes[index].offset = nodes[prev].offset;
+		nodes[index].size += nodes[prev].size;
+		nodes[index].neighborPrev = nodes[prev].neighborPrev;
+		ReleaseNode(prev);
+	}
+
+	uint32_t next = nodes[index].neighborNext;
+	if (next != noSpace && !nodes[next].used)
+	{
+		RemoveFromBin(next);
+		nodes[index].size += nodes[next].size;
+		nodes[index].neighborNext = nodes[next].neighborNext;
+		ReleaseNode(next);
+	}
+
+	if (nodes[index].neighborPrev != noSpace)
+		nodes[nodes[index].neighborPrev].neighborNext = index;
+	if (nodes[index].neighborNext != noSpace)
+		nodes[nodes[index].neighborNext].neighborPrev = index;
+
+	InsertIntoBin(index);
+}
+
+
+uint32_t OffsetAllocator::GetAllocationSize(const Allocation& allocation) const
+{
+	if (!allocation.IsValid() || allocation.node >= nodes.size() || !nodes[allocation.node].used)
+		return 0;
+	return nodes[allocation.node].size;
+}
+
+
+OffsetAllocator::Stats OffsetAllocator::GetStats() const
+{
+	Stats stats;
+	stats.capacity = capacity;
+	stats.used = used;
+	stats.freeRanges = freeRangeCount;
+	stats.allocations = allocationCount;
+
+	//The largest range is somewhere in the highest non-empty bin
+	if (topBinMask)
+	{
+		uint32_t top = FindHighestBit(topBinMask);
+		uint32_t bin = (top << mantissaBits) | FindHighestBit(binMasks[top]);
+		for (uint32_t index = binHeads[bin]; index != noSpace; index = nodes[index].binNext)
+		{
+			if (nodes[index].size > stats.largestFree)
+				stats.largestFree = nodes[index].size;
+		}
+	}
+
+	return stats;
+}
+
+
+//Nearly full heaps: the bin below the guaranteed ones can still hold ranges that are large enough
+uint32_t OffsetAllocator::FindInBin(uint32_t bin, uint32_t size) const
+{
+	for (uint32_t index = binHeads[bin]; index != noSpace; index = nodes[index].binNext)
+	{
+		if (nodes[index].size >= size)
+			return index;
+	}
+	return noSpace;
+}
+
+
+uint32_t OffsetAllocator::CreateNode(uint32_t offset, uint32_t size)
+{
+	uint32_t index;
+	if (!unusedNodes.empty())
+	{
+		index = unusedNodes.back();
+		unusedNodes.pop_back();
+	}
+	else
+	{
+		index = (uint32_t)nodes.size();
+		nodes.emplace_back();
+	}
+
+	Node& node = nodes[index];
+	node.offset = offset;
+	node.size = size;
+	node.binPrev = node.binNext = noSpace;
+	node.neighborPrev = node.neighborNext = noSpace;
+	node.used = false;
+	return index;
+}
+
+
+void OffsetAllocator::ReleaseNode(uint32_t node)
+{
+	unusedNodes.push_back(node);
+}
+
+
+void OffsetAllocator::InsertIntoBin(uint32_t node)
+{
+	uint32_t bin = GetBinRoundDown(nodes[node].size);
+	uint32_t top = bin >> mantissaBits;
+
+	nodes[node].binPrev = noSpace;
+	nodes[node].binNext = binHeads[bin];
+	if (binHeads[bin] != noSpace)
+		nodes[binHeads[bin]].binPrev = node;
+	binHeads[bin] = node;
+
+	binMasks[top] |= 1 << (bin & (binsPerLevel - 1));
+	topBinMask |= 1u << top;
+	freeRangeCount++;
+}
+
+
+void OffsetAllocator::RemoveFromBin(uint32_t node)
+{
+	Node& removed = nodes[node];
+	if (removed.binPrev != noSpace)
+	{
+		nodes[removed.binPrev].binNext = removed.binNext;
+	}
+	else
+	{
+		//Head of its bin, clearing the mask bits once the bin is empty
+		uint32_t bin = GetBinRoundDown(removed.size);
+		uint32_t top = bin >> mantissaBits;
+		binHeads[bin] = removed.binNext;
+		if (binHeads[bin] == noSpace)
+		{
+			binMasks[top] &= ~(1 << (bin & (binsPerLevel - 1)));
+			if (binMasks[top] == 0)
+				topBinMask &= ~(1u << top);
+		}
+	}
+
+	if (removed.binNext != noSpace)
+		nodes[removed.binNext].binPrev = removed.binPrev;
+
+	removed.binPrev = removed.binNext = noSpace;
+	freeRangeCount--;
+}
+
+
+//  Bins    //
+//Bin = exponent << 3 | 3 bits below the highest set bit, sizes 0 - 7 are their own bins
+uint32_t OffsetAllocator::GetBinRoundUp(uint32_t size)
+{
+	if (size < binsPerLevel)
+		return size;
+
+	uint32_t shift = FindHighestBit(size) - mantissaBits;
+	uint32_t bin = ((shift + 1) << mantissaBits) | ((size >> shift) & (binsPerLevel - 1));
+	if (size & ((1u << shift) - 1))
+		bin++;		//Carries into the exponent when the mantissa is full, which is still the right bin
+	return bin;
+}
+
+
+uint32_t OffsetAllocator::GetBinRoundDown(uint32_t size)
+{
+	if (size < binsPerLevel)
+		return size;
+
+	uint32_t shift = FindHighestBit(size) - mantissaBits;
+	return ((shift + 1) << mantissaBits) | ((size >> shift) & (binsPerLevel - 1));
+}
+
+
+uint32_t OffsetAllocator::FindLowestBit(uint32_t mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return index;
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+
+
+uint32_t OffsetAllocator::FindHighestBit(uint32_t mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanReverse(&index, mask);
+	return index;
+#else
+	return 31 - __builtin_clz(mask);
+#endif
+}
\ No newline at end of file
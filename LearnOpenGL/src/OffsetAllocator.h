@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+
+/*
+Hands out ranges of a fixed size space (offsets & sizes in any unit) without touching the memory itself,
+for sub-allocating GPU buffers. Two level segregated fit (TLSF):
+free ranges sit in 256 bins by size, 8 bins for every power of two (sizes below 8 have a bin each),
+& two levels of bit masks find the smallest non-empty bin that fits in O(1).
+Only when none is left, the ranges of the bin the size itself falls into are searched one by one.
+Freed ranges are merged with free neighbours right away, so free space only splinters by what stays allocated.
+*/
+class OffsetAllocator
+{
+public:
+	static const uint32_t noSpace = 0xFFFFFFFF;
+
+	struct Allocation
+	{
+		uint32_t offset = noSpace;
+		uint32_t node = noSpace;		//Handle for Free()
+
+		inline bool IsValid() const { return offset != noSpace; };
+	};
+
+	struct Stats
+	{
+		uint32_t capacity = 0;
+		uint32_t used = 0;
+		uint32_t largestFree = 0;
+		uint32_t freeRanges = 0;
+		uint32_t allocations = 0;
+
+		inline uint32_t GetFree() const { return capacity - used; };
+		inline float GetUtilization() const { return capacity ? (float)used / capacity : 0.0f; };
+		//0 when all free space is one range, towards 1 the more it is split into small pieces
+		inline float GetFragmentation() const { return GetFree() ? 1.0f - (float)largestFree / GetFree() : 0.0f; };
+	};
+
+private:
+	static const uint32_t mantissaBits = 3;
+	static const uint32_t binsPerLevel = 1 << mantissaBits;
+	static const uint32_t topBinCount = 32;
+	static const uint32_t binCount = topBinCount * binsPerLevel;
+
+	struct Node
+	{
+		uint32_t offset, size;
+		uint32_t binPrev, binNext;				//Other free ranges in the same bin
+		uint32_t neighborPrev, neighborNext;	//Ranges right before & after this one, free or not
+		bool used;
+	};
+
+	uint32_t capacity;
+	uint32_t used;
+	uint32_t allocationCount, freeRangeCount;
+
+	uint32_t topBinMask;					//Bit per top level bin that has any free range
+	uint8_t binMasks[topBinCount];			//Bit per bin within a top level bin
+	uint32_t binHeads[binCount];
+
+	std::vector<Node> nodes;
+	std::vector<uint32_t> unusedNodes;
+
+public:
+	//Constructor
+	OffsetAllocator(uint32_t capacity);
+
+	//Returns an invalid allocation if no free range is large enough
+	Allocation Allocate(uint32_t size);
+	void Free(const Allocation& allocation);
+	void Reset();		//Everything free again, allocations made so far become invalid
+
+	uint32_t GetAllocationSize(const Allocation& allocation) const;
+	Stats GetStats() const;
+	inline uint32_t GetCapacity() const { return capacity; };
+
+private:
+	uint32_t CreateNode(uint32_t offset, uint32_t size);
+	void ReleaseNode(uint32_t node);
+	void InsertIntoBin(uint32_t node);
+	void RemoveFromBin(uint32_t node);
+	uint32_t FindInBin(uint32_t bin, uint32_t size) const;		//First range of the bin that fits, or noSpace
+
+	//Sizes are binned like small floats (3 bit mantissa), rounding up when looking for space guarantees a fit
+	static uint32_t GetBinRoundUp(uint32_t size);
+	static uint32_t GetBinRoundDown(uint32_t size);
+	static uint32_t FindLowestBit(uint32_t mask);
+	static uint32_t FindHighestBit(uint32_t mask);
+};
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include "ProgramBinaryCache.h"
+#include "Renderer.h"
+#include "Hash.h"
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+
+#ifdef _WIN32
+	#include <direct.h>
+#else
+	#include <sys/stat.h>
+#endif
+
+
+//Layout of the start of every cache file, followed by the binary itself
+struct ProgramBinaryHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t key;
+	uint32_t format;
+	uint32_t length;
+};
+
+static const uint32_t programBinaryMagic = 0x42504C47;		//"GLPB"
+static const uint32_t programBinaryVersion = 1;
+
+
+ProgramBinaryCache& ProgramBinaryCache::Get()
+{
+	static ProgramBinaryCache cache;
+	return cache;
+}
+
+
+//Constructor
+ProgramBinaryCache::ProgramBinaryCache()
+	: directory("res/shaders/cache/"), enabled(true), supported(false), initialized(false), driverHash(0)
+{
+}
+
+
+uint64_t ProgramBinaryCache::MakeKey(const std::string& vertex_source, const std::string& fragment_source, const std::string& defines)
+{
+	Initialize();
+
+	uint64_t hash = driverHash;
+	hash = HashString(vertex_source, hash);
+	hash = HashString(fragment_source, hash);
+	hash = HashString(defines, hash);
+	return hash;
+}
+
+
+unsigned int ProgramBinaryCache::LoadProgram(const std::string& name, uint64_t key)
+{
+	Initialize();
+	if (!enabled || !supported)
+		return 0;
+
+	std::ifstream file(GetEntryPath(name), std::ios::binary);
+	if (!file)
+		return 0;
+
+	//An entry with another key was written for an older source or driver
+	ProgramBinaryHeader header;
+	if (!file.read((char*)&header, sizeof(header)) || header.magic != programBinaryMagic ||
+		header.version != programBinaryVersion || header.key != key || header.length == 0)
+	{
+		stats.rejected++;
+		return 0;
+	}
+
+	std::vector<char> binary(header.length);
+	if (!file.read(binary.data(), header.length))
+	{
+		stats.rejected++;
+		return 0;
+	}
+
+	glErrorCall( unsigned int program = glCreateProgram() );
+
+	//The driver is free to refuse binaries of its own (e.g. after an update that kept the version string),
+	//that may raise an error as well, but only the link status matters
+	glProgramBinary(program, header.format, binary.data(), header.length);
+	glClearErrors();
+
+	int linked = GL_FALSE;
+	glErrorCall( glGetProgramiv(program, GL_LINK_STATUS, &linked) );
+	if (linked == GL_FALSE)
+	{
+		glErrorCall( glDeleteProgram(program) );
+		stats.rejected++;
+		return 0;
+	}
+
+	return program;
+}
+
+
+void ProgramBinaryCache::StoreProgram(const std::string& name, uint64_t key, unsigned int program)
+{
+	Initialize();
+	if (!enabled || !supported || program == 0)
+		return;
+
+	int length = 0;
+	glErrorCall( glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length) );
+	if (length <= 0)
+		return;
+
+	std::vector<char> binary(length);
+	GLenum format = 0;
+	glErrorCall( glGetProgramBinary(program, length, &length, &format, binary.data()) );
+
+	std::ofstream file(GetEntryPath(name), std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		std::cout << "WARNING::ProgramBinaryCache.cpp::StoreProgram():: Can't write to '" << GetEntryPath(name) << "'" << std::endl;
+		return;
+	}
+
+	ProgramBinaryHeader header = { programBinaryMagic, programBinaryVersion, key, format, (uint32_t)length };
+	file.write((const char*)&header, sizeof(header));
+	file.write(binary.data(), length);
+}
+
+
+void ProgramBinaryCache::RecordSetup(bool warm, float time)
+{
+	if (warm)
+	{
+		stats.warmCount++;
+		stats.warmTime += time;
+	}
+	else
+	{
+		stats.coldCount++;
+		stats.coldTime += time;
+	}
+}
+
+
+void ProgramBinaryCache::Initialize()
+{
+	if (initialized)
+		return;
+	initialized = true;
+
+	//Binaries are only worth anything if the driver can read back at least one format
+	int formatCount = 0;
+	if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)
+		glErrorCall( glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount) );
+	supported = formatCount > 0;
+
+	const char* driverStrings[] = {
+		(const char*)glGetString(GL_VENDOR),
+		(const char*)glGetString(GL_RENDERER),
+		(const char*)glGetString(GL_VERSION)
+	};
+
+	driverHash = HashBytes(&programBinaryVersion, sizeof(programBinaryVersion));
+	for (const char* string : driverStrings)
+		driverHash = HashString(string ? string : "", driverHash);
+
+	if (supported)
+	{
+		#ifdef _WIN32
+			_mkdir(directory.c_str());
+		#else
+			mkdir(directory.c_str(), 0755);
+		#endif
+	}
+}
+
+
+//One file per program (& permutation), so a stale entry is simply overwritten by the next compile
+std::string ProgramBinaryCache::GetEntryPath(const std::string& name) const
+{
+	std::string fileName = name;
+	for (char& c : fileName)
+	{
+		if (c == '/' || c == '\\' || c == ':' || c == '.')
+			c = '_';
+	}
+
+	return directory + fileName + ".bin";
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <string>
+
+
+/*
+On-disk cache of linked programs (glGetProgramBinary / glProgramBinary).
+Entries are keyed by a hash of the sources, defines & the driver (vendor, renderer, version),
+so editing a shader or updating the driver turns the old entry stale & it gets overwritten after the next compile.
+Binaries are only an optimization: anything that fails to load falls back to compiling from source.
+*/
+class ProgramBinaryCache
+{
+public:
+	//Counters for the whole run, shaders report their setup time here
+	struct Stats
+	{
+		unsigned int warmCount = 0;		//Programs loaded from a binary
+		unsigned int coldCount = 0;		//Programs compiled & linked from source
+		unsigned int rejected = 0;		//Binaries found on disk but refused (stale or by the driver)
+		float warmTime = 0.0f;			//ms
+		float coldTime = 0.0f;			//ms
+	};
+
+private:
+	std::string directory;
+	bool enabled;
+	bool supported;
+	bool initialized;		//The driver is only queried once a context exists
+	uint64_t driverHash;
+
+	Stats stats;
+
+public:
+	static ProgramBinaryCache& Get();
+
+	//Key of a program, changes with any of its inputs
+	uint64_t MakeKey(const std::string& vertex_source, const std::string& fragment_source, const std::string& defines);
+
+	//Returns a linked program, or 0 if there is no usable entry
+	unsigned int LoadProgram(const std::string& name, uint64_t key);
+	void StoreProgram(const std::string& name, uint64_t key, unsigned int program);
+
+	void RecordSetup(bool warm, float time);
+
+	//Disabling forces every program to be compiled, for measuring the cold path
+	inline void SetEnabled(bool enable) { enabled = enable; };
+	inline bool IsEnabled() const { return enabled; };
+	inline bool IsSupported() { Initialize(); return supported; };
+	inline const Stats& GetStats() const { return stats; };
+
+private:
+	ProgramBinaryCache();
+
+	void Initialize();
+	std::string GetEntryPath(const std::string& name) const;
+};
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "RenderQueue.h"
+
+#include <chrono>
+
+
+//Building the sort key, depth is expected in [0, 1] (0 = nearest)
+uint64_t RenderQueue::MakeKey(unsigned int layer, bool translucent, unsigned int shader_id, unsigned int texture_id, float depth)
+{
+	const uint64_t depthMax = (1 << 27) - 1;
+	if (depth < 0.0f) depth = 0.0f;
+	if (depth > 1.0f) depth = 1.0f;
+
+	uint64_t key = (uint64_t)(layer & 0xFF) << 56;
+	uint64_t quantizedDepth = (uint64_t)(depth * depthMax);
+	uint64_t shader = shader_id & 0xFFF;
+	uint64_t texture = texture_id & 0xFFFF;
+
+	if (!translucent)
+		key |= (shader << 43) | (texture << 27) | quantizedDepth;
+	else
+		key |= (1ull << 55) | ((depthMax - quantizedDepth) << 28) | (shader << 16) | texture;
+
+	return key;
+}
+
+
+void RenderQueue::Submit(const DrawPacket& packet)
+{
+	entries.push_back({ packet.key, (unsigned int)packets.size() });
+	packets.push_back(packet);
+}
+
+
+void RenderQueue::Flush()
+{
+	stats = Stats();
+	stats.packetCount = (unsigned int)packets.size();
+
+	auto start = std::chrono::high_resolution_clock::now();
+	RadixSort();
+	auto end = std::chrono::high_resolution_clock::now();
+	stats.sortTime = std::chrono::duration<float, std::milli>(end - start).count();
+
+	//Issuing the draws, only binding what differs from the previous packet
+	const Shader* boundShader = nullptr;
+	const VertexArray* boundVA = nullptr;
+	const IndexBuffer* boundIB = nullptr;
+	const Texture* boundTexture = nullptr;
+
+	for (const SortEntry& entry : entries)
+	{
+		const DrawPacket& packet = packets[entry.index];
+
+		if (packet.shader != boundShader)
+		{
+			packet.shader->Bind();
+			boundShader = packet.shader;
+			stats.stateChanges++;
+		}
+		else
+			stats.stateChangesAvoided++;
+
+		if (packet.va != boundVA)
+		{
+			packet.va->Bind();
+			boundVA = packet.va;
+			boundIB = nullptr;		//The index buffer binding is part of the vertex array's state
+			stats.stateChanges++;
+		}
+		else
+			stats.stateChangesAvoided++;
+
+		if (packet.ib != boundIB)
+		{
+			packet.ib->Bind();
+			boundIB = packet.ib;
+			stats.stateChanges++;
+		}
+		else
+			stats.stateChangesAvoided++;
+
+		if (packet.texture && packet.texture != boundTexture)
+		{
+			packet.texture->Bind();
+			boundTexture = packet.texture;
+			stats.stateChanges++;
+		}
+		else if (packet.texture)
+			stats.stateChangesAvoided++;
+
+		packet.shader->SetUniformMat4f(UNIFORM_ID("u_MVP"), packet.mvp);
+		glErrorCall( glDrawElements(packet.ib->GetPrimitive(), packet.ib->GetCount(), packet.ib->GetType(), nullptr) );
+	}
+
+	packets.clear();
+	entries.clear();
+}
+
+
+//LSD radix sort on the 64 bit keys, one byte per pass. Passes where every key has the same byte are skipped
+void RenderQueue::RadixSort()
+{
+	scratch.resize(entries.size());
+
+	for (unsigned int shift = 0; shift < 64; shift += 8)
+	{
+		unsigned int counts[256] = { 0 };
+		for (const SortEntry& entry : entries)
+			counts[(entry.key >> shift) & 0xFF]++;
+
+		if (counts[(entries.empty() ? 0 : (entries[0].key >> shift) & 0xFF)] == entries.size())
+			continue;
+
+		//Turning the counts into starting offsets
+		unsigned int offset = 0;
+		for (unsigned int i = 0; i < 256; i++)
+		{
+			unsigned int count = counts[i];
+			counts[i] = offset;
+			offset += count;
+		}
+
+		for (const SortEntry& entry : entries)
+			scratch[counts[(entry.key >> shift) & 0xFF]++] = entry;
+
+		entries.swap(scratch);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "Renderer.h"
+#include "Texture.h"
+
+
+//Everything needed to issue one draw later on
+struct DrawPacket
+{
+	uint64_t key;		//Built with RenderQueue::MakeKey(), packets are drawn in ascending key order
+	const VertexArray* va;
+	const IndexBuffer* ib;
+	Shader* shader;
+	const Texture* texture;		//Bound to slot 0, can be null
+	glm::mat4 mvp;		//Uploaded to u_MVP
+};
+
+
+/*
+Collects draw packets over a frame, sorts them by key and then draws them, skipping binds
+of the shader, vertex array, index buffer & texture that are already bound.
+
+Key layout (most significant bit first):
+	opaque		| layer:8 | 0 | shader:12 | texture:16 | depth:27 |		front to back, grouped by state
+	translucent	| layer:8 | 1 | ~depth:27 | shader:12 | texture:16 |	back to front, state only breaks ties
+*/
+class RenderQueue
+{
+public:
+	//Counters of the last Flush()
+	struct Stats
+	{
+		unsigned int packetCount = 0;
+		unsigned int stateChanges = 0;			//Binds actually issued
+		unsigned int stateChangesAvoided = 0;	//Binds skipped because the object was already bound
+		float sortTime = 0.0f;		//ms
+	};
+
+private:
+	//Sorting moves these around instead of the (much larger) packets
+	struct SortEntry
+	{
+		uint64_t key;
+		unsigned int index;
+	};
+
+	std::vector<DrawPacket> packets;
+	std::vector<SortEntry> entries, scratch;
+	Stats stats;
+
+public:
+	static uint64_t MakeKey(unsigned int layer, bool translucent, unsigned int shader_id, unsigned int texture_id, float depth);
+
+	void Submit(const DrawPacket& packet);
+	void Flush();		//Sorts & draws everything submitted since the last flush
+
+	inline const Stats& GetStats() const { return stats; };
+
+private:
+	void RadixSort();
+};
\ No newline at end of file
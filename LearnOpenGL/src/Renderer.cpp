@@ -1,8 +1,14 @@
 #include "Renderer.h"
+#include "GpuHeap.h"
+#include "VertexArrayCache.h"
 
 #include <iostream>
 
 
+bool glPollErrors = GL_ERROR_CHECK == GL_ERROR_CHECK_POLL;
+static GLErrorMode errorMode = (GLErrorMode)GL_ERROR_CHECK;
+
+
 const char* GetGLErrorString(GLenum error)
 {
     switch (error)
@@ -56,6 +62,66 @@ bool glLogCall(const char* function, const char* file, int line)
 }
 
 
+//Switching between the error checking modes at runtime
+void SetGLErrorMode(GLErrorMode mode)
+{
+    bool debugOutput = mode == GLErrorMode::DebugOutputAsync || mode == GLErrorMode::DebugOutputSync;
+    bool debugOutputSupported = GLEW_VERSION_4_3 || GLEW_KHR_debug;
+
+    if (mode == GLErrorMode::Poll && GL_ERROR_CHECK != GL_ERROR_CHECK_POLL)
+    {
+        std::cout << "WARNING::Renderer.cpp::SetGLErrorMode():: Polling isn't compiled into this build (GL_ERROR_CHECK), falling back to none" << std::endl;
+        mode = GLErrorMode::None;
+    }
+    if (debugOutput && !debugOutputSupported)
+    {
+        std::cout << "WARNING::Renderer.cpp::SetGLErrorMode():: Debug output needs GL 4.3 or KHR_debug, falling back to none" << std::endl;
+        mode = GLErrorMode::None;
+        debugOutput = false;
+    }
+
+    if (debugOutputSupported)
+    {
+        if (debugOutput)
+        {
+            glEnable(GL_DEBUG_OUTPUT);
+            if (mode == GLErrorMode::DebugOutputSync)
+                glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+            else
+                glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+
+            glDebugMessageCallback(glDebugOutputCallback, nullptr);
+            glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);   //Skipping the chatter
+        }
+        else
+            glDisable(GL_DEBUG_OUTPUT);
+    }
+
+    glPollErrors = mode == GLErrorMode::Poll;
+    errorMode = mode;
+}
+
+
+GLErrorMode GetGLErrorMode()
+{
+    return errorMode;
+}
+
+
+//Called by the driver for every debug message, inside the failing call when the output is synchronous
+void GLAPIENTRY glDebugOutputCallback(GLenum source, GLenum type, GLuint id, GLenum severity,
+    GLsizei length, const GLchar* message, const void* user_param)
+{
+    std::cout << (type == GL_DEBUG_TYPE_ERROR ? "ERROR" : "WARNING") << "::GL debug output (id " << id << "): " << message << std::endl;
+
+#ifdef _DEBUG
+    //Only in sync mode is the call stack the one of the failing call
+    if (type == GL_DEBUG_TYPE_ERROR && errorMode == GLErrorMode::DebugOutputSync)
+        __debugbreak();
+#endif
+}
+
+
 void Renderer::Clear() const
 {
     glErrorCall(glClear(GL_COLOR_BUFFER_BIT));
@@ -63,12 +129,72 @@ void Renderer::Clear() const
 
 
 void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const
+{
+    Draw(va, ib, shader, ib.GetCount());
+}
+
+
+void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int index_count, int base_vertex) const
 {
     //Binding all buffers & shaders
     shader.Bind();
     va.Bind();
     ib.Bind();
 
-    //Drawing triangle
-    glErrorCall( glDrawElements(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr));
+    //Drawing in the index buffer's primitive & type
+    if (base_vertex == 0)
+    {
+        glErrorCall( glDrawElements(ib.GetPrimitive(), index_count, ib.GetType(), nullptr));
+    }
+    else
+    {
+        glErrorCall( glDrawElementsBaseVertex(ib.GetPrimitive(), index_count, ib.GetType(), nullptr, base_vertex) );
+    }
+}
+
+
+void Renderer::Draw(const VertexArray& va, const StreamingBuffer& indices, const Shader& shader, unsigned int index_count,
+    unsigned int index_offset, int base_vertex) const
+{
+    shader.Bind();
+    va.Bind();
+    indices.Bind();
+    IndexBuffer::DisablePrimitiveRestart();
+
+    glErrorCall( glDrawElementsBaseVertex(GL_TRIANGLES, index_count, GL_UNSIGNED_INT, (void*)(size_t)index_offset, base_vertex) );
+}
+
+
+//No vertex array of its own, the cache has one for the format (or this set of buffers)
+void Renderer::Draw(const VertexBuffer& vb, const VertexBufferLayout& layout, const IndexBuffer& ib, const Shader& shader) const
+{
+    shader.Bind();
+    VertexArrayCache::Get().Bind(vb, layout, ib);
+    ib.Bind();
+
+    glErrorCall( glDrawElements(ib.GetPrimitive(), ib.GetCount(), ib.GetType(), nullptr) );
+}
+
+
+//Meshes of one format share the vertex array & buffers, consecutive draws only bind what changed
+void Renderer::Draw(const GpuHeap& heap, unsigned int mesh, const Shader& shader) const
+{
+    GpuHeap::DrawRange range = heap.GetDrawRange(mesh);
+    shader.Bind();
+    heap.Bind(range.format);
+    IndexBuffer::DisablePrimitiveRestart();
+
+    glErrorCall( glDrawElementsBaseVertex(GL_TRIANGLES, range.indexCount, GL_UNSIGNED_INT,
+        (void*)(size_t)(range.firstIndex * sizeof(unsigned int)), range.baseVertex) );
+}
+
+
+//Drawing instance_count copies of the mesh in one call, per instance data comes from attributes with a divisor
+void Renderer::DrawInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instance_count) const
+{
+    shader.Bind();
+    va.Bind();
+    ib.Bind();
+
+    glErrorCall( glDrawElementsInstanced(ib.GetPrimitive(), ib.GetCount(), ib.GetType(), nullptr, instance_count) );
 }
\ No newline at end of file
@@ -5,24 +5,78 @@
 #include "VertexArray.h"
 #include "IndexBuffer.h"
 #include "Shader.h"
+#include "StreamingBuffer.h"
+
+class GpuHeap;
+class VertexBufferLayout;
 
  
+//  Error Checking Modes   //
+/*
+GL_ERROR_CHECK picks, at compile time, what glErrorCall() turns into:
+    NONE                : just the call, no checking at all
+    DEBUG_OUTPUT_ASYNC  : just the call, the driver reports errors through the KHR_debug callback whenever it gets to them
+    DEBUG_OUTPUT_SYNC   : just the call, the callback runs inside the failing call (so a break point shows the culprit)
+    POLL                : glGetError before & after every call (drains the driver, slowest)
+Debug builds default to POLL, release builds to NONE. SetGLErrorMode() overrides it at runtime,
+but POLL can only be turned on in builds where it was compiled in.
+*/
+#define GL_ERROR_CHECK_NONE                 0
+#define GL_ERROR_CHECK_DEBUG_OUTPUT_ASYNC   1
+#define GL_ERROR_CHECK_DEBUG_OUTPUT_SYNC    2
+#define GL_ERROR_CHECK_POLL                 3
+
+#ifndef GL_ERROR_CHECK
+    #ifdef _DEBUG
+        #define GL_ERROR_CHECK GL_ERROR_CHECK_POLL
+    #else
+        #define GL_ERROR_CHECK GL_ERROR_CHECK_NONE
+    #endif
+#endif
+
+
 //  MACROS  //
 #define ASSERT(x) if(!(x)) __debugbreak();  //Add a break point at the line where error occured
-#define glErrorCall(x) glClearErrors();\
+
+#if GL_ERROR_CHECK == GL_ERROR_CHECK_POLL
+#define glErrorCall(x) if (glPollErrors) glClearErrors();\
     x;\
-    ASSERT(glLogCall(#x, __FILE__, __LINE__))
+    ASSERT(!glPollErrors || glLogCall(#x, __FILE__, __LINE__))
+#else
+#define glErrorCall(x) x
+#endif
 
 
 //  Error Handling  //
+enum class GLErrorMode
+{
+    None = GL_ERROR_CHECK_NONE,
+    DebugOutputAsync = GL_ERROR_CHECK_DEBUG_OUTPUT_ASYNC,
+    DebugOutputSync = GL_ERROR_CHECK_DEBUG_OUTPUT_SYNC,
+    Poll = GL_ERROR_CHECK_POLL
+};
+
+extern bool glPollErrors;   //Checked by glErrorCall() in POLL builds
+
 const char* GetGLErrorString(GLenum error);
 void glClearErrors();
 bool glLogCall(const char* function, const char* file, int line);
 
+void SetGLErrorMode(GLErrorMode mode);   //Needs a current context, debug output also needs GL 4.3 or KHR_debug
+GLErrorMode GetGLErrorMode();
+void GLAPIENTRY glDebugOutputCallback(GLenum source, GLenum type, GLuint id, GLenum severity,
+    GLsizei length, const GLchar* message, const void* user_param);
+
 
 class Renderer
 {
 public:
     void Clear() const;
     void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const;
+    void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int index_count, int base_vertex = 0) const;   //Drawing only the first index_count indices
+    void Draw(const VertexArray& va, const StreamingBuffer& indices, const Shader& shader, unsigned int index_count,
+        unsigned int index_offset, int base_vertex = 0) const;    //Indices (unsigned int) streamed this frame, index_offset in bytes
+    void Draw(const GpuHeap& heap, unsigned int mesh, const Shader& shader) const;   //A mesh sub-allocated from a GpuHeap
+    void Draw(const VertexBuffer& vb, const VertexBufferLayout& layout, const IndexBuffer& ib, const Shader& shader) const;   //Vertex array from the VertexArrayCache
+    void DrawInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instance_count) const;
 };
\ No newline at end of file
@@ -0,0 +1,194 @@
+#include "ResourceCache.h"
+#include "AsyncTextureLoader.h"
+#include "ProgramBinaryCache.h"
+#include "Renderer.h"
+
+#include "imgui/imgui.h"
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+
+ResourceCache* ResourceCache::instance = nullptr;
+
+
+//Constructor
+ResourceCache::ResourceCache(unsigned int budget_bytes)
+	: budget(budget_bytes), frame(0)
+{
+	instance = this;
+}
+
+//Destructor
+ResourceCache::~ResourceCache()
+{
+	if (instance == this)
+		instance = nullptr;
+}
+
+
+ResourceCache& ResourceCache::Get()
+{
+	ASSERT(instance);
+	return *instance;
+}
+
+
+std::shared_ptr<Texture> ResourceCache::GetTexture(const std::string& file_path, const TextureParams& params)
+{
+	//The same file with other mipmaps or sampling is another texture
+	std::stringstream ss;
+	ss << "texture:" << file_path;
+	if (params.GetKey() != TextureParams().GetKey())
+		ss << '#' << std::hex << params.GetKey();
+	std::string key = ss.str();
+	auto it = entries.find(key);
+	if (it != entries.end())
+	{
+		stats.hits++;
+		it->second.lastUsed = frame;
+		return std::static_pointer_cast<Texture>(it->second.resource);
+	}
+
+	stats.misses++;
+
+	//Decoded in the background when there is a loader, the placeholder is usable right away
+	std::shared_ptr<Texture> texture = AsyncTextureLoader::TryGet() ?
+		AsyncTextureLoader::Get().Load(file_path, params) : std::make_shared<Texture>(file_path, params);
+
+	const Texture* raw = texture.get();
+	entries[key] = { "Texture", texture, [raw]() { return raw->GetSize(); }, frame };
+	return texture;
+}
+
+
+std::shared_ptr<Shader> ResourceCache::GetShader(const std::string& file_path, const ShaderDefines& defines)
+{
+	std::stringstream ss;
+	ss << "shader:" << file_path;
+	if (!defines.IsEmpty())
+		ss << '#' << std::hex << defines.GetKey();
+	std::string key = ss.str();
+
+	auto it = entries.find(key);
+	if (it != entries.end())
+	{
+		stats.hits++;
+		it->second.lastUsed = frame;
+		return std::static_pointer_cast<Shader>(it->second.resource);
+	}
+
+	stats.misses++;
+	std::shared_ptr<Shader> shader = std::make_shared<Shader>(file_path, defines);
+
+	const Shader* raw = shader.get();
+	entries[key] = { "Shader", shader, [raw]() { return GetShaderSize(*raw); }, frame };
+	return shader;
+}
+
+
+void ResourceCache::Update()
+{
+	frame++;
+	for (auto& entry : entries)
+	{
+		if (IsReferenced(entry.second))
+			entry.second.lastUsed = frame;
+	}
+
+	Evict(budget);
+}
+
+
+void ResourceCache::Clear()
+{
+	Evict(0);
+}
+
+
+//Resident resources, their size & who still holds them
+void ResourceCache::OnImGuiRender()
+{
+	unsigned int totalSize = 0;
+	for (const auto& entry : entries)
+		totalSize += entry.second.getSize();
+
+	ImGui::Text("%u resources, %.2f MB resident (%.2f MB unreferenced, budget %.0f MB)", (unsigned int)entries.size(),
+		totalSize / (1024.0f * 1024.0f), GetUnreferencedSize() / (1024.0f * 1024.0f), budget / (1024.0f * 1024.0f));
+	ImGui::Text("%u hits, %u misses, %u evictions", stats.hits, stats.misses, stats.evictions);
+
+	int budgetMB = budget / (1024 * 1024);
+	if (ImGui::SliderInt("Budget (MB)", &budgetMB, 0, 1024))
+		budget = budgetMB * 1024 * 1024;
+	if (ImGui::Button("Drop unreferenced"))
+		Clear();
+
+	//Sorted by key, the map's order jumps around
+	std::vector<const std::pair<const std::string, Entry>*> sorted;
+	for (const auto& entry : entries)
+		sorted.push_back(&entry);
+	std::sort(sorted.begin(), sorted.end(), [](const std::pair<const std::string, Entry>* a, const std::pair<const std::string, Entry>* b) { return a->first < b->first; });
+
+	ImGui::Separator();
+	ImGui::Columns(4, "resources");
+	ImGui::Text("Resource");		ImGui::NextColumn();
+	ImGui::Text("Type");			ImGui::NextColumn();
+	ImGui::Text("References");		ImGui::NextColumn();
+	ImGui::Text("Size (KB)");		ImGui::NextColumn();
+	ImGui::Separator();
+
+	for (const auto* entry : sorted)
+	{
+		ImGui::Text("%s", entry->first.c_str() + entry->first.find(':') + 1);	ImGui::NextColumn();
+		ImGui::Text("%s", entry->second.type);									ImGui::NextColumn();
+		ImGui::Text("%ld", entry->second.resource.use_count() - 1);				ImGui::NextColumn();
+		ImGui::Text("%.1f", entry->second.getSize() / 1024.0f);				ImGui::NextColumn();
+	}
+	ImGui::Columns(1);
+}
+
+
+//Dropping unreferenced resources, least recently used first, until they fit in budget_bytes
+void ResourceCache::Evict(unsigned int budget_bytes)
+{
+	unsigned int unreferencedSize = GetUnreferencedSize();
+	while (unreferencedSize > budget_bytes)
+	{
+		auto oldest = entries.end();
+		for (auto it = entries.begin(); it != entries.end(); it++)
+		{
+			if (!IsReferenced(it->second) && (oldest == entries.end() || it->second.lastUsed < oldest->second.lastUsed))
+				oldest = it;
+		}
+
+		if (oldest == entries.end())
+			break;
+
+		unreferencedSize -= std::min(unreferencedSize, oldest->second.getSize());
+		entries.erase(oldest);
+		stats.evictions++;
+	}
+}
+
+
+unsigned int ResourceCache::GetUnreferencedSize() const
+{
+	unsigned int size = 0;
+	for (const auto& entry : entries)
+	{
+		if (!IsReferenced(entry.second))
+			size += entry.second.getSize();
+	}
+	return size;
+}
+
+
+//Programs have no size to ask for, the length of their binary is the closest there is
+unsigned int ResourceCache::GetShaderSize(const Shader& shader)
+{
+	int length = 0;
+	if (shader.GetRendererID() && ProgramBinaryCache::Get().IsSupported())
+		glErrorCall( glGetProgramiv(shader.GetRendererID(), GL_PROGRAM_BINARY_LENGTH, &length) );
+	return (unsigned int)length;
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "Texture.h"
+#include "Shader.h"
+
+
+/*
+Shared owner of textures & shaders, keyed by path plus whatever changes the result of loading it (e.g. shader defines).
+Asking twice for the same key hands out the same object, the handles are reference counted (std::shared_ptr).
+Once nobody holds a resource it stays resident, so loading it again is free, until the unreferenced ones
+outgrow the memory budget & the least recently used of them are dropped.
+The application creates one of these after the context, Get() hands it out to the rest of the code.
+*/
+class ResourceCache
+{
+public:
+	//Counters for the lifetime of the cache
+	struct Stats
+	{
+		unsigned int hits = 0;
+		unsigned int misses = 0;
+		unsigned int evictions = 0;
+	};
+
+private:
+	struct Entry
+	{
+		const char* type;		//"Texture" or "Shader", for the panel
+		std::shared_ptr<void> resource;		//The cache's own reference
+		std::function<unsigned int()> getSize;		//Bytes of GPU memory, can change (e.g. once a texture has loaded)
+		unsigned long long lastUsed;		//Frame of the latest request or reference
+	};
+
+	static ResourceCache* instance;
+
+	std::unordered_map<std::string, Entry> entries;
+	unsigned int budget;		//Bytes of unreferenced resources that may stay resident
+	unsigned long long frame;
+
+	Stats stats;
+
+public:
+	//Constructor & Destructor
+	ResourceCache(unsigned int budget_bytes = 256 * 1024 * 1024);
+	~ResourceCache();
+
+	static ResourceCache& Get();
+
+	std::shared_ptr<Texture> GetTexture(const std::string& file_path, const TextureParams& params = TextureParams());
+	std::shared_ptr<Shader> GetShader(const std::string& file_path, const ShaderDefines& defines = ShaderDefines());
+
+	//Once per frame: refreshes what's in use & evicts over the budget
+	void Update();
+	void Clear();		//Drops every unreferenced resource
+
+	void OnImGuiRender();
+
+	inline void SetBudget(unsigned int budget_bytes) { budget = budget_bytes; };
+	inline unsigned int GetBudget() const { return budget; };
+	inline unsigned int GetCount() const { return (unsigned int)entries.size(); };
+	inline const Stats& GetStats() const { return stats; };
+
+private:
+	//Held by someone other than the cache
+	static bool IsReferenced(const Entry& entry) { return entry.resource.use_count() > 1; };
+
+	void Evict(unsigned int budget_bytes);
+	unsigned int GetUnreferencedSize() const;
+	static unsigned int GetShaderSize(const Shader& shader);
+};
\ No newline at end of file
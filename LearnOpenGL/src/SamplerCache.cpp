@@ -0,0 +1,85 @@
+#include "SamplerCache.h"
+#include "Renderer.h"
+#include "GLStateCache.h"
+
+#include <algorithm>
+
+
+//Anisotropy in quarter steps is plenty, the driver rounds it anyway
+uint32_t SamplerState::GetKey() const
+{
+	return (uint32_t)filter | ((uint32_t)wrap << 2) | ((uint32_t)(anisotropy * 4.0f + 0.5f) << 4);
+}
+
+
+SamplerCache* SamplerCache::instance = nullptr;
+
+
+//Constructor
+SamplerCache::SamplerCache()
+	: maxAnisotropy(1.0f)
+{
+	if (GLEW_EXT_texture_filter_anisotropic || GLEW_ARB_texture_filter_anisotropic)
+	{
+		glErrorCall( glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAnisotropy) );
+	}
+
+	instance = this;
+}
+
+//Destructor
+SamplerCache::~SamplerCache()
+{
+	for (const auto& sampler : samplers)
+	{
+		GLStateCache::Get().OnDeleteSampler(sampler.second);
+		glErrorCall( glDeleteSamplers(1, &sampler.second) );
+	}
+
+	if (instance == this)
+		instance = nullptr;
+}
+
+
+SamplerCache& SamplerCache::Get()
+{
+	ASSERT(instance);
+	return *instance;
+}
+
+
+unsigned int SamplerCache::GetSampler(const SamplerState& state)
+{
+	SamplerState clamped = Clamp(state);
+	uint32_t key = clamped.GetKey();
+
+	auto it = samplers.find(key);
+	if (it != samplers.end())
+		return it->second;
+
+	const unsigned int minFilters[] = { GL_NEAREST_MIPMAP_NEAREST, GL_LINEAR_MIPMAP_NEAREST, GL_LINEAR_MIPMAP_LINEAR };
+	const unsigned int wraps[] = { GL_CLAMP_TO_EDGE, GL_REPEAT, GL_MIRRORED_REPEAT };
+
+	unsigned int id = 0;
+	glErrorCall( glGenSamplers(1, &id) );
+	glErrorCall( glSamplerParameteri(id, GL_TEXTURE_MIN_FILTER, minFilters[(int)clamped.filter]) );
+	glErrorCall( glSamplerParameteri(id, GL_TEXTURE_MAG_FILTER, clamped.filter == TextureFilter::Nearest ? GL_NEAREST : GL_LINEAR) );
+	glErrorCall( glSamplerParameteri(id, GL_TEXTURE_WRAP_S, wraps[(int)clamped.wrap]) );
+	glErrorCall( glSamplerParameteri(id, GL_TEXTURE_WRAP_T, wraps[(int)clamped.wrap]) );
+	if (maxAnisotropy > 1.0f)
+	{
+		glErrorCall( glSamplerParameterf(id, GL_TEXTURE_MAX_ANISOTROPY_EXT, clamped.anisotropy) );
+	}
+
+	samplers[key] = id;
+	return id;
+}
+
+
+//States that end up the same on this driver share a sampler
+SamplerState SamplerCache::Clamp(const SamplerState& state) const
+{
+	SamplerState clamped = state;
+	clamped.anisotropy = std::min(std::max(state.anisotropy, 1.0f), maxAnisotropy);
+	return clamped;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+
+enum class TextureFilter
+{
+	Nearest,
+	Bilinear,		//Linear within the nearest mip level
+	Trilinear		//Linear within & between the 2 nearest mip levels
+};
+
+enum class TextureWrap
+{
+	ClampToEdge,
+	Repeat,
+	MirroredRepeat
+};
+
+
+//How a texture is sampled, textures with the same state share one GL sampler object
+struct SamplerState
+{
+	TextureFilter filter = TextureFilter::Trilinear;		//Same as bilinear on textures without mip levels
+	TextureWrap wrap = TextureWrap::ClampToEdge;
+	float anisotropy = 1.0f;		//Max samples along the footprint, 1 = off, clamped to what the driver allows
+
+	uint32_t GetKey() const;
+};
+
+
+/*
+Owner of the GL sampler objects, one per distinct SamplerState.
+Textures bind the sampler of their state next to themselves, so filtering & wrapping never go through glTexParameteri.
+The application creates one of these after the context, Get() hands it out to the rest of the code.
+*/
+class SamplerCache
+{
+private:
+	static SamplerCache* instance;
+
+	std::unordered_map<uint32_t, unsigned int> samplers;		//Key of the state -> sampler object
+	float maxAnisotropy;		//1 without anisotropic filtering
+
+public:
+	//Constructor & Destructor
+	SamplerCache();
+	~SamplerCache();
+
+	static SamplerCache& Get();
+
+	//Created on first use
+	unsigned int GetSampler(const SamplerState& state);
+
+	inline float GetMaxAnisotropy() const { return maxAnisotropy; };
+	inline unsigned int GetCount() const { return (unsigned int)samplers.size(); };
+
+private:
+	SamplerState Clamp(const SamplerState& state) const;
+};
@@ -1,85 +1,307 @@
 #include "Shader.h"
 #include "Renderer.h"
+#include "GLStateCache.h"
+#include "UniformBuffer.h"
+#include "ProgramBinaryCache.h"
+#include "ShaderHotReloader.h"
+#include "Hash.h"
 
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <sstream>
+#include <cstring>
+#include <chrono>
 
 
-//Constructor
-Shader::Shader(const std::string& file_path)
-	: filepath(file_path), rendererID(0)
+//Constructors
+Shader::Shader(const std::string& file_path, const ShaderDefines& defines)
+	: Shader(ShaderPreprocessor::Process(file_path, defines), file_path, defines, false)
 {
-    ShaderProgramSource sourceShader = ParseShader(file_path);
-    rendererID = CreateShader(sourceShader.vertexSource, sourceShader.fragmentSource);
+}
+
+//Deferred builds are only submitted, the ShaderLibrary finishes them once the driver is done
+Shader::Shader(const PreprocessedShader& source, const std::string& file_path, const ShaderDefines& defines, bool deferred)
+	: filepath(file_path), defines(defines), rendererID(0), ready(false), stages(), stageHashes()
+{
+    StartBuild(source);
+    if (!deferred)
+        FinishBuild();
+
+#if SHADER_HOT_RELOAD
+    ShaderHotReloader::Get().Add(this);
+#endif
 }
 
 //Destructor
 Shader::~Shader()
 {
+#if SHADER_HOT_RELOAD
+    ShaderHotReloader::Get().Remove(this);
+#endif
+
+    //A build that was never finished
+    DiscardPendingBuild();
+
+    for (unsigned int stage : stages)
+    {
+        if (stage)
+            glErrorCall( glDeleteShader(stage) );
+    }
+
+    GLStateCache::Get().OnDeleteProgram(rendererID);
     glErrorCall( glDeleteProgram(rendererID) );
 }
 
 
+//  Building   //
+/*
+Handing the sources to the driver without waiting for any result, a cached binary makes the build complete right away.
+The current program (if any) stays in use until FinishBuild() swaps the new one in.
+*/
+void Shader::StartBuild(const PreprocessedShader& source)
+{
+    DiscardPendingBuild();
+    pending.active = true;
+    pending.start = std::chrono::high_resolution_clock::now();
+
+    //Kept even if preprocessing failed, so that fixing the file triggers a reload
+    sourceFiles = source.files;
+    if (!source.valid)
+        return;
+
+    const ShaderProgramSource& sourceShader = source.source;
+
+    //Trying the linked binary of an earlier run before compiling anything, every variant has its own entry
+    ProgramBinaryCache& binaryCache = ProgramBinaryCache::Get();
+    pending.binaryKey = binaryCache.MakeKey(sourceShader.vertexSource, sourceShader.fragmentSource, "");
+    pending.program = binaryCache.LoadProgram(GetBinaryName(), pending.binaryKey);
+
+    pending.warm = pending.program != 0;
+    if (!pending.warm)
+        pending.program = CreateShader(sourceShader.vertexSource, sourceShader.fragmentSource);
+}
+
+
+//Asks the driver without blocking, only possible with GL_KHR_parallel_shader_compile (or the ARB version)
+bool Shader::IsBuildComplete() const
+{
+    if (!pending.active || pending.warm || pending.program == 0 || !IsParallelCompileSupported())
+        return true;
+
+    int complete = GL_TRUE;
+    glErrorCall( glGetProgramiv(pending.program, GL_COMPLETION_STATUS_KHR, &complete) );
+    return complete == GL_TRUE;
+}
+
+
+/*
+Checking the results (blocks if the driver isn't done yet) & swapping the new program in.
+A failed rebuild keeps the previous program, so a typo while hot reloading doesn't take the shader down.
+Returns false if the build failed.
+*/
+bool Shader::FinishBuild()
+{
+    if (!pending.active)
+        return true;
+    pending.active = false;
+
+    ProgramBinaryCache& binaryCache = ProgramBinaryCache::Get();
+    unsigned int program = pending.program;
+    if (!pending.warm && program != 0)
+    {
+        program = CheckProgram(program);
+        binaryCache.StoreProgram(GetBinaryName(), pending.binaryKey, program);
+    }
+    pending.program = 0;
+
+    if (program == 0 && ready)
+    {
+        std::cout << "WARNING::Shader.cpp::FinishBuild():: '" << filepath << "' failed to rebuild, keeping the previous program" << std::endl;
+        return false;
+    }
+
+    //Deleting a program that is in use is deferred by GL until it isn't
+    if (rendererID != 0)
+    {
+        GLStateCache::Get().OnDeleteProgram(rendererID);
+        glErrorCall( glDeleteProgram(rendererID) );
+    }
+    rendererID = program;
+
+    //Keeping the compiled stages, a later rebuild reuses the ones whose source didn't change
+    for (unsigned int i = 0; i < stageCount; i++)
+    {
+        if (stages[i] && stages[i] != pending.stages[i])
+            glErrorCall( glDeleteShader(stages[i]) );
+
+        stages[i] = pending.stages[i];
+        stageHashes[i] = pending.stageHashes[i];
+        pending.stages[i] = 0;
+    }
+
+    BindUniformBlocks();
+    ReflectUniforms();
+    RestoreUniformValues();
+    ready = true;
+
+    auto end = std::chrono::high_resolution_clock::now();
+    binaryCache.RecordSetup(pending.warm, std::chrono::duration<float, std::milli>(end - pending.start).count());
+    return program != 0;
+}
+
+
+//Deleting whatever an unfinished build created, without touching what the current program uses
+void Shader::DiscardPendingBuild()
+{
+    if (pending.program)
+        glErrorCall( glDeleteProgram(pending.program) );
+
+    for (unsigned int i = 0; i < stageCount; i++)
+    {
+        if (pending.stages[i] && pending.stages[i] != stages[i])
+            glErrorCall( glDeleteShader(pending.stages[i]) );
+    }
+
+    pending = PendingBuild();
+}
+
+
+//Rebuilding from the files on disk, returns false (& keeps the current program) if that fails
+bool Shader::Reload()
+{
+    StartBuild(ShaderPreprocessor::Process(filepath, defines));
+    return FinishBuild();
+}
+
+
+//Name of the variant's entry in the program binary cache
+std::string Shader::GetBinaryName() const
+{
+    if (defines.IsEmpty())
+        return filepath;
+
+    std::stringstream ss;
+    ss << filepath << '_' << std::hex << defines.GetKey();
+    return ss.str();
+}
+
+
+bool Shader::IsParallelCompileSupported()
+{
+    return GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+}
+
+
 void Shader::Bind() const
 {
-    glErrorCall( glUseProgram(rendererID) );
+    GLStateCache::Get().UseProgram(rendererID);
 }
 
 
 void Shader::Unbind() const
 {
-    glErrorCall( glUseProgram(0) );
+    GLStateCache::Get().UseProgram(0);
+}
+
+
+//  Uniform Handles  //
+UniformHandle Shader::GetUniformHandle(UniformID id)
+{
+    UniformHandle handle;
+    handle.index = FindUniform(id);
+    if (handle.index < 0)
+    {
+        if (ready)
+            std::cout << "WARNING::Shader.cpp: Uniform with id " << id << " doesn't exist in '" << filepath << "'" << std::endl;
+        handle.index = AddMissingUniform(id, "");
+    }
+
+    return handle;
+}
+
+
+UniformHandle Shader::GetUniformHandle(const std::string& name)
+{
+    UniformID id = HashUniformName(name.c_str());
+
+    UniformHandle handle;
+    handle.index = FindUniform(id);
+    if (handle.index < 0)
+    {
+        if (ready)
+            std::cout << "WARNING::Shader.cpp: Uniform '" << name << "' doesn't exist" << std::endl;
+        handle.index = AddMissingUniform(id, name);
+    }
+
+    return handle;
 }
 
 
 //Setting the uniform's value (in 1 int) in shader source code
-void Shader::SetUniform1i(const std::string& name, int value)
+void Shader::SetUniform1i(UniformHandle handle, int value)
 {
-    glErrorCall( glUniform1i(GetUniformLocation(name), value) );
+    UniformInfo* uniform = GetUniform(handle);
+    if (!uniform || uniform->location == -1 || !UpdateShadowValue(*uniform, &value, sizeof(value)))
+        return;
+
+    glErrorCall( glUniform1i(uniform->location, value) );
+}
+
+//Setting the uniform's values (in an int array) in shader source code
+void Shader::SetUniform1iv(UniformHandle handle, int count, const int* values)
+{
+    UniformInfo* uniform = GetUniform(handle);
+    if (!uniform || uniform->location == -1 || !UpdateShadowValue(*uniform, values, count * sizeof(int)))
+        return;
+
+    glErrorCall( glUniform1iv(uniform->location, count, values) );
 }
 
 //Setting the uniform's value (in 1 matrix) in shader source code
-void Shader::SetUniformMat4f(const std::string& name, const glm::mat4 matrix)
+void Shader::SetUniformMat4f(UniformHandle handle, const glm::mat4& matrix)
 {
-    glErrorCall( glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &matrix[0][0]) );
+    UniformInfo* uniform = GetUniform(handle);
+    if (!uniform || uniform->location == -1 || !UpdateShadowValue(*uniform, &matrix[0][0], sizeof(matrix)))
+        return;
 
+    glErrorCall( glUniformMatrix4fv(uniform->location, 1, GL_FALSE, &matrix[0][0]) );
 }
 
 
-//Dividing the source code in shaders so that they can easily be read separately
-ShaderProgramSource Shader::ParseShader(const std::string& file_path)
+void Shader::SetUniform1i(UniformID id, int value)
 {
-    std::ifstream stream(file_path);
+    SetUniform1i(GetUniformHandle(id), value);
+}
 
-    enum class ShaderType {
-        NONE = -1, VERTEX = 0, FRAGMENT = 1
-    };
+void Shader::SetUniform1iv(UniformID id, int count, const int* values)
+{
+    SetUniform1iv(GetUniformHandle(id), count, values);
+}
 
-    std::string line;
-    std::stringstream ss[2];
-    ShaderType type = ShaderType::NONE;
+void Shader::SetUniformMat4f(UniformID id, const glm::mat4& matrix)
+{
+    SetUniformMat4f(GetUniformHandle(id), matrix);
+}
 
-    //Reading the shader source file and using keywords to split it
-    while (getline(stream, line))
-    {
-        if (line.find("#shader") != std::string::npos)
-        {
-            if (line.find("vertex") != std::string::npos)
-                type = ShaderType::VERTEX;
-            else if (line.find("fragment") != std::string::npos)
-                type = ShaderType::FRAGMENT;
-        }
-        else
-            ss[(int)type] << line << '\n';
-    }
 
-    return { ss[0].str(), ss[1].str() };
+void Shader::SetUniform1i(const std::string& name, int value)
+{
+    SetUniform1i(GetUniformHandle(name), value);
+}
+
+void Shader::SetUniform1iv(const std::string& name, int count, const int* values)
+{
+    SetUniform1iv(GetUniformHandle(name), count, values);
+}
+
+void Shader::SetUniformMat4f(const std::string& name, const glm::mat4& matrix)
+{
+    SetUniformMat4f(GetUniformHandle(name), matrix);
 }
 
 
-//Compiling shader source code
+//Submitting shader source code, the result is only checked in CheckShader()
 unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
 {
     unsigned int id = glCreateShader(type);
@@ -87,7 +309,13 @@ unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
     glShaderSource(id, 1, &src, nullptr);
     glCompileShader(id);
 
-    //Error Handling
+    return id;
+}
+
+
+//Error Handling of one stage, querying the status waits for the compile to finish
+bool Shader::CheckShader(unsigned int id, unsigned int type)
+{
     int result;
     glGetShaderiv(id, GL_COMPILE_STATUS, &result);
     if (result == GL_FALSE)
@@ -95,49 +323,234 @@ unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
         int len;
         glGetShaderiv(id, GL_INFO_LOG_LENGTH, &len);
 
-        std::unique_ptr<char[]> message = std::make_unique<char[]>(len);
+        std::unique_ptr<char[]> message = std::make_unique<char[]>(len > 0 ? len : 1);
         //char* message = (char*)alloca(len * sizeof(char));        //Alternate line for message pointer (normal pointer instead of smart)
+        message[0] = '\0';
 
         glGetShaderInfoLog(id, len, &len, message.get());
         std::cout << "ERROR::Application.cpp::CompileShader():: Failed to compile " << (type == GL_VERTEX_SHADER ? "vertex" : "fragment") << " shader" << std::endl;
         std::cout << message.get() << std::endl;
-        glDeleteShader(id);
-        return 0;
+        return false;
     }
 
-    return id;
+    return true;
 }
 
 
-//Creating the shader in a program after compiling the source code
+/*
+Creating the shader in a program after submitting the source code.
+Nothing here waits for the driver: the stages are linked straight away & only checked in CheckProgram(),
+which lets drivers with parallel compilation work on several programs at once.
+A stage whose source is the same as in the current program isn't compiled again.
+*/
 unsigned int Shader::CreateShader(const std::string& vertex_shader, const std::string& fragment_shader)
 {
+    const std::string* sources[stageCount] = { &vertex_shader, &fragment_shader };
+    const unsigned int types[stageCount] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER };
+
     unsigned int program = glCreateProgram();
-    unsigned int vs = CompileShader(GL_VERTEX_SHADER, vertex_shader);
-    unsigned int fs = CompileShader(GL_FRAGMENT_SHADER, fragment_shader);
+    for (unsigned int i = 0; i < stageCount; i++)
+    {
+        pending.stageHashes[i] = HashString(*sources[i]);
+        if (stages[i] && stageHashes[i] == pending.stageHashes[i])
+            pending.stages[i] = stages[i];
+        else
+            pending.stages[i] = CompileShader(types[i], *sources[i]);
+
+        glAttachShader(program, pending.stages[i]);
+    }
+
+    //Has to be set before linking for glGetProgramBinary to return anything
+    if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
-    glAttachShader(program, vs);
-    glAttachShader(program, fs);
     glLinkProgram(program);
-    glValidateProgram(program);
+    return program;
+}
+
+
+//Returns the program if it linked, 0 otherwise (a broken program must not end up in the binary cache)
+unsigned int Shader::CheckProgram(unsigned int program)
+{
+    int linked;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked == GL_FALSE)
+    {
+        //The stage logs say more than the link log when a stage didn't compile
+        bool stagesCompiled = CheckShader(pending.stages[0], GL_VERTEX_SHADER);
+        stagesCompiled = CheckShader(pending.stages[1], GL_FRAGMENT_SHADER) && stagesCompiled;
+
+        if (stagesCompiled)
+        {
+            int len;
+            glGetProgramiv(program, GL_INFO_LOG_LENGTH, &len);
+
+            std::unique_ptr<char[]> message = std::make_unique<char[]>(len > 0 ? len : 1);
+            message[0] = '\0';
+            glGetProgramInfoLog(program, len, &len, message.get());
+            std::cout << "ERROR::Shader.cpp::CreateShader():: Failed to link '" << filepath << "'" << std::endl;
+            std::cout << message.get() << std::endl;
+        }
 
-    glDeleteShader(vs);
-    glDeleteShader(fs);
+        //Stages compiled for this build are thrown away, the ones shared with the current program stay
+        for (unsigned int i = 0; i < stageCount; i++)
+        {
+            if (pending.stages[i] != stages[i])
+                glDeleteShader(pending.stages[i]);
+            pending.stages[i] = 0;
+        }
+
+        glDeleteProgram(program);
+        program = 0;
+    }
 
     return program;
 }
 
 
-//Getting the uniform's location from shader source code
-int Shader::GetUniformLocation(const std::string& name)
+//Connecting the shared uniform blocks to their fixed binding points, a program loaded from a binary needs this as well
+void Shader::BindUniformBlocks()
+{
+    if (rendererID == 0)
+        return;
+
+    for (unsigned int i = 0; i < (unsigned int)UniformBlock::Count; i++)
+    {
+        unsigned int blockIndex = glGetUniformBlockIndex(rendererID, GetUniformBlockName((UniformBlock)i));
+        if (blockIndex != GL_INVALID_INDEX)
+            glUniformBlockBinding(rendererID, blockIndex, i);
+    }
+}
+
+
+//Filling the uniform table with every active uniform of the linked program
+void Shader::ReflectUniforms()
 {
-    if (uLocationCache.find(name) != uLocationCache.end())
-        return uLocationCache[name];
+    if (rendererID == 0)
+        return;
+
+    //A rebuilt program may have lost some uniforms, their entries (& handles) stay but point nowhere
+    for (UniformInfo& uniform : uniforms)
+        uniform.location = -1;
+
+    int count = 0, maxLength = 0;
+    glErrorCall( glGetProgramiv(rendererID, GL_ACTIVE_UNIFORMS, &count) );
+    glErrorCall( glGetProgramiv(rendererID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength) );
+
+    std::vector<char> nameBuffer(maxLength > 0 ? maxLength : 1);
+    for (int i = 0; i < count; i++)
+    {
+        int length = 0, size = 0;
+        unsigned int type = 0;
+        glErrorCall( glGetActiveUniform(rendererID, i, maxLength, &length, &size, &type, nameBuffer.data()) );
+
+        //Arrays are reported as "name[0]"
+        std::string name(nameBuffer.data(), length);
+        size_t bracket = name.find('[');
+        if (bracket != std::string::npos)
+            name.erase(bracket);
+
+        //Members of uniform blocks have no location, they are set through the block's buffer
+        glErrorCall( int location = glGetUniformLocation(rendererID, name.c_str()) );
+        if (location == -1)
+            continue;
+
+        //Entries asked for before the program was ready are filled in, so their handles become valid
+        UniformID id = HashUniformName(name.c_str());
+        int index = FindUniform(id);
+        if (index < 0)
+            index = AddMissingUniform(id, name);
+
+        UniformInfo& uniform = uniforms[index];
+        if (uniform.type != type)
+            uniform.valueSize = 0;      //The old value means nothing to a uniform that changed its type
+
+        uniform.name = name;
+        uniform.location = location;
+        uniform.type = type;
+        uniform.count = size;
+    }
+}
+
+
+//A new program starts with default values, so the values of the previous one are sent again
+void Shader::RestoreUniformValues()
+{
+    bool bound = false;
+    for (const UniformInfo& uniform : uniforms)
+    {
+        if (uniform.location == -1 || uniform.valueSize == 0)
+            continue;
+
+        if (!bound)
+        {
+            Bind();
+            bound = true;
+        }
+
+        if (uniform.type == GL_FLOAT_MAT4)
+        {
+            glErrorCall( glUniformMatrix4fv(uniform.location, uniform.valueSize / sizeof(glm::mat4), GL_FALSE, (const float*)uniform.value) );
+        }
+        else
+        {
+            //Ints & samplers, the only other kinds that can be set
+            glErrorCall( glUniform1iv(uniform.location, uniform.valueSize / sizeof(int), (const int*)uniform.value) );
+        }
+    }
+}
+
+
+//Index of the uniform in the table, -1 if it isn't there (a linear scan over a handful of ints)
+int Shader::FindUniform(UniformID id) const
+{
+    for (unsigned int i = 0; i < uniforms.size(); i++)
+    {
+        if (uniforms[i].id == id)
+            return i;
+    }
+
+    return -1;
+}
+
+
+//Remembering a miss as a dead entry, so that the warning shows up once instead of on every call
+int Shader::AddMissingUniform(UniformID id, const std::string& name)
+{
+    UniformInfo missing = {};
+    missing.id = id;
+    missing.name = name;
+    missing.location = -1;
+    uniforms.push_back(missing);
+
+    return (int)uniforms.size() - 1;
+}
+
+
+//nullptr for handles that were never resolved or that belong to a shader with more uniforms
+Shader::UniformInfo* Shader::GetUniform(UniformHandle handle)
+{
+    if (handle.index < 0 || handle.index >= (int)uniforms.size())
+        return nullptr;
+
+    return &uniforms[handle.index];
+}
+
+
+//Storing the value, returns false if it's the same as what was sent last time
+bool Shader::UpdateShadowValue(UniformInfo& uniform, const void* data, unsigned int size)
+{
+    //Too big to shadow: always sent, & whatever was shadowed before is dropped so it can't match (or be restored) later
+    if (size > sizeof(uniform.value))
+    {
+        uniform.valueSize = 0;
+        return true;
+    }
+
+    if (uniform.valueSize == size && std::memcmp(uniform.value, data, size) == 0)
+        return false;
 
-    glErrorCall(int location = glGetUniformLocation(rendererID, name.c_str()));
-    if (location == -1)
-        std::cout << "WARNGING::Shader.cpp: Unfirom '" << name << "' doesn't exist" << std::endl;
-    
-    uLocationCache[name] = location;
-    return location;
+    std::memcpy(uniform.value, data, size);
+    uniform.valueSize = size;
+    return true;
 }
\ No newline at end of file
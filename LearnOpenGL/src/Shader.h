@@ -3,43 +3,149 @@
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 
+#include <chrono>
+#include <cstdint>
 #include <string>
-#include <unordered_map>
+#include <type_traits>
+#include <vector>
 
+#include "ShaderPreprocessor.h"
 
-//Struct to handle source code for shaders
-struct ShaderProgramSource
+
+//  Uniform IDs & Handles  //
+typedef uint32_t UniformID;
+
+//FNV-1a hash of a uniform's name, array uniforms go by their plain name ("u_Textures", not "u_Textures[0]")
+constexpr UniformID HashUniformName(const char* name)
+{
+	UniformID hash = 2166136261u;
+	while (*name)
+	{
+		hash ^= (unsigned char)*name++;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+//Forces the hash to be computed by the compiler
+#define UNIFORM_ID(name) (std::integral_constant<UniformID, HashUniformName(name)>::value)
+
+//Pre-resolved slot in a shader's uniform table, only valid for the shader that handed it out
+struct UniformHandle
 {
-	std::string vertexSource;
-	std::string fragmentSource;
+	int index = -1;
+
+	inline bool IsValid() const { return index >= 0; };
 };
 
 
 class Shader
 {
+	friend class ShaderVariantCache;
+	friend class ShaderLibrary;
+	friend class ShaderHotReloader;
+
 private:
+	//Every active uniform of the program, filled in right after linking
+	struct UniformInfo
+	{
+		UniformID id;
+		std::string name;
+		int location;			//-1 for names that were asked for but don't exist
+		unsigned int type;		//GL_FLOAT_MAT4, GL_SAMPLER_2D, ...
+		int count;				//Array size, 1 for plain uniforms
+
+		//Last value sent, so that re-sending the same value is skipped
+		unsigned char value[64];
+		unsigned int valueSize;		//0 = nothing sent yet
+	};
+
+	static const unsigned int stageCount = 2;		//Vertex & fragment
+
+	//Build in flight, between the sources being submitted & the new program being swapped in
+	struct PendingBuild
+	{
+		bool active = false;
+		unsigned int program = 0;
+		unsigned int stages[stageCount] = {};		//Either freshly compiled or shared with the current program
+		uint64_t stageHashes[stageCount] = {};
+		uint64_t binaryKey = 0;
+		bool warm = false;		//Loaded from the binary cache, nothing to wait for
+		std::chrono::high_resolution_clock::time_point start;
+	};
+
 	std::string filepath;
+	ShaderDefines defines;
 	unsigned int rendererID;
+	bool ready;
+	PendingBuild pending;
+
+	//Compiled stages of the current program & the hashes of their sources, 0 for a program loaded from a binary
+	unsigned int stages[stageCount];
+	uint64_t stageHashes[stageCount];
+	std::vector<std::string> sourceFiles;		//The .shader file & its includes
 	
-	//Caching for uniforms
-	std::unordered_map<std::string, int> uLocationCache;
+	//Flat table of uniforms, indices never change so handles stay valid
+	std::vector<UniformInfo> uniforms;
 
 public:
 	//Constructor & Destructor
-	Shader(const std::string& file_path);
+	Shader(const std::string& file_path, const ShaderDefines& defines = ShaderDefines());
 	~Shader();
 
 	void Bind() const;
 	void Unbind() const;
 
-	//Set uniforms' value(s)
+	inline unsigned int GetRendererID() const { return rendererID; };
+	inline const std::string& GetFilePath() const { return filepath; };
+	inline const ShaderDefines& GetDefines() const { return defines; };
+	inline const std::vector<std::string>& GetSourceFiles() const { return sourceFiles; };
+
+	//Rebuilding from the files on disk, the object (& its uniform handles) stays the same & a failure keeps the old program
+	bool Reload();
+
+	//False while a ShaderLibrary is still building it, uniforms should only be set once it's ready
+	inline bool IsReady() const { return ready; };
+
+	static bool IsParallelCompileSupported();
+
+	//Looking up a uniform once, so that setting it later is just an array access
+	UniformHandle GetUniformHandle(UniformID id);
+	UniformHandle GetUniformHandle(const std::string& name);
+
+	//Set uniforms' value(s), calls with an unchanged value or an invalid handle don't reach GL
+	void SetUniform1i(UniformHandle handle, int value);
+	void SetUniform1iv(UniformHandle handle, int count, const int* values);
+	void SetUniformMat4f(UniformHandle handle, const glm::mat4& matrix);
+
+	void SetUniform1i(UniformID id, int value);
+	void SetUniform1iv(UniformID id, int count, const int* values);
+	void SetUniformMat4f(UniformID id, const glm::mat4& matrix);
+
 	void SetUniform1i(const std::string& name, int value);
-	void SetUniformMat4f(const std::string& name, const glm::mat4 matrix);
+	void SetUniform1iv(const std::string& name, int count, const int* values);
+	void SetUniformMat4f(const std::string& name, const glm::mat4& matrix);
 
 private:
-	ShaderProgramSource ParseShader(const std::string& file_path);
+	Shader(const PreprocessedShader& source, const std::string& file_path, const ShaderDefines& defines, bool deferred);
+
+	void StartBuild(const PreprocessedShader& source);
+	bool IsBuildComplete() const;
+	bool FinishBuild();
+	void DiscardPendingBuild();
+	inline bool IsBuilding() const { return pending.active; };
+	std::string GetBinaryName() const;
+
 	unsigned int CompileShader(unsigned int type, const std::string& source);
 	unsigned int CreateShader(const std::string& vertex_shader, const std::string& fragment_shader);
-	
-	int GetUniformLocation(const std::string& name);
+	bool CheckShader(unsigned int id, unsigned int type);
+	unsigned int CheckProgram(unsigned int program);
+	void BindUniformBlocks();
+
+	void ReflectUniforms();
+	void RestoreUniformValues();
+	int FindUniform(UniformID id) const;
+	int AddMissingUniform(UniformID id, const std::string& name);
+	UniformInfo* GetUniform(UniformHandle handle);
+	bool UpdateShadowValue(UniformInfo& uniform, const void* data, unsigned int size);
 };
\ No newline at end of file
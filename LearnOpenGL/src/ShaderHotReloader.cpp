@@ -0,0 +1,102 @@
+#include "ShaderHotReloader.h"
+#include "Shader.h"
+
+#include <algorithm>
+#include <iostream>
+
+
+ShaderHotReloader& ShaderHotReloader::Get()
+{
+	static ShaderHotReloader reloader;
+	return reloader;
+}
+
+
+void ShaderHotReloader::Add(Shader* shader)
+{
+	shaders.push_back(shader);
+	for (const std::string& file : shader->GetSourceFiles())
+		watcher.Watch(file);
+}
+
+
+void ShaderHotReloader::Remove(Shader* shader)
+{
+	shaders.erase(std::remove(shaders.begin(), shaders.end(), shader), shaders.end());
+	rebuilding.erase(std::remove(rebuilding.begin(), rebuilding.end(), shader), rebuilding.end());
+}
+
+
+void ShaderHotReloader::Update(float budget_ms)
+{
+	std::vector<std::string> changed = watcher.Poll();
+	if (!changed.empty() && rebuilding.empty())
+		batchStart = std::chrono::high_resolution_clock::now();
+
+	//Only the shaders that use one of the changed files
+	for (const std::string& file : changed)
+	{
+		std::cout << "Shader file changed: " << file << std::endl;
+		for (Shader* shader : shaders)
+		{
+			const std::vector<std::string>& sourceFiles = shader->GetSourceFiles();
+			if (std::find(sourceFiles.begin(), sourceFiles.end(), file) != sourceFiles.end())
+				StartRebuild(shader);
+		}
+	}
+
+	if (rebuilding.empty())
+		return;
+
+	//Same scheduling as the ShaderLibrary: never blocks with parallel compilation, otherwise within the budget
+	auto start = std::chrono::high_resolution_clock::now();
+	bool parallel = Shader::IsParallelCompileSupported();
+	for (unsigned int i = 0; i < rebuilding.size();)
+	{
+		if (!parallel && i > 0)
+		{
+			float elapsed = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+			if (elapsed >= budget_ms)
+				break;
+		}
+
+		Shader* shader = rebuilding[i];
+		if (!shader->IsBuildComplete())
+		{
+			i++;
+			continue;
+		}
+
+		FinishRebuild(shader);
+		rebuilding.erase(rebuilding.begin() + i);
+	}
+
+	if (rebuilding.empty())
+		stats.lastReloadTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - batchStart).count();
+}
+
+
+//A shader that's changed again mid-rebuild simply starts over with the newer files
+void ShaderHotReloader::StartRebuild(Shader* shader)
+{
+	shader->StartBuild(ShaderPreprocessor::Process(shader->GetFilePath(), shader->GetDefines()));
+
+	if (std::find(rebuilding.begin(), rebuilding.end(), shader) == rebuilding.end())
+		rebuilding.push_back(shader);
+}
+
+
+void ShaderHotReloader::FinishRebuild(Shader* shader)
+{
+	if (shader->FinishBuild())
+	{
+		stats.reloads++;
+		std::cout << "Reloaded shader: " << shader->GetFilePath() << std::endl;
+	}
+	else
+		stats.failures++;
+
+	//The new version may include files the old one didn't
+	for (const std::string& file : shader->GetSourceFiles())
+		watcher.Watch(file);
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "FileWatcher.h"
+
+//Hot reloading is on in debug builds, any build can override it with /D SHADER_HOT_RELOAD=0 or 1
+#ifndef SHADER_HOT_RELOAD
+	#ifdef _DEBUG
+		#define SHADER_HOT_RELOAD 1
+	#else
+		#define SHADER_HOT_RELOAD 0
+	#endif
+#endif
+
+class Shader;
+
+
+/*
+Rebuilds shaders whose .shader file (or any file they include) changed on disk.
+Every Shader registers itself when hot reloading is compiled in, Update() is called once per frame:
+it starts the rebuilds of the affected shaders & swaps in those the driver finished, within a time budget.
+Each rebuild only recompiles the stages whose preprocessed source changed.
+*/
+class ShaderHotReloader
+{
+public:
+	//Counters for the whole run
+	struct Stats
+	{
+		unsigned int reloads = 0;		//Rebuilds that were swapped in
+		unsigned int failures = 0;		//Rebuilds that failed, the shader kept its old program
+		float lastReloadTime = 0.0f;	//ms of the latest batch of changes, from detection to the last swap
+	};
+
+private:
+	FileWatcher watcher;
+	std::vector<Shader*> shaders;
+	std::vector<Shader*> rebuilding;
+	std::chrono::high_resolution_clock::time_point batchStart;
+
+	Stats stats;
+
+public:
+	static ShaderHotReloader& Get();
+
+	void Add(Shader* shader);
+	void Remove(Shader* shader);
+
+	void Update(float budget_ms = 2.0f);
+
+	inline unsigned int GetShaderCount() const { return (unsigned int)shaders.size(); };
+	inline unsigned int GetWatchedFileCount() const { return watcher.GetFileCount(); };
+	inline const Stats& GetStats() const { return stats; };
+
+private:
+	ShaderHotReloader() {}
+
+	void StartRebuild(Shader* shader);
+	void FinishRebuild(Shader* shader);
+};
\ No newline at end of file
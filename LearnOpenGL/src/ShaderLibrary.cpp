@@ -0,0 +1,113 @@
+#include "ShaderLibrary.h"
+#include "Renderer.h"
+
+
+//Constructor
+ShaderLibrary::ShaderLibrary()
+	: parallel(Shader::IsParallelCompileSupported())
+{
+	//Letting the driver pick how many compiler threads it wants
+	if (GLEW_KHR_parallel_shader_compile)
+	{
+		glErrorCall( glMaxShaderCompilerThreadsKHR(0xFFFFFFFF) );
+	}
+	else if (GLEW_ARB_parallel_shader_compile)
+	{
+		glErrorCall( glMaxShaderCompilerThreadsARB(0xFFFFFFFF) );
+	}
+}
+
+
+Shader* ShaderLibrary::Load(const std::string& file_path, const ShaderDefines& defines)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	unsigned int compiled = variants.GetStats().compiled;
+
+	//Variants that were already submitted are handed out as they are, ready or not
+	Shader* shader = variants.Get(file_path, defines, true);
+	if (variants.GetStats().compiled == compiled)
+		return shader;
+
+	if (pending.empty())
+		loadStart = start;
+	stats.loaded++;
+
+	//A program from the binary cache has nothing to wait for
+	if (shader->IsBuildComplete())
+	{
+		shader->FinishBuild();
+		stats.finished++;
+	}
+	else
+		pending.push_back(shader);
+
+	auto end = std::chrono::high_resolution_clock::now();
+	stats.submitTime += std::chrono::duration<float, std::milli>(end - start).count();
+	if (pending.empty())
+		stats.loadTime += std::chrono::duration<float, std::milli>(end - loadStart).count();
+
+	return shader;
+}
+
+
+Shader* ShaderLibrary::Get(const std::string& file_path, const ShaderDefines& defines) const
+{
+	return variants.Find(file_path, defines);
+}
+
+
+bool ShaderLibrary::Update(float budget_ms)
+{
+	if (pending.empty())
+		return true;
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < pending.size();)
+	{
+		//Without parallel compilation finishing blocks, so the budget decides how many shaders get finished this call
+		if (!parallel && i > 0)
+		{
+			float elapsed = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+			if (elapsed >= budget_ms)
+				break;
+		}
+
+		Shader* shader = pending[i];
+		if (!shader->IsBuildComplete())
+		{
+			i++;
+			continue;
+		}
+
+		shader->FinishBuild();
+		stats.finished++;
+		pending.erase(pending.begin() + i);
+	}
+
+	auto end = std::chrono::high_resolution_clock::now();
+	stats.finishTime += std::chrono::duration<float, std::milli>(end - start).count();
+	if (pending.empty())
+		stats.loadTime += std::chrono::duration<float, std::milli>(end - loadStart).count();
+
+	return pending.empty();
+}
+
+
+void ShaderLibrary::WaitAll()
+{
+	if (pending.empty())
+		return;
+
+	//Finishing blocks until each build is done, which is what's wanted here
+	auto start = std::chrono::high_resolution_clock::now();
+	for (Shader* shader : pending)
+	{
+		shader->FinishBuild();
+		stats.finished++;
+	}
+	pending.clear();
+
+	auto end = std::chrono::high_resolution_clock::now();
+	stats.finishTime += std::chrono::duration<float, std::milli>(end - start).count();
+	stats.loadTime += std::chrono::duration<float, std::milli>(end - loadStart).count();
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "Shader.h"
+#include "ShaderVariantCache.h"
+
+
+/*
+Owner of shaders that are built in the background.
+Load() submits the compile & link of a shader & hands it out right away, Update() finishes whatever the driver is done with.
+With GL_KHR_parallel_shader_compile the driver compiles on its own threads & Update() never blocks,
+without it Update() finishes shaders one after another until its time budget runs out.
+Shaders are kept in a ShaderVariantCache, so the pointers stay valid as long as the library lives.
+*/
+class ShaderLibrary
+{
+public:
+	struct Stats
+	{
+		unsigned int loaded = 0;		//Shaders submitted so far
+		unsigned int finished = 0;		//Shaders that are ready
+		float submitTime = 0.0f;		//ms spent inside Load()
+		float finishTime = 0.0f;		//ms spent inside Update() finishing shaders
+		float loadTime = 0.0f;			//ms from the first Load() until nothing was pending
+	};
+
+private:
+	ShaderVariantCache variants;
+	std::vector<Shader*> pending;
+	bool parallel;
+
+	std::chrono::high_resolution_clock::time_point loadStart;
+	Stats stats;
+
+public:
+	//Constructor
+	ShaderLibrary();
+
+	//Loading the same variant twice hands out the same shader
+	Shader* Load(const std::string& file_path, const ShaderDefines& defines = ShaderDefines());
+	Shader* Get(const std::string& file_path, const ShaderDefines& defines = ShaderDefines()) const;
+
+	//Finishes completed builds, returns true once nothing is pending
+	bool Update(float budget_ms = 2.0f);
+	void WaitAll();
+
+	inline bool IsReady() const { return pending.empty(); };
+	inline unsigned int GetPendingCount() const { return (unsigned int)pending.size(); };
+	inline unsigned int GetCount() const { return variants.GetCount(); };
+	inline bool IsParallel() const { return parallel; };
+	inline const Stats& GetStats() const { return stats; };
+	inline const ShaderVariantCache& GetVariantCache() const { return variants; };
+};
\ No newline at end of file
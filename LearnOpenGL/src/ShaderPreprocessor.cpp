@@ -0,0 +1,235 @@
+#include "ShaderPreprocessor.h"
+#include "Hash.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+
+//  Shader Defines  //
+//Constructor
+ShaderDefines::ShaderDefines(std::initializer_list<const char*> names)
+{
+	for (const char* name : names)
+		Set(name);
+}
+
+
+ShaderDefines& ShaderDefines::Set(const std::string& name, const std::string& value)
+{
+	auto it = std::lower_bound(defines.begin(), defines.end(), name,
+		[](const std::pair<std::string, std::string>& define, const std::string& name) { return define.first < name; });
+
+	if (it != defines.end() && it->first == name)
+		it->second = value;
+	else
+		defines.insert(it, std::make_pair(name, value));
+
+	return *this;
+}
+
+
+uint64_t ShaderDefines::GetKey() const
+{
+	if (defines.empty())
+		return 0;
+
+	uint64_t hash = hashSeed;
+	for (const auto& define : defines)
+	{
+		hash = HashString(define.first, hash);
+		hash = HashString(define.second, hash);
+	}
+	return hash;
+}
+
+
+uint64_t PreprocessedShader::GetSourceHash() const
+{
+	uint64_t hash = HashString(source.vertexSource);
+	return HashString(source.fragmentSource, hash);
+}
+
+
+//  Preprocessor    //
+static const unsigned int maxIncludeDepth = 16;
+
+
+PreprocessedShader ShaderPreprocessor::Process(const std::string& file_path, const ShaderDefines& defines)
+{
+	PreprocessedShader result;
+	result.files.push_back(file_path);
+
+	std::ifstream stream(file_path);
+	if (!stream)
+	{
+		std::cout << "ERROR::ShaderPreprocessor.cpp::Process():: Can't open '" << file_path << "'" << std::endl;
+		result.valid = false;
+		return result;
+	}
+
+	enum class ShaderType {
+		NONE = -1, VERTEX = 0, FRAGMENT = 1
+	};
+
+	Stage stages[2];
+	ShaderType type = ShaderType::NONE;
+	std::string directory = GetDirectory(file_path);
+
+	//Reading the shader source file and using keywords to split it
+	std::string line;
+	unsigned int lineNumber = 0;
+	while (getline(stream, line))
+	{
+		lineNumber++;
+		if (line.find("#shader") != std::string::npos)
+		{
+			if (line.find("vertex") != std::string::npos)
+				type = ShaderType::VERTEX;
+			else if (line.find("fragment") != std::string::npos)
+				type = ShaderType::FRAGMENT;
+			continue;
+		}
+
+		if (type == ShaderType::NONE)
+			continue;
+
+		Stage& stage = stages[(int)type];
+		std::string includePath;
+		if (stage.header.empty() && line.find("#version") != std::string::npos)
+		{
+			stage.header = line + '\n';
+			stage.bodyLine = lineNumber + 1;
+		}
+		else if (ParseInclude(line, includePath))
+		{
+			std::string fullPath = directory + includePath;
+			if (!Expand(fullPath, GetFileIndex(fullPath, result), stage, result, 1))
+				result.valid = false;
+
+			stage.body += "#line " + std::to_string(lineNumber + 1) + " 0\n";
+		}
+		else
+			stage.body += line + '\n';
+	}
+
+	result.source = { BuildStage(stages[0], defines), BuildStage(stages[1], defines) };
+	return result;
+}
+
+
+//Pasting an included file into the stage, includes inside it are resolved relative to it
+bool ShaderPreprocessor::Expand(const std::string& file_path, unsigned int file_index, Stage& stage, PreprocessedShader& result, unsigned int depth)
+{
+	//Acts like #pragma once, which also stops include cycles
+	if (std::find(stage.includedFiles.begin(), stage.includedFiles.end(), file_path) != stage.includedFiles.end())
+		return true;
+	stage.includedFiles.push_back(file_path);
+
+	if (depth > maxIncludeDepth)
+	{
+		std::cout << "ERROR::ShaderPreprocessor.cpp::Expand():: Includes nested too deep at '" << file_path << "'" << std::endl;
+		return false;
+	}
+
+	std::ifstream stream(file_path);
+	if (!stream)
+	{
+		std::cout << "ERROR::ShaderPreprocessor.cpp::Expand():: Can't open include '" << file_path << "'" << std::endl;
+		return false;
+	}
+
+	std::string directory = GetDirectory(file_path);
+	std::string line;
+	unsigned int lineNumber = 0;
+	bool success = true;
+
+	stage.body += "#line 1 " + std::to_string(file_index) + "\n";
+	while (getline(stream, line))
+	{
+		lineNumber++;
+
+		std::string includePath;
+		if (ParseInclude(line, includePath))
+		{
+			std::string fullPath = directory + includePath;
+			success = Expand(fullPath, GetFileIndex(fullPath, result), stage, result, depth + 1) && success;
+			stage.body += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(file_index) + "\n";
+		}
+		else
+			stage.body += line + '\n';
+	}
+
+	return success;
+}
+
+
+//Matches: #include "path"
+bool ShaderPreprocessor::ParseInclude(const std::string& line, std::string& include_path)
+{
+	size_t start = line.find_first_not_of(" \t");
+	if (start == std::string::npos || line.compare(start, 8, "#include") != 0)
+		return false;
+
+	size_t open = line.find('"', start + 8);
+	size_t close = open != std::string::npos ? line.find('"', open + 1) : std::string::npos;
+	if (close == std::string::npos)
+		return false;
+
+	include_path = line.substr(open + 1, close - open - 1);
+	return true;
+}
+
+
+unsigned int ShaderPreprocessor::GetFileIndex(const std::string& file_path, PreprocessedShader& result)
+{
+	auto it = std::find(result.files.begin(), result.files.end(), file_path);
+	if (it != result.files.end())
+		return (unsigned int)(it - result.files.begin());
+
+	result.files.push_back(file_path);
+	return (unsigned int)result.files.size() - 1;
+}
+
+
+std::string ShaderPreprocessor::GetDirectory(const std::string& file_path)
+{
+	size_t slash = file_path.find_last_of("/\\");
+	return slash != std::string::npos ? file_path.substr(0, slash + 1) : "";
+}
+
+
+//Whole identifier match, so that "USE_COLOR" doesn't match "USE_COLOR_RAMP"
+bool ShaderPreprocessor::ContainsWord(const std::string& source, const std::string& word)
+{
+	auto isIdentifier = [](char c) { return std::isalnum((unsigned char)c) || c == '_'; };
+
+	for (size_t pos = source.find(word); pos != std::string::npos; pos = source.find(word, pos + 1))
+	{
+		bool startsWord = pos == 0 || !isIdentifier(source[pos - 1]);
+		bool endsWord = pos + word.size() == source.size() || !isIdentifier(source[pos + word.size()]);
+		if (startsWord && endsWord)
+			return true;
+	}
+
+	return false;
+}
+
+
+std::string ShaderPreprocessor::BuildStage(const Stage& stage, const ShaderDefines& defines)
+{
+	std::stringstream ss;
+	ss << stage.header;
+
+	for (const auto& define : defines.GetDefines())
+	{
+		if (ContainsWord(stage.body, define.first))
+			ss << "#define " << define.first << ' ' << define.second << '\n';
+	}
+
+	ss << "#line " << stage.bodyLine << " 0\n";
+	ss << stage.body;
+	return ss.str();
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+
+//Struct to handle source code for shaders
+struct ShaderProgramSource
+{
+	std::string vertexSource;
+	std::string fragmentSource;
+};
+
+
+//Set of #defines a shader variant is built with, kept sorted so that the same set always gives the same key
+class ShaderDefines
+{
+private:
+	std::vector<std::pair<std::string, std::string>> defines;
+
+public:
+	//Constructors
+	ShaderDefines() {}
+	ShaderDefines(std::initializer_list<const char*> names);		//Each one defined as 1
+
+	ShaderDefines& Set(const std::string& name, const std::string& value = "1");
+
+	//Permutation key of the set, 0 for no defines
+	uint64_t GetKey() const;
+
+	inline bool IsEmpty() const { return defines.empty(); };
+	inline const std::vector<std::pair<std::string, std::string>>& GetDefines() const { return defines; };
+};
+
+
+//A .shader file after preprocessing
+struct PreprocessedShader
+{
+	ShaderProgramSource source;
+	std::vector<std::string> files;		//The shader file first, then everything it includes
+	bool valid = true;
+
+	//Hash of the final sources, identical hashes compile to identical programs
+	uint64_t GetSourceHash() const;
+};
+
+
+/*
+Turns a .shader file into the sources of its stages:
+-	"#shader vertex" & "#shader fragment" split the file into stages
+-	#include "file" pastes a file (relative to the including one) in place, each file at most once per stage
+-	defines are injected right after #version, but only those whose name shows up in the stage,
+	so defines a shader doesn't care about don't create a new variant
+-	#line directives keep the compiler's line numbers pointing into the right file (the second number indexes files)
+*/
+class ShaderPreprocessor
+{
+public:
+	static PreprocessedShader Process(const std::string& file_path, const ShaderDefines& defines);
+
+private:
+	struct Stage
+	{
+		std::string header;		//Everything up to & including #version
+		std::string body;
+		unsigned int bodyLine = 1;		//Line of the main file the body starts at
+		std::vector<std::string> includedFiles;
+	};
+
+	static bool Expand(const std::string& file_path, unsigned int file_index, Stage& stage, PreprocessedShader& result, unsigned int depth);
+	static bool ParseInclude(const std::string& line, std::string& include_path);
+	static unsigned int GetFileIndex(const std::string& file_path, PreprocessedShader& result);
+	static std::string GetDirectory(const std::string& file_path);
+	static bool ContainsWord(const std::string& source, const std::string& word);
+	static std::string BuildStage(const Stage& stage, const ShaderDefines& defines);
+};
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "ShaderVariantCache.h"
+#include "Hash.h"
+
+
+Shader* ShaderVariantCache::Get(const std::string& file_path, const ShaderDefines& defines, bool deferred)
+{
+	stats.requests++;
+
+	uint64_t variantKey = GetVariantKey(file_path, defines);
+	auto variant = variants.find(variantKey);
+	if (variant != variants.end())
+	{
+		stats.variantHits++;
+		return variant->second;
+	}
+
+	//Preprocessing is cheap next to compiling, so it's done for every new variant to find duplicates
+	PreprocessedShader source = ShaderPreprocessor::Process(file_path, defines);
+	uint64_t sourceHash = source.GetSourceHash();
+
+	auto shared = sources.find(sourceHash);
+	if (source.valid && shared != sources.end())
+	{
+		stats.sourceHits++;
+		variants[variantKey] = shared->second;
+		return shared->second;
+	}
+
+	//The constructor is private to everyone but the caches
+	shaders.push_back(std::unique_ptr<Shader>(new Shader(source, file_path, defines, deferred)));
+	Shader* shader = shaders.back().get();
+	stats.compiled++;
+
+	variants[variantKey] = shader;
+	if (source.valid)
+		sources[sourceHash] = shader;
+
+	return shader;
+}
+
+
+Shader* ShaderVariantCache::Find(const std::string& file_path, const ShaderDefines& defines) const
+{
+	auto variant = variants.find(GetVariantKey(file_path, defines));
+	return variant != variants.end() ? variant->second : nullptr;
+}
+
+
+uint64_t ShaderVariantCache::GetVariantKey(const std::string& file_path, const ShaderDefines& defines)
+{
+	return HashString(file_path, defines.GetKey());
+}
\ No newline at end of file
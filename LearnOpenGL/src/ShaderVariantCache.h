@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Shader.h"
+
+
+/*
+Owner of every shader variant (file + defines) that was asked for, variants are only built on their first request.
+Two requests that preprocess to the same sources (e.g. a define the shader never uses) share one program.
+Shader pointers stay valid as long as the cache lives.
+*/
+class ShaderVariantCache
+{
+public:
+	//Counters for the lifetime of the cache
+	struct Stats
+	{
+		unsigned int requests = 0;
+		unsigned int variantHits = 0;	//Same file & defines as an earlier request
+		unsigned int sourceHits = 0;	//New variant, but identical sources to a built one
+		unsigned int compiled = 0;		//Variants actually built
+	};
+
+private:
+	std::vector<std::unique_ptr<Shader>> shaders;
+	std::unordered_map<uint64_t, Shader*> variants;		//Keyed by file & defines
+	std::unordered_map<uint64_t, Shader*> sources;		//Keyed by the hash of the preprocessed sources
+
+	Stats stats;
+
+public:
+	//Deferred shaders are only submitted, whoever asked for them has to finish them (see ShaderLibrary)
+	Shader* Get(const std::string& file_path, const ShaderDefines& defines = ShaderDefines(), bool deferred = false);
+
+	//Doesn't build anything, nullptr if the variant wasn't requested before
+	Shader* Find(const std::string& file_path, const ShaderDefines& defines = ShaderDefines()) const;
+
+	inline unsigned int GetCount() const { return (unsigned int)shaders.size(); };
+	inline const std::vector<std::unique_ptr<Shader>>& GetShaders() const { return shaders; };
+	inline const Stats& GetStats() const { return stats; };
+
+private:
+	static uint64_t GetVariantKey(const std::string& file_path, const ShaderDefines& defines);
+};
\ No newline at end of file
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Renderer.h"
+#include "VertexBufferLayout.h"
+
+
+/*
+Vertex layouts declared next to the vertex struct & checked at compile time:
+
+	struct QuadVertex
+	{
+		glm::vec2 position;
+		glm::vec2 texCoord;
+	};
+
+	VERTEX_LAYOUT(QuadVertex,
+		VERTEX_ATTRIBUTE(QuadVertex, position),
+		VERTEX_ATTRIBUTE(QuadVertex, texCoord));
+
+	va.AddBuffer<QuadVertex>(vb);
+
+The GL type & component count come from the member's C++ type, the offset from offsetof(), the stride is sizeof(Vertex).
+A layout doesn't compile if attributes overlap, are out of order, start off a 4 byte boundary,
+leave bytes of the struct undescribed (a forgotten member) or use a type without a mapping.
+The attribute setup is one fixed sequence of GL calls per attribute, nothing is looked up at runtime.
+VERTEX_LAYOUT has to be used at global scope.
+*/
+
+
+//  Attribute Types //
+//Member type -> GL type, components, normalized, read as int by the shader, attribute locations taken
+template<unsigned int Type, unsigned int Count, bool Normalized, bool Integer, unsigned int Locations = 1>
+struct VertexAttributeDescription
+{
+	static constexpr unsigned int type = Type;
+	static constexpr unsigned int count = Count;
+	static constexpr bool normalized = Normalized;
+	static constexpr bool integer = Integer;
+	static constexpr unsigned int locations = Locations;
+};
+
+template<typename T>
+struct VertexAttributeTraits : VertexAttributeDescription<0, 0, false, false>
+{
+	static_assert(sizeof(T) == 0, "VertexAttributeTraits<T>: T has no vertex attribute mapping");
+};
+
+template<> struct VertexAttributeTraits<float> : VertexAttributeDescription<GL_FLOAT, 1, false, false> {};
+template<> struct VertexAttributeTraits<glm::vec2> : VertexAttributeDescription<GL_FLOAT, 2, false, false> {};
+template<> struct VertexAttributeTraits<glm::vec3> : VertexAttributeDescription<GL_FLOAT, 3, false, false> {};
+template<> struct VertexAttributeTraits<glm::vec4> : VertexAttributeDescription<GL_FLOAT, 4, false, false> {};
+template<> struct VertexAttributeTraits<glm::mat4> : VertexAttributeDescription<GL_FLOAT, 4, false, false, 4> {};		//A vec4 column per location
+template<> struct VertexAttributeTraits<Half> : VertexAttributeDescription<GL_HALF_FLOAT, 1, false, false> {};
+template<> struct VertexAttributeTraits<Snorm1010102> : VertexAttributeDescription<GL_INT_2_10_10_10_REV, 4, true, false> {};
+
+//8 & 16 bit integers are normalized (0 - 1 or -1 - 1), 32 bit integers are read as int / uint
+template<> struct VertexAttributeTraits<signed char> : VertexAttributeDescription<GL_BYTE, 1, true, false> {};
+template<> struct VertexAttributeTraits<unsigned char> : VertexAttributeDescription<GL_UNSIGNED_BYTE, 1, true, false> {};
+template<> struct VertexAttributeTraits<short> : VertexAttributeDescription<GL_SHORT, 1, true, false> {};
+template<> struct VertexAttributeTraits<unsigned short> : VertexAttributeDescription<GL_UNSIGNED_SHORT, 1, true, false> {};
+template<> struct VertexAttributeTraits<int> : VertexAttributeDescription<GL_INT, 1, false, true> {};
+template<> struct VertexAttributeTraits<unsigned int> : VertexAttributeDescription<GL_UNSIGNED_INT, 1, false, true> {};
+template<> struct VertexAttributeTraits<glm::ivec2> : VertexAttributeDescription<GL_INT, 2, false, true> {};
+template<> struct VertexAttributeTraits<glm::ivec3> : VertexAttributeDescription<GL_INT, 3, false, true> {};
+template<> struct VertexAttributeTraits<glm::ivec4> : VertexAttributeDescription<GL_INT, 4, false, true> {};
+template<> struct VertexAttributeTraits<glm::uvec2> : VertexAttributeDescription<GL_UNSIGNED_INT, 2, false, true> {};
+template<> struct VertexAttributeTraits<glm::uvec3> : VertexAttributeDescription<GL_UNSIGNED_INT, 3, false, true> {};
+template<> struct VertexAttributeTraits<glm::uvec4> : VertexAttributeDescription<GL_UNSIGNED_INT, 4, false, true> {};
+
+//Arrays of a scalar type are one attribute with a component per element (e.g. unsigned char color[4], Half texCoord[2])
+template<typename T, std::size_t N>
+struct VertexAttributeTraits<T[N]> : VertexAttributeDescription<VertexAttributeTraits<T>::type, VertexAttributeTraits<T>::count * N,
+	VertexAttributeTraits<T>::normalized, VertexAttributeTraits<T>::integer>
+{
+	static_assert(VertexAttributeTraits<T>::count == 1, "VertexAttributeTraits<T[N]>: only arrays of scalar types are attributes");
+	static_assert(N >= 1 && N <= 4, "VertexAttributeTraits<T[N]>: attributes have 1 to 4 components");
+};
+
+
+//One member of a vertex struct
+template<typename T, std::size_t Offset>
+struct VertexAttribute : VertexAttributeTraits<T>
+{
+	static constexpr std::size_t offset = Offset;
+	static constexpr std::size_t size = sizeof(T);
+
+	static_assert(Offset % 4 == 0, "VertexAttribute: attributes have to start at a multiple of 4 bytes");
+};
+
+#define VERTEX_ATTRIBUTE(Vertex, member) VertexAttribute<decltype(Vertex::member), offsetof(Vertex, member)>
+
+
+//  Layout  //
+template<typename Vertex, typename... Attributes>
+class StaticVertexLayout
+{
+private:
+	//The leading 0 keeps the arrays valid for an empty pack, the static_asserts below report that case
+	static constexpr unsigned int GetFirstLocation(std::size_t index)
+	{
+		const unsigned int locations[] = { 0u, Attributes::locations... };
+		unsigned int first = 0;
+		for (std::size_t i = 0; i < index; i++)
+			first += locations[i + 1];
+		return first;
+	}
+
+	static constexpr bool AreInOrder()
+	{
+		const std::size_t offsets[] = { 0u, Attributes::offset... };
+		const std::size_t sizes[] = { 0u, Attributes::size... };
+		for (std::size_t i = 1; i < sizeof...(Attributes); i++)
+		{
+			if (offsets[i] + sizes[i] > offsets[i + 1])
+				return false;
+		}
+		return true;
+	}
+
+	static constexpr std::size_t GetDescribedSize()
+	{
+		const std::size_t sizes[] = { 0u, Attributes::size... };
+		std::size_t total = 0;
+		for (std::size_t size : sizes)
+			total += size;
+		return total;
+	}
+
+public:
+	static constexpr unsigned int stride = sizeof(Vertex);
+	static constexpr unsigned int attributeCount = sizeof...(Attributes);
+	static constexpr unsigned int locationCount = GetFirstLocation(attributeCount);		//Attribute indices taken
+
+	static_assert(std::is_standard_layout<Vertex>::value, "StaticVertexLayout: the vertex has to be standard layout for offsetof()");
+	static_assert(sizeof...(Attributes) > 0, "StaticVertexLayout: a vertex needs at least one attribute");
+	static_assert(AreInOrder(), "StaticVertexLayout: attributes overlap or aren't in member order");
+	static_assert(GetDescribedSize() == sizeof(Vertex), "StaticVertexLayout: attributes don't cover the whole vertex (missing attribute or padding)");
+
+	//Enables & specifies every attribute of the buffer bound to GL_ARRAY_BUFFER, starting at first_location
+	static void Setup(unsigned int first_location, unsigned int divisor)
+	{
+		Setup(first_location, divisor, std::make_index_sequence<sizeof...(Attributes)>());
+	}
+
+private:
+	template<std::size_t... I>
+	static void Setup(unsigned int first_location, unsigned int divisor, std::index_sequence<I...>)
+	{
+		int expand[] = { 0, (SetupAttribute<typename std::tuple_element<I, std::tuple<Attributes...>>::type>(
+			first_location + GetFirstLocation(I), divisor), 0)... };
+		(void)expand;
+	}
+
+	template<typename Attribute>
+	static void SetupAttribute(unsigned int location, unsigned int divisor)
+	{
+		for (unsigned int column = 0; column < Attribute::locations; column++)
+		{
+			const void* offset = (const void*)(Attribute::offset + column * (Attribute::size / Attribute::locations));
+			glErrorCall( glEnableVertexAttribArray(location + column) );
+			if (Attribute::integer)
+			{
+				glErrorCall( glVertexAttribIPointer(location + column, Attribute::count, Attribute::type, stride, offset) );
+			}
+			else
+			{
+				glErrorCall( glVertexAttribPointer(location + column, Attribute::count, Attribute::type,
+					Attribute::normalized ? GL_TRUE : GL_FALSE, stride, offset) );
+			}
+			glErrorCall( glVertexAttribDivisor(location + column, divisor) );
+		}
+	}
+};
+
+
+//Specialized by VERTEX_LAYOUT for every vertex struct
+template<typename Vertex>
+struct VertexLayoutOf
+{
+	static_assert(sizeof(Vertex) == 0, "VertexLayoutOf<Vertex>: no VERTEX_LAYOUT for this vertex");
+};
+
+#define VERTEX_LAYOUT(Vertex, ...) template<> struct VertexLayoutOf<Vertex> { typedef StaticVertexLayout<Vertex, __VA_ARGS__> Type; }
\ No newline at end of file
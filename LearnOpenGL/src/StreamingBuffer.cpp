@@ -0,0 +1,205 @@
+#include "StreamingBuffer.h"
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "VertexArrayCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+
+//Constructor
+StreamingBuffer::StreamingBuffer(unsigned int target, unsigned int region_size, unsigned int region_count)
+	: rendererID(0), target(target), regionSize(region_size), regionCount(region_count),
+	currentRegion(0), head(0), persistent(false), mappedData(nullptr), fences()
+{
+	if (regionCount > maxRegions)
+		regionCount = maxRegions;
+
+	persistent = GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+	unsigned int totalSize = regionSize * regionCount;
+
+	//Set up through the copy target, so that creating an index buffer doesn't touch the bound vertex array
+	glErrorCall( glGenBuffers(1, &rendererID) );
+	GLStateCache::Get().BindBuffer(GL_COPY_WRITE_BUFFER, rendererID);
+
+	if (persistent)
+	{
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glErrorCall( glBufferStorage(GL_COPY_WRITE_BUFFER, totalSize, nullptr, flags) );
+		glErrorCall( mappedData = (unsigned char*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, totalSize, flags) );
+	}
+	else
+	{
+		glErrorCall( glBufferData(GL_COPY_WRITE_BUFFER, totalSize, nullptr, GL_STREAM_DRAW) );
+	}
+}
+
+//Destructor
+StreamingBuffer::~StreamingBuffer()
+{
+	for (GLsync& fence : fences)
+	{
+		if (fence)
+			glDeleteSync(fence);
+	}
+
+	if (persistent)
+	{
+		GLStateCache::Get().BindBuffer(GL_COPY_WRITE_BUFFER, rendererID);
+		glErrorCall( glUnmapBuffer(GL_COPY_WRITE_BUFFER) );
+	}
+
+	if (VertexArrayCache* vertexArrays = VertexArrayCache::TryGet())
+		vertexArrays->OnDeleteBuffer(rendererID);
+
+	GLStateCache::Get().OnDeleteBuffer(rendererID);
+	glErrorCall( glDeleteBuffers(1, &rendererID) );
+}
+
+
+StreamingBuffer::Allocation StreamingBuffer::Allocate(unsigned int size, unsigned int alignment)
+{
+	if (size > regionSize)
+	{
+		std::cout << "ERROR::StreamingBuffer.cpp::Allocate():: " << size << " bytes don't fit in a region of " << regionSize << std::endl;
+		return { nullptr, 0, 0 };
+	}
+
+	//Rounding up to a multiple of the alignment (vertex strides aren't always powers of 2)
+	unsigned int regionStart = currentRegion * regionSize;
+	unsigned int offset = (regionStart + head + alignment - 1) / alignment * alignment;
+	if (offset + size > regionStart + regionSize)
+	{
+		EndFrame();
+		regionStart = currentRegion * regionSize;
+		offset = (regionStart + alignment - 1) / alignment * alignment;
+
+		if (offset + size > regionStart + regionSize)
+		{
+			std::cout << "ERROR::StreamingBuffer.cpp::Allocate():: " << size << " bytes don't fit in a region after alignment" << std::endl;
+			return { nullptr, 0, 0 };
+		}
+	}
+
+	head = offset + size - regionStart;
+	stats.bytesAllocated += size;
+
+	if (persistent)
+		return { mappedData + offset, offset, size };
+
+	//The region is known to be free (fenced or orphaned), so GL doesn't need to synchronize
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
+	GLStateCache::Get().BindBuffer(GL_COPY_WRITE_BUFFER, rendererID);
+	glErrorCall( void* data = glMapBufferRange(GL_COPY_WRITE_BUFFER, offset, size, flags) );
+	return { data, offset, size };
+}
+
+
+//The unused end of the latest allocation goes back to the region, so reserving for the worst case only costs what was written
+void StreamingBuffer::Commit(const Allocation& allocation, unsigned int used_size)
+{
+	if (!allocation.data)
+		return;
+
+	ASSERT(used_size <= allocation.size);
+	unsigned int regionStart = currentRegion * regionSize;
+	if (allocation.offset >= regionStart && allocation.offset + allocation.size == regionStart + head)
+	{
+		head = allocation.offset + used_size - regionStart;
+		stats.bytesAllocated -= std::min(stats.bytesAllocated, allocation.size - used_size);		//Stats may have been reset since
+	}
+
+	if (persistent)
+		return;		//Coherent mapping, the writes are already visible
+
+	GLStateCache::Get().BindBuffer(GL_COPY_WRITE_BUFFER, rendererID);
+	if (used_size > 0)
+	{
+		glErrorCall( glFlushMappedBufferRange(GL_COPY_WRITE_BUFFER, 0, used_size) );
+	}
+	glErrorCall( glUnmapBuffer(GL_COPY_WRITE_BUFFER) );
+}
+
+
+void StreamingBuffer::EndFrame()
+{
+	if (head == 0)
+		return;		//Nothing written, the old fence (if any) still covers the region
+
+	if (fences[currentRegion])
+		glDeleteSync(fences[currentRegion]);
+	fences[currentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+	NextRegion();
+}
+
+
+void StreamingBuffer::Bind() const
+{
+	GLStateCache::Get().BindBuffer(target, rendererID);
+}
+
+
+void StreamingBuffer::BindRange(unsigned int index, unsigned int offset, unsigned int size) const
+{
+	GLStateCache::Get().BindBufferRange(target, index, rendererID, offset, size);
+}
+
+
+void StreamingBuffer::ResetStats()
+{
+	stats = Stats();
+}
+
+
+//Moving on to the next region, making sure the GPU is done reading it
+void StreamingBuffer::NextRegion()
+{
+	currentRegion = (currentRegion + 1) % regionCount;
+	head = 0;
+
+	GLsync& fence = fences[currentRegion];
+	if (!fence)
+		return;
+
+	GLenum status = glClientWaitSync(fence, 0, 0);
+	if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+	{
+		glDeleteSync(fence);
+		fence = nullptr;
+		return;
+	}
+
+	if (!persistent)
+	{
+		//Giving the buffer new storage is cheaper than waiting, the driver keeps the old one alive until the GPU is done with it
+		GLStateCache::Get().BindBuffer(GL_COPY_WRITE_BUFFER, rendererID);
+		glErrorCall( glBufferData(GL_COPY_WRITE_BUFFER, regionSize * regionCount, nullptr, GL_STREAM_DRAW) );
+
+		for (GLsync& other : fences)
+		{
+			if (other)
+				glDeleteSync(other);
+			other = nullptr;
+		}
+		stats.orphans++;
+		return;
+	}
+
+	//Persistent storage can't be orphaned, so we have to wait
+	auto start = std::chrono::high_resolution_clock::now();
+	while (true)
+	{
+		status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);		//1 ms steps
+		if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED || status == GL_WAIT_FAILED)
+			break;
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+
+	stats.stalls++;
+	stats.stallTime += std::chrono::duration<float, std::milli>(end - start).count();
+
+	glDeleteSync(fence);
+	fence = nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <GL/glew.h>
+
+
+/*
+Ring buffer for data that is rewritten every frame (vertices, indices or uniforms).
+The buffer is split into regions, & every region is fenced once the GPU has been handed its data,
+so the CPU never writes over something that is still being read.
+
+With ARB_buffer_storage the whole buffer stays mapped (persistent & coherent) & waiting on a busy region counts as a stall.
+Without it (GL 3.3) every allocation is mapped unsynchronized, & a busy region orphans the buffer instead of waiting.
+
+Usage per frame: Allocate() -> write to data -> Commit() -> draw from it -> ... -> EndFrame()
+Only one allocation may be uncommitted at a time.
+*/
+class StreamingBuffer
+{
+public:
+	struct Allocation
+	{
+		void* data;				//Write pointer, valid until Commit()
+		unsigned int offset;	//Bytes from the start of the buffer, for draws & BindRange()
+		unsigned int size;
+	};
+
+	//Counters, reset by the user with ResetStats() (usually once per frame)
+	struct Stats
+	{
+		unsigned int bytesAllocated = 0;
+		unsigned int stalls = 0;		//Times the CPU had to wait for the GPU to finish with a region
+		float stallTime = 0.0f;			//ms
+		unsigned int orphans = 0;		//Fallback path only: busy regions skipped by reallocating the buffer
+	};
+
+	static const unsigned int maxRegions = 4;
+
+private:
+	unsigned int rendererID;
+	unsigned int target;
+	unsigned int regionSize, regionCount;
+	unsigned int currentRegion, head;		//head = bytes used in the current region
+	bool persistent;
+	unsigned char* mappedData;		//Whole buffer, persistent path only
+	GLsync fences[maxRegions];
+
+	Stats stats;
+
+public:
+	//Constructor & Destructor
+	StreamingBuffer(unsigned int target, unsigned int region_size, unsigned int region_count = 3);
+	~StreamingBuffer();
+
+	//Returns an allocation with data == nullptr if size is larger than a region
+	Allocation Allocate(unsigned int size, unsigned int alignment = 4);
+	void Commit(const Allocation& allocation, unsigned int used_size);		//Makes the first used_size bytes visible to GL, the rest is reused
+	void EndFrame();	//Fences everything written since the last call & moves on to the next region
+
+	void Bind() const;
+	void BindRange(unsigned int index, unsigned int offset, unsigned int size) const;		//For uniform blocks
+
+	void ResetStats();
+	inline const Stats& GetStats() const { return stats; };
+	inline bool IsPersistent() const { return persistent; };
+	inline unsigned int GetRendererID() const { return rendererID; };
+
+private:
+	void NextRegion();
+};
\ No newline at end of file
@@ -1,38 +1,84 @@
 #include "Texture.h"
+#include "GLStateCache.h"
+#include "UploadManager.h"
 #include "stb_image/stb_image.h"
 
+#include <algorithm>
+#include <iostream>
+
+
+uint32_t TextureParams::GetKey() const
+{
+	return (uint32_t)mipmaps | ((uint32_t)mipFilter << 2) | ((uint32_t)srgb << 3) | (sampler.GetKey() << 4);
+}
+
 
 //Constructor
-Texture::Texture(const std::string& file_path)
+Texture::Texture(const std::string& file_path, const TextureParams& params)
 	: rendererID(0), filePath(file_path), localBuffer(nullptr),
-	width(0), height(0), bpp(0)
+	width(0), height(0), bpp(0), format(TextureFormat::RGBA8), srgb(params.srgb), levelCount(1), baseLevel(0), loaded(true),
+	params(params), samplerID(SamplerCache::Get().GetSampler(params.sampler))
 {
+	//Binding texture (filtering & wrapping come from the sampler that is bound along with it)
+	glErrorCall( glGenTextures(1, &rendererID) );
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D, rendererID);
+
+	//Compressed containers go to the GPU as they are, with their mip levels
+	if (TextureCompressor::IsContainerFile(file_path))
+	{
+		TextureImage image;
+		if (TextureCompressor::Load(file_path, image))
+			SetImage(image);
+		GLStateCache::Get().BindTexture(GL_TEXTURE_2D, 0);
+		return;
+	}
+
 	//Loading image
 	stbi_set_flip_vertically_on_load(1);
 	localBuffer = stbi_load(file_path.c_str(), &width, &height, &bpp, 4);
 
-	//Binding texture
-	glErrorCall( glGenTextures(1, &rendererID) );
-	glErrorCall( glBindTexture(GL_TEXTURE_2D, rendererID) );
-
-	//Setting texture parameters
-	glErrorCall( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR) );	//Resampling texture down if it needs to be rendered small
-	glErrorCall( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR) );	//Resampling texture up if it needs to be rendered large
-	glErrorCall( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE) );	//Clamping horizontally
-	glErrorCall( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE) );	//Clamping vertically
-
 	//Giving opengl the data of the loaded image
-	glErrorCall( glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, localBuffer) );
-	glErrorCall( glBindTexture(GL_TEXTURE_2D, 0) );	//Unbinding once the data is given
+	UploadPixels(localBuffer);
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D, 0);	//Unbinding once the data is given
 
 	//Freeing the local buffer
 	if (localBuffer)
 		stbi_image_free(localBuffer);
 }
 
+//Constructor (from memory)
+Texture::Texture(int width, int height, const unsigned char* pixels, const TextureParams& params)
+	: rendererID(0), filePath(), localBuffer(nullptr),
+	width(width), height(height), bpp(4), format(TextureFormat::RGBA8), srgb(params.srgb), levelCount(1), baseLevel(0), loaded(true),
+	params(params), samplerID(SamplerCache::Get().GetSampler(params.sampler))
+{
+	glErrorCall( glGenTextures(1, &rendererID) );
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D, rendererID);
+
+	UploadPixels(pixels);
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D, 0);
+}
+
+//Constructor (from an image with levels)
+Texture::Texture(const TextureImage& image, const TextureParams& params)
+	: rendererID(0), filePath(), localBuffer(nullptr),
+	width(0), height(0), bpp(0), format(TextureFormat::RGBA8), srgb(params.srgb), levelCount(1), baseLevel(0), loaded(true),
+	params(params), samplerID(SamplerCache::Get().GetSampler(params.sampler))
+{
+	glErrorCall( glGenTextures(1, &rendererID) );
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D, rendererID);
+
+	SetImage(image);
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D, 0);
+}
+
 //Destructor
 Texture::~Texture()
 {
+	if (UploadManager* uploads = UploadManager::TryGet())
+		uploads->Cancel(GL_TEXTURE_2D, rendererID);
+
+	GLStateCache::Get().OnDeleteTexture(rendererID);
 	glErrorCall(glDeleteTextures(1, &rendererID));
 }
 
@@ -40,12 +86,209 @@ Texture::~Texture()
 void Texture::Bind(unsigned int slot) const
 {
 	//Binding texture to the proper slot
-	glErrorCall(glActiveTexture(GL_TEXTURE0 + slot));
-	glErrorCall(glBindTexture(GL_TEXTURE_2D, rendererID));
+	GLStateCache::Get().ActiveTexture(slot);
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D, rendererID);
+	GLStateCache::Get().BindSampler(slot, samplerID);
 }
 
 
 void Texture::Unbind() const
 {
-	glErrorCall(glBindTexture(GL_TEXTURE_2D, 0));
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D, 0);
+}
+
+
+void Texture::SetData(int image_width, int image_height, const unsigned char* pixels)
+{
+	width = image_width;
+	height = image_height;
+	bpp = 4;
+	format = TextureFormat::RGBA8;
+	srgb = params.srgb;
+	loaded = true;
+
+	//Whatever was still queued for the old image is outdated
+	if (UploadManager* uploads = UploadManager::TryGet())
+		uploads->Cancel(GL_TEXTURE_2D, rendererID);
+
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D, rendererID);
+	if (baseLevel != 0)
+		SetBaseLevel(0);
+	UploadPixels(pixels);
 }
+
+
+bool Texture::SetImage(const TextureImage& image, int base_level)
+{
+	if ((int)image.levels.size() <= base_level)
+		return false;
+
+	if (!IsTextureFormatSupported(image.format))
+	{
+		std::cout << "ERROR::Texture.cpp::SetImage():: The driver can't sample " << GetTextureFormatName(image.format)
+			<< " textures ('" << filePath << "')" << std::endl;
+		return false;
+	}
+
+	width = image.width;
+	height = image.height;
+	bpp = image.format == TextureFormat::BC1 ? 3 : 4;
+	format = image.format;
+	srgb = params.srgb || image.srgb;
+	loaded = true;
+
+	if (UploadManager* uploads = UploadManager::TryGet())
+		uploads->Cancel(GL_TEXTURE_2D, rendererID);
+
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D, rendererID);
+	GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	//A lone RGBA8 level gets the chain the params ask for
+	if (!IsTextureFormatCompressed(format) && image.levels.size() == 1)
+	{
+		if (baseLevel != 0)
+			SetBaseLevel(0);
+		UploadPixels(image.levels[0].data());
+		return true;
+	}
+
+	//Compressed levels are a fraction of the RGBA8 size, they go up right away
+	SetLevelCount((int)image.levels.size());
+	if (baseLevel != base_level)
+		SetBaseLevel(base_level);
+	int levelWidth = std::max(1, width >> base_level), levelHeight = std::max(1, height >> base_level);
+	for (unsigned int level = base_level; level < image.levels.size(); level++)
+	{
+		if (IsTextureFormatCompressed(format))
+		{
+			glErrorCall( glCompressedTexImage2D(GL_TEXTURE_2D, level, GetTextureInternalFormat(format, srgb), levelWidth, levelHeight, 0,
+				(GLsizei)image.levels[level].size(), image.levels[level].data()) );
+		}
+		else
+		{
+			UploadLevel(level, levelWidth, levelHeight, image.levels[level].data());
+		}
+
+		levelWidth = std::max(1, levelWidth / 2);
+		levelHeight = std::max(1, levelHeight / 2);
+	}
+
+	return true;
+}
+
+
+void Texture::SetSampler(const SamplerState& sampler)
+{
+	params.sampler = sampler;
+	samplerID = SamplerCache::Get().GetSampler(sampler);
+}
+
+
+bool Texture::IsLoaded() const
+{
+	UploadManager* uploads = UploadManager::TryGet();
+	return loaded && !(uploads && uploads->IsPending(GL_TEXTURE_2D, rendererID));
+}
+
+
+unsigned int Texture::GetSize() const
+{
+	unsigned int size = 0;
+	for (int level = baseLevel; level < levelCount; level++)
+		size += (unsigned int)GetTextureLevelSize(format, std::max(1, width >> level), std::max(1, height >> level));
+	return size;
+}
+
+
+//Level 0 of the bound texture & the levels below it, as the params ask for
+void Texture::UploadPixels(const unsigned char* pixels)
+{
+	if (pixels && params.mipmaps == MipmapSource::CPU)
+	{
+		TextureImage image;
+		image.width = width;
+		image.height = height;
+		image.levels.emplace_back(pixels, pixels + width * height * 4);
+		MipGenerator::Generate(image, params.mipFilter, params.srgb);
+
+		SetLevelCount((int)image.levels.size());
+		int levelWidth = width, levelHeight = height;
+		for (unsigned int level = 0; level < image.levels.size(); level++)
+		{
+			UploadLevel(level, levelWidth, levelHeight, image.levels[level].data());
+			levelWidth = std::max(1, levelWidth / 2);
+			levelHeight = std::max(1, levelHeight / 2);
+		}
+		return;
+	}
+
+	//glGenerateMipmap only fills levels up to the max level, so that goes first
+	bool generate = pixels && params.mipmaps == MipmapSource::GPU;
+	SetLevelCount(generate ? MipGenerator::GetLevelCount(width, height) : 1);
+	UploadLevel(0, width, height, pixels, generate);
+}
+
+
+//Specifying a level of the bound texture (GL_SRGB8_ALPHA8 for sRGB, so glGenerateMipmap filters in linear light too),
+//large images go up through the upload manager over the next frames
+void Texture::UploadLevel(int level, int level_width, int level_height, const unsigned char* pixels, bool generate_mipmaps)
+{
+	//With an unpack buffer bound the pixel pointer would be read as an offset into it
+	GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	UploadManager* uploads = UploadManager::TryGet();
+	unsigned int size = level_width * level_height * 4;
+	if (uploads && pixels && size > UploadManager::directUploadSize)
+	{
+		glErrorCall( glTexImage2D(GL_TEXTURE_2D, level, GetTextureInternalFormat(format, srgb), level_width, level_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr) );
+		//Defining the chain right away keeps the texture complete until the upload manager regenerates it
+		if (generate_mipmaps)
+		{
+			glErrorCall( glGenerateMipmap(GL_TEXTURE_2D) );
+		}
+		uploads->UploadTexture(rendererID, level, 0, 0, level_width, level_height, pixels, generate_mipmaps);
+	}
+	else
+	{
+		glErrorCall( glTexImage2D(GL_TEXTURE_2D, level, GetTextureInternalFormat(format, srgb), level_width, level_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels) );
+		if (generate_mipmaps)
+		{
+			glErrorCall( glGenerateMipmap(GL_TEXTURE_2D) );
+		}
+	}
+}
+
+
+//Sampling stays within the levels that have data, so mipmapped samplers work on single level textures too
+void Texture::SetLevelCount(int level_count)
+{
+	levelCount = level_count;
+	glErrorCall( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level_count - 1) );
+}
+
+
+void Texture::SetBaseLevel(int level)
+{
+	baseLevel = level;
+	glErrorCall( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level) );
+}
+
+
+//Only the levels from the base level down count towards completeness, so the ones above it can be emptied (0x0)
+void Texture::SpecifyLevel(int level, const std::vector<unsigned char>* data)
+{
+	GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	int levelWidth = data ? std::max(1, width >> level) : 0;
+	int levelHeight = data ? std::max(1, height >> level) : 0;
+	if (IsTextureFormatCompressed(format))
+	{
+		glErrorCall( glCompressedTexImage2D(GL_TEXTURE_2D, level, GetTextureInternalFormat(format, srgb), levelWidth, levelHeight, 0,
+			data ? (GLsizei)data->size() : 0, data ? data->data() : nullptr) );
+	}
+	else
+	{
+		glErrorCall( glTexImage2D(GL_TEXTURE_2D, level, GetTextureInternalFormat(format, srgb), levelWidth, levelHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+			data ? data->data() : nullptr) );
+	}
+}
\ No newline at end of file
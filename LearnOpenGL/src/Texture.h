@@ -1,24 +1,84 @@
 #pragma once
 
 #include "Renderer.h"
+#include "TextureCompressor.h"
+#include "MipGenerator.h"
+#include "SamplerCache.h"
+
+
+//Where the levels below level 0 come from, images that bring their own (containers) keep them
+enum class MipmapSource
+{
+	None,		//Level 0 only
+	GPU,		//glGenerateMipmap once level 0 is up
+	CPU			//MipGenerator, before the upload
+};
+
+//How a texture is built from its image & how it is sampled
+struct TextureParams
+{
+	MipmapSource mipmaps = MipmapSource::None;
+	MipFilter mipFilter = MipFilter::Box;		//CPU mipmaps only
+	bool srgb = false;		//Colour is sRGB: stored in the sRGB formats (GL_SRGB8_ALPHA8, ...) & sampled as linear, mipmaps average it in linear light
+	SamplerState sampler;
+
+	uint32_t GetKey() const;
+};
 
 
 class Texture
 {
+	friend class AsyncTextureLoader;
+	friend class TextureStreamer;
+
 private:
 	unsigned int rendererID;
 	std::string filePath;
 	unsigned char* localBuffer;
 	int width, height, bpp;		//bpp = bits per pixel
+	TextureFormat format;
+	bool srgb;			//Stored in an sRGB format, the params or the image ask for it
+	int levelCount;		//Mip levels with data
+	int baseLevel;		//Finest level on the GPU, above 0 while a streamer holds the finer ones back
+	bool loaded;		//False while a loader still has to deliver the real image
+	TextureParams params;
+	unsigned int samplerID;		//Shared, owned by the SamplerCache
 
 public:
 	//Constructor & Destructor
-	Texture(const std::string& file_path);
+	Texture(const std::string& file_path, const TextureParams& params = TextureParams());		//.dds & .ktx are uploaded as they are, everything else is decoded to RGBA8
+	Texture(const TextureImage& image, const TextureParams& params = TextureParams());
+	Texture(int width, int height, const unsigned char* pixels, const TextureParams& params = TextureParams());	//RGBA8 texture from memory
 	~Texture();
 
-	void Bind(unsigned int slot = 0) const;
+	void Bind(unsigned int slot = 0) const;		//Binds the sampler to the same unit
 	void Unbind() const;
 
+	//Replacing the whole image (RGBA8), the texture object & its handle stay the same
+	void SetData(int image_width, int image_height, const unsigned char* pixels);
+	//Same for an image that may be compressed & have mip levels, false if the driver can't sample its format.
+	//Levels finer than base_level are left out & sampling starts below them
+	bool SetImage(const TextureImage& image, int base_level = 0);
+
+	//Filtering & wrapping, only the sampler changes
+	void SetSampler(const SamplerState& sampler);
+
 	inline int GetWidth() const { return width; };
 	inline int GetHeight() const { return height; };
+	inline unsigned int GetRendererID() const { return rendererID; };
+	inline TextureFormat GetFormat() const { return format; };
+	inline int GetLevelCount() const { return levelCount; };
+	inline int GetBaseLevel() const { return baseLevel; };
+	unsigned int GetSize() const;		//Bytes of GPU memory, the levels from the base level down
+	inline const TextureParams& GetParams() const { return params; };
+	inline const std::string& GetFilePath() const { return filePath; };
+	bool IsLoaded() const;		//False until both the loader & the upload manager are done with it
+
+private:
+	void UploadPixels(const unsigned char* pixels);
+	void UploadLevel(int level, int level_width, int level_height, const unsigned char* pixels, bool generate_mipmaps = false);
+	void SetLevelCount(int level_count);
+	void SetBaseLevel(int level);
+	//Streaming: one level of the bound texture straight to the GPU, or with nullptr its memory back to the driver
+	void SpecifyLevel(int level, const std::vector<unsigned char>* data);
 };
\ No newline at end of file
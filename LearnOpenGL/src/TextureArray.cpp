@@ -0,0 +1,144 @@
+#include "TextureArray.h"
+#include "GLStateCache.h"
+#include "stb_image/stb_image.h"
+
+#include <algorithm>
+#include <iostream>
+
+
+//Constructor
+TextureArray::TextureArray(int width, int height, int layer_capacity, const TextureParams& params)
+	: rendererID(0), width(width), height(height), layerCapacity(layer_capacity),
+	levelCount(params.mipmaps == MipmapSource::None ? 1 : MipGenerator::GetLevelCount(width, height)),
+	params(params), samplerID(SamplerCache::Get().GetSampler(params.sampler))
+{
+	glErrorCall( glGenTextures(1, &rendererID) );
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D_ARRAY, rendererID);
+	GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	//Every level of every layer exists from the start, unfilled layers are just undefined
+	for (int level = 0; level < levelCount; level++)
+	{
+		glErrorCall( glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GetTextureInternalFormat(TextureFormat::RGBA8, params.srgb), std::max(1, width >> level), std::max(1, height >> level),
+			layer_capacity, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr) );
+	}
+	glErrorCall( glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levelCount - 1) );
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+	//Handing out layer 0 first
+	for (int layer = layer_capacity - 1; layer >= 0; layer--)
+		freeLayers.push_back(layer);
+}
+
+//Destructor
+TextureArray::~TextureArray()
+{
+	GLStateCache::Get().OnDeleteTexture(rendererID);
+	glErrorCall( glDeleteTextures(1, &rendererID) );
+}
+
+
+void TextureArray::Bind(unsigned int slot) const
+{
+	GLStateCache::Get().ActiveTexture(slot);
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D_ARRAY, rendererID);
+	GLStateCache::Get().BindSampler(slot, samplerID);
+}
+
+
+void TextureArray::Unbind() const
+{
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+
+int TextureArray::AllocateLayer()
+{
+	if (freeLayers.empty())
+		return -1;
+
+	int layer = freeLayers.back();
+	freeLayers.pop_back();
+	return layer;
+}
+
+
+//The contents stay until the layer is handed out & filled again
+void TextureArray::FreeLayer(int layer)
+{
+	ASSERT(layer >= 0 && layer < layerCapacity);
+	ASSERT(std::find(freeLayers.begin(), freeLayers.end(), layer) == freeLayers.end());
+	freeLayers.push_back(layer);
+}
+
+
+int TextureArray::AddLayer(const unsigned char* pixels)
+{
+	int layer = AllocateLayer();
+	if (layer >= 0)
+		SetLayer(layer, pixels);
+	return layer;
+}
+
+
+int TextureArray::AddLayer(const std::string& file_path)
+{
+	int imageWidth = 0, imageHeight = 0, bpp = 0;
+	stbi_set_flip_vertically_on_load(1);
+	unsigned char* pixels = stbi_load(file_path.c_str(), &imageWidth, &imageHeight, &bpp, 4);
+	if (!pixels)
+	{
+		std::cout << "ERROR::TextureArray.cpp::AddLayer():: Failed to load '" << file_path << "'" << std::endl;
+		return -1;
+	}
+
+	int layer = -1;
+	if (imageWidth == width && imageHeight == height)
+		layer = AddLayer(pixels);
+	else
+		std::cout << "ERROR::TextureArray.cpp::AddLayer():: '" << file_path << "' is " << imageWidth << "x" << imageHeight
+			<< ", the layers are " << width << "x" << height << std::endl;
+
+	stbi_image_free(pixels);
+	return layer;
+}
+
+
+void TextureArray::SetLayer(int layer, const unsigned char* pixels)
+{
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D_ARRAY, rendererID);
+	GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	glErrorCall( glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels) );
+
+	if (params.mipmaps == MipmapSource::CPU)
+	{
+		//Only this layer's levels
+		std::vector<unsigned char> source(pixels, pixels + width * height * 4), next;
+		int levelWidth = width, levelHeight = height;
+		for (int level = 1; level < levelCount; level++)
+		{
+			MipGenerator::Downsample(source.data(), levelWidth, levelHeight, next, params.mipFilter, params.srgb);
+			levelWidth = std::max(1, levelWidth / 2);
+			levelHeight = std::max(1, levelHeight / 2);
+			glErrorCall( glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, levelWidth, levelHeight, 1, GL_RGBA, GL_UNSIGNED_BYTE, next.data()) );
+			source.swap(next);
+		}
+	}
+	else if (params.mipmaps == MipmapSource::GPU)
+	{
+		//Regenerates the levels of every layer, CPU mipmaps are cheaper when layers are filled one by one at runtime
+		glErrorCall( glGenerateMipmap(GL_TEXTURE_2D_ARRAY) );
+	}
+
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+
+unsigned int TextureArray::GetSize() const
+{
+	unsigned int size = 0;
+	for (int level = 0; level < levelCount; level++)
+		size += (unsigned int)GetTextureLevelSize(TextureFormat::RGBA8, std::max(1, width >> level), std::max(1, height >> level)) * layerCapacity;
+	return size;
+}
\ No newline at end of file
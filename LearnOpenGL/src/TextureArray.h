@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Texture.h"
+
+
+/*
+GL_TEXTURE_2D_ARRAY of RGBA8 layers that all share one size, so objects with different textures
+can be drawn together: the texture stays bound & every vertex or instance picks its layer.
+Layers are handed out from a free list, freed layers are reused before untouched ones.
+The layer count is fixed at creation, growing would mean copying every layer into a new array.
+*/
+class TextureArray
+{
+private:
+	unsigned int rendererID;
+	int width, height;		//Of every layer
+	int layerCapacity;
+	int levelCount;
+	TextureParams params;
+	unsigned int samplerID;		//Shared, owned by the SamplerCache
+	std::vector<int> freeLayers;		//Next free layer at the back
+
+public:
+	//Constructor & Destructor
+	TextureArray(int width, int height, int layer_capacity, const TextureParams& params = TextureParams());
+	~TextureArray();
+
+	void Bind(unsigned int slot = 0) const;		//Binds the sampler to the same unit
+	void Unbind() const;
+
+	//-1 once every layer is taken
+	int AllocateLayer();
+	void FreeLayer(int layer);
+
+	//Allocating a layer & filling it, -1 if the array is full (or the file can't be used)
+	int AddLayer(const unsigned char* pixels);
+	int AddLayer(const std::string& file_path);		//Has to be the size of the layers
+
+	//RGBA8 pixels of the size of the layers, the mip levels below are made as the params ask for
+	void SetLayer(int layer, const unsigned char* pixels);
+
+	inline int GetWidth() const { return width; };
+	inline int GetHeight() const { return height; };
+	inline unsigned int GetRendererID() const { return rendererID; };
+	inline int GetLayerCapacity() const { return layerCapacity; };
+	inline int GetLayerCount() const { return layerCapacity - (int)freeLayers.size(); };		//Allocated
+	inline int GetLevelCount() const { return levelCount; };
+	unsigned int GetSize() const;		//Bytes of GPU memory, every layer & level
+};
\ No newline at end of file
@@ -0,0 +1,361 @@
+#include "TextureAtlas.h"
+#include "stb_image/stb_image.h"
+
+#include <SOIL2.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+
+//  SkylinePacker   //
+//Constructor
+SkylinePacker::SkylinePacker(int width, int height)
+	: width(width), height(height), usedArea(0)
+{
+	skyline.push_back({ 0, 0, width });
+}
+
+
+bool SkylinePacker::Insert(int rect_width, int rect_height, int& x, int& y)
+{
+	int bestTop = height + 1, bestWidth = width + 1;
+	size_t bestIndex = skyline.size();
+
+	for (size_t i = 0; i < skyline.size(); i++)
+	{
+		int bottom = Fit(i, rect_width, rect_height);
+		if (bottom < 0)
+			continue;
+
+		int top = bottom + rect_height;
+		if (top < bestTop || (top == bestTop && skyline[i].width < bestWidth))
+		{
+			bestTop = top;
+			bestWidth = skyline[i].width;
+			bestIndex = i;
+			y = bottom;
+		}
+	}
+
+	if (bestIndex == skyline.size())
+		return false;
+
+	x = skyline[bestIndex].x;
+	AddLevel(bestIndex, x, y, rect_width, rect_height);
+	usedArea += (unsigned long long)rect_width * rect_height;
+	return true;
+}
+
+
+//The rectangle rests on the highest segment it spans
+int SkylinePacker::Fit(size_t index, int rect_width, int rect_height) const
+{
+	if (skyline[index].x + rect_width > width)
+		return -1;
+
+	int bottom = skyline[index].y;
+	int widthLeft = rect_width;
+	for (size_t i = index; widthLeft > 0; i++)
+	{
+		bottom = std::max(bottom, skyline[i].y);
+		if (bottom + rect_height > height)
+			return -1;
+		widthLeft -= skyline[i].width;
+	}
+	return bottom;
+}
+
+
+//A new segment on top of the rectangle, the ones it covers are cut back & equal neighbours merged
+void SkylinePacker::AddLevel(size_t index, int x, int y, int rect_width, int rect_height)
+{
+	skyline.insert(skyline.begin() + index, { x, y + rect_height, rect_width });
+
+	for (size_t i = index + 1; i < skyline.size();)
+	{
+		int covered = skyline[i - 1].x + skyline[i - 1].width - skyline[i].x;
+		if (covered <= 0)
+			break;
+
+		skyline[i].x += covered;
+		skyline[i].width -= covered;
+		if (skyline[i].width > 0)
+			break;
+		skyline.erase(skyline.begin() + i);
+	}
+
+	for (size_t i = 0; i + 1 < skyline.size();)
+	{
+		if (skyline[i].y == skyline[i + 1].y)
+		{
+			skyline[i].width += skyline[i + 1].width;
+			skyline.erase(skyline.begin() + i + 1);
+		}
+		else
+		{
+			i++;
+		}
+	}
+}
+
+
+//  TextureAtlas    //
+//Constructors
+TextureAtlas::TextureAtlas()
+{
+}
+
+TextureAtlas::TextureAtlas(const Settings& settings)
+	: settings(settings)
+{
+}
+
+
+void TextureAtlas::Add(const std::string& name, int width, int height, const unsigned char* pixels)
+{
+	images.push_back({ name, width, height, std::vector<unsigned char>(pixels, pixels + width * height * 4) });
+}
+
+
+bool TextureAtlas::AddFile(const std::string& file_path)
+{
+	int width = 0, height = 0, bpp = 0;
+	stbi_set_flip_vertically_on_load(1);
+	unsigned char* pixels = stbi_load(file_path.c_str(), &width, &height, &bpp, 4);
+	if (!pixels)
+	{
+		std::cout << "ERROR::TextureAtlas.cpp::AddFile():: Failed to load '" << file_path << "'" << std::endl;
+		return false;
+	}
+
+	Add(file_path, width, height, pixels);
+	stbi_image_free(pixels);
+	return true;
+}
+
+
+bool TextureAtlas::Build()
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	int padding = settings.padding;
+
+	//Tall images first leave the flattest skyline behind
+	std::vector<Image*> order;
+	for (Image& image : images)
+		order.push_back(&image);
+	std::stable_sort(order.begin(), order.end(), [](const Image* a, const Image* b)
+		{ return a->height != b->height ? a->height > b->height : a->width > b->width; });
+
+	if (!textures.empty() && pages.empty())
+	{
+		std::cout << "ERROR::TextureAtlas.cpp::Build():: A loaded atlas can't take more images, its pages are only on the GPU" << std::endl;
+		return false;
+	}
+
+	//Everything is checked before packing, a failed build leaves the atlas as it was
+	for (const Image* image : order)
+	{
+		if (image->width + padding * 2 > settings.pageSize || image->height + padding * 2 > settings.pageSize)
+		{
+			std::cout << "ERROR::TextureAtlas.cpp::Build():: '" << image->name << "' (" << image->width << "x" << image->height
+				<< ") doesn't fit in a " << settings.pageSize << " page" << std::endl;
+			return false;
+		}
+	}
+
+	for (Image* image : order)
+	{
+		int paddedWidth = image->width + padding * 2, paddedHeight = image->height + padding * 2;
+
+		//The first page with room, or a new one
+		AtlasRegion region = { -1, 0, 0, image->width, image->height, glm::vec4(0.0f) };
+		for (size_t page = 0; page < packers.size() && region.page < 0; page++)
+		{
+			if (packers[page].Insert(paddedWidth, paddedHeight, region.x, region.y))
+				region.page = (int)page;
+		}
+		if (region.page < 0)
+		{
+			packers.emplace_back(settings.pageSize, settings.pageSize);
+			packers.back().Insert(paddedWidth, paddedHeight, region.x, region.y);
+			region.page = (int)packers.size() - 1;
+		}
+
+		region.x += padding;
+		region.y += padding;
+		float size = (float)settings.pageSize;
+		region.uv = glm::vec4(region.x / size, region.y / size, (region.x + region.width) / size, (region.y + region.height) / size);
+		regions[image->name] = region;
+
+		if (pages.size() < packers.size())
+			pages.emplace_back(settings.pageSize * settings.pageSize * 4, 0);
+		Blit(*image, region);
+	}
+
+	stats.imageCount = (unsigned int)regions.size();
+	stats.pageCount = (unsigned int)pages.size();
+	UpdateEfficiency();
+	stats.packTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	images.clear();
+	return true;
+}
+
+
+void TextureAtlas::CreateTextures(const TextureParams& params)
+{
+	textures.clear();
+	for (const std::vector<unsigned char>& page : pages)
+		textures.push_back(std::make_unique<Texture>(settings.pageSize, settings.pageSize, page.data(), params));
+}
+
+
+/*
+Table layout, little endian:
+	"ATLS", version, page size, padding, page count, region count		(u32 each)
+	per region: name length (u16), name, page, x, y, width, height (u16 each), uv (4 floats)
+*/
+bool TextureAtlas::Save(const std::string& base_path) const
+{
+	//PNGs are stored top row first
+	std::vector<unsigned char> flipped(settings.pageSize * settings.pageSize * 4);
+	unsigned int rowSize = settings.pageSize * 4;
+	for (size_t page = 0; page < pages.size(); page++)
+	{
+		for (int y = 0; y < settings.pageSize; y++)
+			std::memcpy(&flipped[y * rowSize], &pages[page][(settings.pageSize - 1 - y) * rowSize], rowSize);
+
+		std::string pagePath = base_path + "_" + std::to_string(page) + ".png";
+		if (!SOIL_save_image(pagePath.c_str(), SOIL_SAVE_TYPE_PNG, settings.pageSize, settings.pageSize, 4, flipped.data()))
+		{
+			std::cout << "ERROR::TextureAtlas.cpp::Save():: Failed to write '" << pagePath << "'" << std::endl;
+			return false;
+		}
+	}
+
+	std::ofstream file(base_path + ".atlas", std::ios::binary);
+	if (!file)
+	{
+		std::cout << "ERROR::TextureAtlas.cpp::Save():: Failed to write '" << base_path << ".atlas'" << std::endl;
+		return false;
+	}
+
+	uint32_t header[6] = { 0x534C5441, fileVersion, (uint32_t)settings.pageSize, (uint32_t)settings.padding,
+		(uint32_t)pages.size(), (uint32_t)regions.size() };
+	file.write((const char*)header, sizeof(header));
+
+	for (const auto& entry : regions)
+	{
+		const AtlasRegion& region = entry.second;
+		uint16_t nameLength = (uint16_t)entry.first.size();
+		uint16_t rect[5] = { (uint16_t)region.page, (uint16_t)region.x, (uint16_t)region.y, (uint16_t)region.width, (uint16_t)region.height };
+		file.write((const char*)&nameLength, sizeof(nameLength));
+		file.write(entry.first.data(), nameLength);
+		file.write((const char*)rect, sizeof(rect));
+		file.write((const char*)&region.uv, sizeof(float) * 4);
+	}
+
+	return (bool)file;
+}
+
+
+bool TextureAtlas::Load(const std::string& base_path, const TextureParams& params)
+{
+	std::ifstream file(base_path + ".atlas", std::ios::binary);
+	uint32_t header[6] = {};
+	if (!file.read((char*)header, sizeof(header)) || header[0] != 0x534C5441 || header[1] != fileVersion)
+	{
+		std::cout << "ERROR::TextureAtlas.cpp::Load():: '" << base_path << ".atlas' is missing or not an atlas table" << std::endl;
+		return false;
+	}
+
+	settings.pageSize = (int)header[2];
+	settings.padding = (int)header[3];
+	regions.clear();
+	pages.clear();
+	packers.clear();
+
+	for (uint32_t i = 0; i < header[5]; i++)
+	{
+		uint16_t nameLength = 0;
+		uint16_t rect[5];
+		AtlasRegion region;
+		file.read((char*)&nameLength, sizeof(nameLength));
+		std::string name(nameLength, '\0');
+		file.read(&name[0], nameLength);
+		file.read((char*)rect, sizeof(rect));
+		file.read((char*)&region.uv, sizeof(float) * 4);
+		if (!file)
+		{
+			std::cout << "ERROR::TextureAtlas.cpp::Load():: '" << base_path << ".atlas' is truncated" << std::endl;
+			return false;
+		}
+
+		region.page = rect[0];
+		region.x = rect[1];
+		region.y = rect[2];
+		region.width = rect[3];
+		region.height = rect[4];
+		regions[name] = region;
+	}
+
+	textures.clear();
+	for (uint32_t page = 0; page < header[4]; page++)
+		textures.push_back(std::make_unique<Texture>(base_path + "_" + std::to_string(page) + ".png", params));
+
+	stats.imageCount = (unsigned int)regions.size();
+	stats.pageCount = header[4];
+	stats.packTime = 0.0f;
+	UpdateEfficiency();
+	return true;
+}
+
+
+const AtlasRegion* TextureAtlas::GetRegion(const std::string& name) const
+{
+	auto it = regions.find(name);
+	return it != regions.end() ? &it->second : nullptr;
+}
+
+
+glm::vec4 TextureAtlas::RemapUV(const AtlasRegion& region, const glm::vec4& uv)
+{
+	glm::vec2 min(region.uv.x, region.uv.y), size(region.uv.z - region.uv.x, region.uv.w - region.uv.y);
+	return glm::vec4(min + glm::vec2(uv.x, uv.y) * size, min + glm::vec2(uv.z, uv.w) * size);
+}
+
+
+//Copying the image into its page, with bleed the padding around it repeats the nearest edge texel
+void TextureAtlas::Blit(const Image& image, const AtlasRegion& region)
+{
+	std::vector<unsigned char>& page = pages[region.page];
+	int border = settings.bleed ? settings.padding : 0;
+
+	for (int y = -border; y < image.height + border; y++)
+	{
+		int sourceY = std::min(std::max(y, 0), image.height - 1);
+		unsigned char* row = &page[((region.y + y) * settings.pageSize + region.x) * 4];
+		const unsigned char* sourceRow = &image.pixels[sourceY * image.width * 4];
+
+		std::memcpy(row, sourceRow, image.width * 4);
+		for (int x = 1; x <= border; x++)
+		{
+			std::memcpy(row - x * 4, sourceRow, 4);
+			std::memcpy(row + (image.width - 1 + x) * 4, sourceRow + (image.width - 1) * 4, 4);
+		}
+	}
+}
+
+
+void TextureAtlas::UpdateEfficiency()
+{
+	unsigned long long imageArea = 0;
+	for (const auto& entry : regions)
+		imageArea += (unsigned long long)entry.second.width * entry.second.height;
+
+	float pageArea = (float)settings.pageSize * settings.pageSize * stats.pageCount;
+	stats.efficiency = pageArea > 0.0f ? imageArea / pageArea : 0.0f;
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Texture.h"
+
+
+//Skyline bin packer: the top edge of everything placed so far is a list of segments,
+//every rectangle goes where its top ends up lowest (bottom-left), ties go to the narrowest segment
+class SkylinePacker
+{
+private:
+	struct Segment
+	{
+		int x, y, width;
+	};
+
+	int width, height;
+	std::vector<Segment> skyline;		//Left to right, covers the whole width
+	unsigned long long usedArea;
+
+public:
+	//Constructor
+	SkylinePacker(int width, int height);
+
+	bool Insert(int rect_width, int rect_height, int& x, int& y);		//False if it doesn't fit anymore
+
+	inline float GetOccupancy() const { return (float)usedArea / ((float)width * height); };
+
+private:
+	int Fit(size_t index, int rect_width, int rect_height) const;		//Bottom of the rectangle placed at segment index, -1 if it doesn't fit
+	void AddLevel(size_t index, int x, int y, int rect_width, int rect_height);
+};
+
+
+//Where an image ended up in an atlas
+struct AtlasRegion
+{
+	int page;
+	int x, y, width, height;		//Texels, without the padding
+	glm::vec4 uv;		//Min u, min v, max u, max v (the layout BatchRenderer::SubmitQuad takes)
+};
+
+
+/*
+Packs many small RGBA8 images into a few large pages, so sprites that used to need their own texture
+(& with it their own draw, or a slot of a batch) share one.
+Every image gets padding around it, with bleed the padding repeats its edge texels so bilinear filtering
+near the edge never picks up a neighbour.
+Pages are kept bottom row first like everything stb_image loads with flipping, so v grows upwards as in GL.
+Offline, Save() writes every page as <base>_<page>.png next to a binary UV table <base>.atlas, Load() reads them back.
+*/
+class TextureAtlas
+{
+public:
+	struct Settings
+	{
+		int pageSize = 2048;
+		int padding = 2;		//Texels around every image
+		bool bleed = true;
+	};
+
+	struct Stats
+	{
+		unsigned int imageCount = 0;
+		unsigned int pageCount = 0;
+		float efficiency = 0.0f;		//Area of the images / area of all pages
+		float packTime = 0.0f;			//ms for packing & composing the pages
+	};
+
+private:
+	struct Image
+	{
+		std::string name;
+		int width, height;
+		std::vector<unsigned char> pixels;
+	};
+
+	static const uint32_t fileVersion = 1;
+
+	Settings settings;
+	std::vector<Image> images;		//Added, waiting for Build()
+	std::unordered_map<std::string, AtlasRegion> regions;
+	std::vector<std::vector<unsigned char>> pages;		//RGBA8, empty after Load()
+	std::vector<SkylinePacker> packers;		//One per page, later builds fill what is left of them
+	std::vector<std::unique_ptr<Texture>> textures;
+	Stats stats;
+
+public:
+	//Constructors
+	TextureAtlas();
+	TextureAtlas(const Settings& settings);
+
+	//RGBA8, bottom row first
+	void Add(const std::string& name, int width, int height, const unsigned char* pixels);
+	bool AddFile(const std::string& file_path);		//Named by its path
+
+	//Packs everything added since the last build (tallest first) around the regions already placed,
+	//false if an image is larger than a page or the atlas was loaded (its pages are only on the GPU)
+	bool Build();
+	//Pages -> textures, sprites draw with GetTexture(region.page)
+	void CreateTextures(const TextureParams& params = TextureParams());
+
+	bool Save(const std::string& base_path) const;
+	bool Load(const std::string& base_path, const TextureParams& params = TextureParams());
+
+	const AtlasRegion* GetRegion(const std::string& name) const;		//nullptr if it isn't in the atlas
+	//UVs within the image (0 - 1) -> UVs within its page
+	static glm::vec4 RemapUV(const AtlasRegion& region, const glm::vec4& uv = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+
+	inline const Texture* GetTexture(int page) const { return textures[page].get(); };
+	inline unsigned int GetPageCount() const { return (unsigned int)std::max(pages.size(), textures.size()); };
+	inline const Settings& GetSettings() const { return settings; };
+	inline const Stats& GetStats() const { return stats; };
+
+private:
+	void Blit(const Image& image, const AtlasRegion& region);
+	void UpdateEfficiency();
+};
\ No newline at end of file
@@ -0,0 +1,794 @@
+#include "TextureCompressor.h"
+#include "Renderer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+//SOIL2's DXT encoder & DDS structures, it is built as C
+extern "C"
+{
+#include "image_DXT.h"
+}
+
+
+static_assert(sizeof(DDS_header) == 128, "DDS_header doesn't match the file layout");
+static_assert(sizeof(DDS_HEADER_DXT10) == 20, "DDS_HEADER_DXT10 doesn't match the file layout");
+
+static uint32_t MakeFourCC(const char* code)
+{
+	return (uint32_t)code[0] | ((uint32_t)code[1] << 8) | ((uint32_t)code[2] << 16) | ((uint32_t)code[3] << 24);
+}
+
+//Largest width & height a container may declare
+static std::atomic<int> maxDimension(16384);
+
+static bool IsValidDimension(uint32_t width, uint32_t height)
+{
+	return width > 0 && height > 0 && width <= (uint32_t)maxDimension && height <= (uint32_t)maxDimension;
+}
+
+//Bytes between the read position & the end, so a header can't ask for more than the file holds
+static uint64_t GetRemainingSize(std::ifstream& file)
+{
+	std::streampos position = file.tellg();
+	file.seekg(0, std::ios::end);
+	std::streampos end = file.tellg();
+	file.seekg(position);
+	return position >= 0 && end > position ? (uint64_t)(end - position) : 0;
+}
+
+static const unsigned char ktxIdentifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+static const uint32_t ktxEndianness = 0x04030201;
+
+struct KTXHeader
+{
+	uint32_t endianness;
+	uint32_t glType;
+	uint32_t glTypeSize;
+	uint32_t glFormat;
+	uint32_t glInternalFormat;
+	uint32_t glBaseInternalFormat;
+	uint32_t pixelWidth;
+	uint32_t pixelHeight;
+	uint32_t pixelDepth;
+	uint32_t numberOfArrayElements;
+	uint32_t numberOfFaces;
+	uint32_t numberOfMipmapLevels;
+	uint32_t bytesOfKeyValueData;
+};
+
+
+//  Formats //
+const char* GetTextureFormatName(TextureFormat format)
+{
+	switch (format)
+	{
+		case TextureFormat::RGBA8:	return "RGBA8";
+		case TextureFormat::BC1:	return "BC1";
+		case TextureFormat::BC3:	return "BC3";
+		case TextureFormat::BC7:	return "BC7";
+		default:					return "";
+	}
+}
+
+
+unsigned int GetTextureInternalFormat(TextureFormat format, bool srgb)
+{
+	switch (format)
+	{
+		case TextureFormat::BC1:	return srgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+		case TextureFormat::BC3:	return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		case TextureFormat::BC7:	return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+		default:					return srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+	}
+}
+
+
+bool IsTextureFormatCompressed(TextureFormat format)
+{
+	return format != TextureFormat::RGBA8;
+}
+
+
+bool IsTextureFormatSupported(TextureFormat format)
+{
+	switch (format)
+	{
+		case TextureFormat::BC1:
+		case TextureFormat::BC3:	return GLEW_EXT_texture_compression_s3tc != 0;
+		case TextureFormat::BC7:	return GLEW_VERSION_4_2 || GLEW_ARB_texture_compression_bptc;
+		default:					return true;
+	}
+}
+
+
+size_t GetTextureLevelSize(TextureFormat format, int width, int height)
+{
+	if (!IsTextureFormatCompressed(format))
+		return (size_t)((uint64_t)width * height * 4);
+
+	uint64_t blocks = (uint64_t)((width + 3) / 4) * ((height + 3) / 4);
+	return (size_t)(blocks * (format == TextureFormat::BC1 ? 8 : 16));
+}
+
+
+unsigned int TextureImage::GetSize() const
+{
+	unsigned int size = 0;
+	for (const std::vector<unsigned char>& level : levels)
+		size += (unsigned int)level.size();
+	return size;
+}
+
+
+//  Blocks  //
+//The pixels under one 4x4 block, those past the edge of the image are left out of the error
+struct PixelBlock
+{
+	unsigned char rgba[16][4];
+	bool valid[16];
+};
+
+static void GatherBlock(const unsigned char* rows, int width, int row_count, int block_x, PixelBlock& block)
+{
+	for (int i = 0; i < 16; i++)
+	{
+		int x = std::min(block_x * 4 + i % 4, width - 1);
+		int y = std::min(i / 4, row_count - 1);
+		std::memcpy(block.rgba[i], rows + (y * width + x) * 4, 4);
+		block.valid[i] = block_x * 4 + i % 4 < width && i / 4 < row_count;
+	}
+}
+
+
+//Colour endpoints are RGB 5:6:5, the palette holds them & 2 points between them (or 1 & black in the 3 colour mode of BC1)
+static unsigned short PackRGB565(const float* color)
+{
+	int r = (int)(std::min(std::max(color[0], 0.0f), 255.0f) * 31.0f / 255.0f + 0.5f);
+	int g = (int)(std::min(std::max(color[1], 0.0f), 255.0f) * 63.0f / 255.0f + 0.5f);
+	int b = (int)(std::min(std::max(color[2], 0.0f), 255.0f) * 31.0f / 255.0f + 0.5f);
+	return (unsigned short)((r << 11) | (g << 5) | b);
+}
+
+static void UnpackRGB565(unsigned short packed, int* color)
+{
+	int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+	color[0] = (r << 3) | (r >> 2);
+	color[1] = (g << 2) | (g >> 4);
+	color[2] = (b << 3) | (b >> 2);
+}
+
+static void GetColorPalette(unsigned short c0, unsigned short c1, bool four_colors, int palette[4][3])
+{
+	UnpackRGB565(c0, palette[0]);
+	UnpackRGB565(c1, palette[1]);
+	for (int i = 0; i < 3; i++)
+	{
+		if (four_colors)
+		{
+			palette[2][i] = (2 * palette[0][i] + palette[1][i]) / 3;
+			palette[3][i] = (palette[0][i] + 2 * palette[1][i]) / 3;
+		}
+		else
+		{
+			palette[2][i] = (palette[0][i] + palette[1][i]) / 2;
+			palette[3][i] = 0;
+		}
+	}
+}
+
+static unsigned int ColorDistance(const unsigned char* pixel, const int* color)
+{
+	int r = pixel[0] - color[0], g = pixel[1] - color[1], b = pixel[2] - color[2];
+	return r * r + g * g + b * b;
+}
+
+//BC3 always decodes its colour in the 4 colour mode, BC1 only while colour 0 > colour 1
+static double GetColorBlockError(const PixelBlock& block, const unsigned char* compressed, bool always_four_colors)
+{
+	unsigned short c0 = compressed[0] | (compressed[1] << 8), c1 = compressed[2] | (compressed[3] << 8);
+	int palette[4][3];
+	GetColorPalette(c0, c1, always_four_colors || c0 > c1, palette);
+
+	double error = 0.0;
+	for (int i = 0; i < 16; i++)
+	{
+		int index = (compressed[4 + i / 4] >> ((i % 4) * 2)) & 3;
+		if (block.valid[i])
+			error += ColorDistance(block.rgba[i], palette[index]);
+	}
+	return error;
+}
+
+//Least squares endpoints for the current indices, then the indices for the new endpoints, for as long as the error goes down
+static void RefineColorBlock(const PixelBlock& block, unsigned char* compressed, bool always_four_colors)
+{
+	double bestError = GetColorBlockError(block, compressed, always_four_colors);
+
+	for (int iteration = 0; iteration < 4 && bestError > 0.0; iteration++)
+	{
+		unsigned short c0 = compressed[0] | (compressed[1] << 8), c1 = compressed[2] | (compressed[3] << 8);
+		bool fourColors = always_four_colors || c0 > c1;
+		const float weights4[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };		//Share of colour 0 per index
+		const float weights3[4] = { 1.0f, 0.0f, 0.5f, 0.5f };
+
+		float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+		float ax[3] = { 0.0f, 0.0f, 0.0f }, bx[3] = { 0.0f, 0.0f, 0.0f };
+		for (int i = 0; i < 16; i++)
+		{
+			if (!block.valid[i])
+				continue;
+
+			int index = (compressed[4 + i / 4] >> ((i % 4) * 2)) & 3;
+			float a = fourColors ? weights4[index] : weights3[index];
+			float b = 1.0f - a;
+			aa += a * a;
+			ab += a * b;
+			bb += b * b;
+			for (int c = 0; c < 3; c++)
+			{
+				ax[c] += a * block.rgba[i][c];
+				bx[c] += b * block.rgba[i][c];
+			}
+		}
+
+		//Every pixel on one index, the fit is already as good as it gets
+		float determinant = aa * bb - ab * ab;
+		if (std::fabs(determinant) < 1e-6f)
+			break;
+
+		float end0[3], end1[3];
+		for (int c = 0; c < 3; c++)
+		{
+			end0[c] = (ax[c] * bb - bx[c] * ab) / determinant;
+			end1[c] = (bx[c] * aa - ax[c] * ab) / determinant;
+		}
+
+		//Colour 0 > colour 1 keeps BC1 in the opaque 4 colour mode
+		unsigned short e0 = PackRGB565(end0), e1 = PackRGB565(end1);
+		if (e0 < e1)
+			std::swap(e0, e1);
+
+		int palette[4][3];
+		GetColorPalette(e0, e1, true, palette);
+		int paletteSize = e0 == e1 ? 1 : 4;		//Equal endpoints would be the 3 colour mode in BC1, so only colour 0 is used
+
+		unsigned char candidate[8] = { (unsigned char)(e0 & 255), (unsigned char)(e0 >> 8), (unsigned char)(e1 & 255), (unsigned char)(e1 >> 8), 0, 0, 0, 0 };
+		double error = 0.0;
+		for (int i = 0; i < 16; i++)
+		{
+			unsigned int best = UINT_MAX;
+			int bestIndex = 0;
+			for (int index = 0; index < paletteSize; index++)
+			{
+				unsigned int distance = ColorDistance(block.rgba[i], palette[index]);
+				if (distance < best)
+				{
+					best = distance;
+					bestIndex = index;
+				}
+			}
+
+			candidate[4 + i / 4] |= bestIndex << ((i % 4) * 2);
+			if (block.valid[i])
+				error += best;
+		}
+
+		if (error >= bestError)
+			break;
+
+		bestError = error;
+		std::memcpy(compressed, candidate, 8);
+	}
+}
+
+
+//Alpha endpoints are 8 bit, 8 entry palette if alpha 0 > alpha 1, otherwise 6 entries plus 0 & 255
+static void GetAlphaPalette(int a0, int a1, int palette[8])
+{
+	palette[0] = a0;
+	palette[1] = a1;
+	if (a0 > a1)
+	{
+		for (int i = 1; i < 7; i++)
+			palette[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+	}
+	else
+	{
+		for (int i = 1; i < 5; i++)
+			palette[i + 1] = ((5 - i) * a0 + i * a1) / 5;
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+}
+
+static uint64_t GetAlphaIndices(const unsigned char* compressed)
+{
+	uint64_t bits = 0;
+	for (int i = 0; i < 6; i++)
+		bits |= (uint64_t)compressed[2 + i] << (i * 8);
+	return bits;
+}
+
+static double GetAlphaBlockError(const PixelBlock& block, const unsigned char* compressed)
+{
+	int palette[8];
+	GetAlphaPalette(compressed[0], compressed[1], palette);
+
+	uint64_t indices = GetAlphaIndices(compressed);
+	double error = 0.0;
+	for (int i = 0; i < 16; i++)
+	{
+		int difference = block.rgba[i][3] - palette[(indices >> (i * 3)) & 7];
+		if (block.valid[i])
+			error += difference * difference;
+	}
+	return error;
+}
+
+//The encoder truncates towards alpha 1, picking the nearest entry instead never makes it worse
+static void RefineAlphaBlock(const PixelBlock& block, unsigned char* compressed)
+{
+	int palette[8];
+	GetAlphaPalette(compressed[0], compressed[1], palette);
+
+	uint64_t indices = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		int best = INT_MAX;
+		int bestIndex = 0;
+		for (int index = 0; index < 8; index++)
+		{
+			int difference = std::abs(block.rgba[i][3] - palette[index]);
+			if (difference < best)
+			{
+				best = difference;
+				bestIndex = index;
+			}
+		}
+		indices |= (uint64_t)bestIndex << (i * 3);
+	}
+
+	for (int i = 0; i < 6; i++)
+		compressed[2 + i] = (unsigned char)(indices >> (i * 8));
+}
+
+
+//  Encoding    //
+TextureImage TextureCompressor::Encode(const TextureImage& source, TextureFormat format, Quality quality,
+	unsigned int thread_count, EncodeStats* stats)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	TextureImage image;
+	image.format = format;
+	image.width = source.width;
+	image.height = source.height;
+	image.srgb = source.srgb;
+
+	if (format == TextureFormat::BC7)
+	{
+		std::cout << "ERROR::TextureCompressor.cpp::Encode():: BC7 can only be loaded, not encoded" << std::endl;
+		return image;
+	}
+	if (source.format != TextureFormat::RGBA8 || source.levels.empty())
+	{
+		std::cout << "ERROR::TextureCompressor.cpp::Encode():: Only RGBA8 images can be encoded" << std::endl;
+		return image;
+	}
+
+	if (thread_count == 0)
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+	int levelWidth = source.width, levelHeight = source.height;
+	double squaredError = 0.0;
+	for (const std::vector<unsigned char>& level : source.levels)
+	{
+		image.levels.emplace_back();
+		if (format == TextureFormat::RGBA8)
+			image.levels.back() = level;
+		else
+			EncodeLevel(level.data(), levelWidth, levelHeight, format, quality, thread_count, image.levels.back(),
+				image.levels.size() == 1 && stats ? &squaredError : nullptr);
+
+		levelWidth = std::max(1, levelWidth / 2);
+		levelHeight = std::max(1, levelHeight / 2);
+	}
+
+	if (stats)
+	{
+		//BC1 drops alpha, so its error is over RGB only
+		int channels = format == TextureFormat::BC1 ? 3 : 4;
+		stats->time = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		stats->rmse = (float)std::sqrt(squaredError / ((double)source.width * source.height * channels));
+	}
+
+	return image;
+}
+
+
+//Block rows are independent of each other, the threads take them one at a time
+void TextureCompressor::EncodeLevel(const unsigned char* pixels, int width, int height, TextureFormat format, Quality quality,
+	unsigned int thread_count, std::vector<unsigned char>& out, double* squared_error)
+{
+	bool bc3 = format == TextureFormat::BC3;
+	unsigned int blockSize = bc3 ? 16 : 8;
+	int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+	out.resize(blocksX * blocksY * blockSize);
+
+	thread_count = std::min(thread_count, (unsigned int)blocksY);
+	std::atomic<int> nextRow(0);
+	std::vector<double> errors(thread_count, 0.0);
+
+	auto encodeRows = [&](unsigned int thread)
+	{
+		int row;
+		while ((row = nextRow++) < blocksY)
+		{
+			const unsigned char* rows = pixels + (size_t)row * 4 * width * 4;
+			int rowCount = std::min(4, height - row * 4);
+
+			int size = 0;
+			unsigned char* encoded = bc3 ? convert_image_to_DXT5(rows, width, rowCount, 4, &size) : convert_image_to_DXT1(rows, width, rowCount, 4, &size);
+			if (!encoded)
+				continue;
+
+			unsigned char* blocks = &out[row * blocksX * blockSize];
+			std::memcpy(blocks, encoded, size);
+			free(encoded);
+
+			if (quality == Quality::Fast && !squared_error)
+				continue;
+
+			for (int x = 0; x < blocksX; x++)
+			{
+				PixelBlock block;
+				GatherBlock(rows, width, rowCount, x, block);
+
+				//BC3 puts its alpha block in front of the colour block
+				unsigned char* alpha = blocks + x * blockSize;
+				unsigned char* color = bc3 ? alpha + 8 : alpha;
+				if (quality == Quality::High)
+				{
+					RefineColorBlock(block, color, bc3);
+					if (bc3)
+						RefineAlphaBlock(block, alpha);
+				}
+
+				if (squared_error)
+					errors[thread] += GetColorBlockError(block, color, bc3) + (bc3 ? GetAlphaBlockError(block, alpha) : 0.0);
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (unsigned int i = 1; i < thread_count; i++)
+		threads.emplace_back(encodeRows, i);
+	encodeRows(0);
+	for (std::thread& thread : threads)
+		thread.join();
+
+	if (squared_error)
+	{
+		for (double error : errors)
+			*squared_error += error;
+	}
+}
+
+
+//  Containers  //
+void TextureCompressor::SetMaxDimension(int dimension)
+{
+	if (dimension > 0)
+		maxDimension = dimension;
+}
+
+
+bool TextureCompressor::IsContainerFile(const std::string& file_path)
+{
+	std::string extension = GetExtension(file_path);
+	return extension == "dds" || extension == "ktx";
+}
+
+
+bool TextureCompressor::Load(const std::string& file_path, TextureImage& image)
+{
+	image = TextureImage();
+
+	std::ifstream file(file_path, std::ios::binary);
+	if (!file)
+	{
+		std::cout << "ERROR::TextureCompressor.cpp::Load():: Failed to open '" << file_path << "'" << std::endl;
+		return false;
+	}
+
+	std::string extension = GetExtension(file_path);
+	bool loaded = extension == "dds" ? LoadDDS(file, image) : extension == "ktx" && LoadKTX(file, image);
+	if (!loaded)
+	{
+		std::cout << "ERROR::TextureCompressor.cpp::Load():: '" << file_path << "' is truncated or not in a supported format" << std::endl;
+		image = TextureImage();
+		return false;
+	}
+
+	return true;
+}
+
+
+bool TextureCompressor::Save(const std::string& file_path, const TextureImage& image)
+{
+	if (image.levels.empty())
+		return false;
+
+	std::ofstream file(file_path, std::ios::binary);
+	if (!file)
+	{
+		std::cout << "ERROR::TextureCompressor.cpp::Save():: Failed to create '" << file_path << "'" << std::endl;
+		return false;
+	}
+
+	std::string extension = GetExtension(file_path);
+	if (extension == "dds")
+		return SaveDDS(file, image);
+	if (extension == "ktx")
+		return SaveKTX(file, image);
+
+	std::cout << "ERROR::TextureCompressor.cpp::Save():: '" << file_path << "' is neither .dds nor .ktx" << std::endl;
+	return false;
+}
+
+
+//BC1, BC3 & BC7 (DX10 header) or plain 32 bit RGBA
+bool TextureCompressor::LoadDDS(std::ifstream& file, TextureImage& image)
+{
+	DDS_header header;
+	if (!file.read((char*)&header, sizeof(header)) || header.dwMagic != MakeFourCC("DDS ") || header.dwSize != 124)
+		return false;
+
+	uint32_t fourCC = header.sPixelFormat.dwFourCC;
+	if (!(header.sPixelFormat.dwFlags & DDPF_FOURCC))
+	{
+		if (header.sPixelFormat.dwRGBBitCount != 32 || header.sPixelFormat.dwRBitMask != 0x000000FF || header.sPixelFormat.dwGBitMask != 0x0000FF00
+			|| header.sPixelFormat.dwBBitMask != 0x00FF0000)
+			return false;
+		image.format = TextureFormat::RGBA8;
+	}
+	else if (fourCC == MakeFourCC("DXT1"))
+		image.format = TextureFormat::BC1;
+	else if (fourCC == MakeFourCC("DXT5"))
+		image.format = TextureFormat::BC3;
+	else if (fourCC == MakeFourCC("DX10"))
+	{
+		//2D textures only, no arrays or cube maps
+		DDS_HEADER_DXT10 extension;
+		if (!file.read((char*)&extension, sizeof(extension)) || extension.resourceDimension != 3 || extension.arraySize != 1)
+			return false;
+
+		switch (extension.dxgiFormat)
+		{
+			case DXGI_FORMAT_BC1_UNORM_SRGB:		image.srgb = true;
+			case DXGI_FORMAT_BC1_UNORM:				image.format = TextureFormat::BC1;		break;
+			case DXGI_FORMAT_BC3_UNORM_SRGB:		image.srgb = true;
+			case DXGI_FORMAT_BC3_UNORM:				image.format = TextureFormat::BC3;		break;
+			case DXGI_FORMAT_BC7_UNORM_SRGB:		image.srgb = true;
+			case DXGI_FORMAT_BC7_UNORM:				image.format = TextureFormat::BC7;		break;
+			case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:	image.srgb = true;
+			case DXGI_FORMAT_R8G8B8A8_UNORM:		image.format = TextureFormat::RGBA8;	break;
+			default:								return false;
+		}
+	}
+	else
+		return false;
+
+	unsigned int levelCount = (header.dwFlags & DDSD_MIPMAPCOUNT) && header.dwMipMapCount > 0 ? header.dwMipMapCount : 1;
+	if (!IsValidDimension(header.dwWidth, header.dwHeight) || levelCount > 32)
+		return false;
+	image.width = header.dwWidth;
+	image.height = header.dwHeight;
+
+	int levelWidth = image.width, levelHeight = image.height;
+	for (unsigned int i = 0; i < levelCount; i++)
+	{
+		size_t size = GetTextureLevelSize(image.format, levelWidth, levelHeight);
+		if (size > GetRemainingSize(file))
+			return false;
+
+		std::vector<unsigned char> level(size);
+		if (!file.read((char*)level.data(), level.size()))
+			return false;
+
+		image.levels.push_back(std::move(level));
+		levelWidth = std::max(1, levelWidth / 2);
+		levelHeight = std::max(1, levelHeight / 2);
+	}
+
+	return true;
+}
+
+
+//2D textures in BC1, BC3, BC7 or RGBA8, each level is prefixed with its size
+bool TextureCompressor::LoadKTX(std::ifstream& file, TextureImage& image)
+{
+	unsigned char identifier[12];
+	KTXHeader header;
+	if (!file.read((char*)identifier, sizeof(identifier)) || std::memcmp(identifier, ktxIdentifier, sizeof(identifier)) != 0
+		|| !file.read((char*)&header, sizeof(header)) || header.endianness != ktxEndianness)
+		return false;
+
+	if (header.pixelDepth > 1 || header.numberOfArrayElements > 0 || header.numberOfFaces != 1)
+		return false;
+
+	switch (header.glInternalFormat)
+	{
+		case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+		case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:	image.srgb = true;
+		case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+		case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:			image.format = TextureFormat::BC1;		break;
+		case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:	image.srgb = true;
+		case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:			image.format = TextureFormat::BC3;		break;
+		case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:		image.srgb = true;
+		case GL_COMPRESSED_RGBA_BPTC_UNORM:				image.format = TextureFormat::BC7;		break;
+		case GL_SRGB8_ALPHA8:
+		case GL_RGBA8:
+			image.srgb = header.glInternalFormat == GL_SRGB8_ALPHA8;
+			if (header.glFormat != GL_RGBA || header.glType != GL_UNSIGNED_BYTE)
+				return false;
+			image.format = TextureFormat::RGBA8;
+			break;
+		default:
+			return false;
+	}
+
+	unsigned int levelCount = std::max(1u, header.numberOfMipmapLevels);
+	if (!IsValidDimension(header.pixelWidth, std::max(1u, header.pixelHeight)) || levelCount > 32)
+		return false;
+	image.width = header.pixelWidth;
+	image.height = std::max(1u, header.pixelHeight);
+
+	//Key / value pairs are skipped, the block is 4 byte aligned & has to lie within the file
+	if (header.bytesOfKeyValueData % 4 != 0 || header.bytesOfKeyValueData > GetRemainingSize(file))
+		return false;
+	file.seekg(header.bytesOfKeyValueData, std::ios::cur);
+
+	int levelWidth = image.width, levelHeight = image.height;
+	for (unsigned int i = 0; i < levelCount; i++)
+	{
+		uint32_t imageSize = 0;
+		size_t size = GetTextureLevelSize(image.format, levelWidth, levelHeight);
+		if (!file.read((char*)&imageSize, sizeof(imageSize)) || imageSize != size || size > GetRemainingSize(file))
+			return false;
+
+		std::vector<unsigned char> level(size);
+		if (!file.read((char*)level.data(), level.size()))
+			return false;
+
+		//Levels are padded to 4 bytes, which block sizes & RGBA8 rows already are
+		image.levels.push_back(std::move(level));
+		levelWidth = std::max(1, levelWidth / 2);
+		levelHeight = std::max(1, levelHeight / 2);
+	}
+
+	return true;
+}
+
+
+bool TextureCompressor::SaveDDS(std::ofstream& file, const TextureImage& image)
+{
+	bool hasMipmaps = image.levels.size() > 1;
+
+	DDS_header header;
+	std::memset(&header, 0, sizeof(header));
+	header.dwMagic = MakeFourCC("DDS ");
+	header.dwSize = 124;
+	header.dwFlags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | (hasMipmaps ? DDSD_MIPMAPCOUNT : 0);
+	header.dwWidth = image.width;
+	header.dwHeight = image.height;
+	header.dwMipMapCount = (uint32_t)image.levels.size();
+	header.sPixelFormat.dwSize = 32;
+	header.sCaps.dwCaps1 = DDSCAPS_TEXTURE | (hasMipmaps ? DDSCAPS_COMPLEX | DDSCAPS_MIPMAP : 0);
+
+	//BC7 & every sRGB format have no FourCC of their own, they are named in the DX10 header
+	bool dx10 = image.format == TextureFormat::BC7 || image.srgb;
+	if (dx10)
+	{
+		header.dwFlags |= IsTextureFormatCompressed(image.format) ? DDSD_LINEARSIZE : DDSD_PITCH;
+		header.dwPitchOrLinearSize = IsTextureFormatCompressed(image.format) ? (uint32_t)image.levels[0].size() : image.width * 4;
+		header.sPixelFormat.dwFlags = DDPF_FOURCC;
+		header.sPixelFormat.dwFourCC = MakeFourCC("DX10");
+	}
+	else if (IsTextureFormatCompressed(image.format))
+	{
+		header.dwFlags |= DDSD_LINEARSIZE;
+		header.dwPitchOrLinearSize = (uint32_t)image.levels[0].size();
+		header.sPixelFormat.dwFlags = DDPF_FOURCC;
+		header.sPixelFormat.dwFourCC = MakeFourCC(image.format == TextureFormat::BC1 ? "DXT1" : "DXT5");
+	}
+	else
+	{
+		header.dwFlags |= DDSD_PITCH;
+		header.dwPitchOrLinearSize = image.width * 4;
+		header.sPixelFormat.dwFlags = DDPF_RGB | DDPF_ALPHAPIXELS;
+		header.sPixelFormat.dwRGBBitCount = 32;
+		header.sPixelFormat.dwRBitMask = 0x000000FF;
+		header.sPixelFormat.dwGBitMask = 0x0000FF00;
+		header.sPixelFormat.dwBBitMask = 0x00FF0000;
+		header.sPixelFormat.dwAlphaBitMask = 0xFF000000;
+	}
+	file.write((const char*)&header, sizeof(header));
+
+	if (dx10)
+	{
+		DDS_HEADER_DXT10 extension;
+		std::memset(&extension, 0, sizeof(extension));
+		switch (image.format)
+		{
+			case TextureFormat::BC1:	extension.dxgiFormat = image.srgb ? DXGI_FORMAT_BC1_UNORM_SRGB : DXGI_FORMAT_BC1_UNORM;				break;
+			case TextureFormat::BC3:	extension.dxgiFormat = image.srgb ? DXGI_FORMAT_BC3_UNORM_SRGB : DXGI_FORMAT_BC3_UNORM;				break;
+			case TextureFormat::BC7:	extension.dxgiFormat = image.srgb ? DXGI_FORMAT_BC7_UNORM_SRGB : DXGI_FORMAT_BC7_UNORM;				break;
+			default:					extension.dxgiFormat = image.srgb ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;	break;
+		}
+		extension.resourceDimension = 3;		//D3D10_RESOURCE_DIMENSION_TEXTURE2D
+		extension.arraySize = 1;
+		file.write((const char*)&extension, sizeof(extension));
+	}
+
+	for (const std::vector<unsigned char>& level : image.levels)
+		file.write((const char*)level.data(), level.size());
+
+	return (bool)file;
+}
+
+
+bool TextureCompressor::SaveKTX(std::ofstream& file, const TextureImage& image)
+{
+	bool compressed = IsTextureFormatCompressed(image.format);
+
+	KTXHeader header;
+	header.endianness = ktxEndianness;
+	header.glType = compressed ? 0 : GL_UNSIGNED_BYTE;
+	header.glTypeSize = 1;
+	header.glFormat = compressed ? 0 : GL_RGBA;
+	header.glInternalFormat = GetTextureInternalFormat(image.format, image.srgb);
+	header.glBaseInternalFormat = image.format == TextureFormat::BC1 ? GL_RGB : GL_RGBA;
+	header.pixelWidth = image.width;
+	header.pixelHeight = image.height;
+	header.pixelDepth = 0;
+	header.numberOfArrayElements = 0;
+	header.numberOfFaces = 1;
+	header.numberOfMipmapLevels = (uint32_t)image.levels.size();
+	header.bytesOfKeyValueData = 0;
+
+	file.write((const char*)ktxIdentifier, sizeof(ktxIdentifier));
+	file.write((const char*)&header, sizeof(header));
+
+	for (const std::vector<unsigned char>& level : image.levels)
+	{
+		uint32_t imageSize = (uint32_t)level.size();
+		file.write((const char*)&imageSize, sizeof(imageSize));
+		file.write((const char*)level.data(), level.size());
+	}
+
+	return (bool)file;
+}
+
+
+std::string TextureCompressor::GetExtension(const std::string& file_path)
+{
+	size_t dot = file_path.find_last_of('.');
+	if (dot == std::string::npos)
+		return "";
+
+	std::string extension = file_path.substr(dot + 1);
+	for (char& c : extension)
+		c = (char)std::tolower((unsigned char)c);
+	return extension;
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+//How the texels of a texture are stored on the GPU
+enum class TextureFormat
+{
+	RGBA8,
+	BC1,		//DXT1: opaque RGB, 8 bytes per 4x4 block (0.5 bytes per pixel)
+	BC3,		//DXT5: RGBA, 16 bytes per 4x4 block (1 byte per pixel)
+	BC7			//BPTC: RGBA at a higher quality than BC3 & the same size, only loaded (the encoder doesn't produce it)
+};
+
+const char* GetTextureFormatName(TextureFormat format);
+unsigned int GetTextureInternalFormat(TextureFormat format, bool srgb = false);		//GL_RGBA8 or one of the GL_COMPRESSED_ formats, their sRGB versions with srgb
+bool IsTextureFormatCompressed(TextureFormat format);
+bool IsTextureFormatSupported(TextureFormat format);		//Whether the driver can sample it
+size_t GetTextureLevelSize(TextureFormat format, int width, int height);		//Bytes of one mip level, in 64 bits where size_t is
+
+
+//Every mip level of a texture in memory, as stored in a container or made by the encoder
+struct TextureImage
+{
+	TextureFormat format = TextureFormat::RGBA8;
+	int width = 0, height = 0;
+	bool srgb = false;		//Colour is sRGB, stored & sampled in one of the sRGB formats
+	std::vector<std::vector<unsigned char>> levels;		//Level 0 first, each one half the size of the previous
+
+	unsigned int GetSize() const;		//Bytes of all levels
+};
+
+
+/*
+Block compression (BC1 & BC3) of RGBA8 images & the DDS/KTX containers the result is stored in.
+Containers keep their rows bottom-up, the order GL (& stb_image with flipping) uses, so levels go to the GPU as they are
+& a compressed texture lines up with the same image loaded from a PNG. Files from other tools have to be exported flipped.
+*/
+class TextureCompressor
+{
+public:
+	enum class Quality
+	{
+		Fast,		//Endpoints along the principal axis of each block
+		High		//Fast, then the endpoints are refitted by least squares until the error stops going down
+	};
+
+	struct EncodeStats
+	{
+		float time = 0.0f;		//ms
+		float rmse = 0.0f;		//Root mean square error of level 0 over all channels, 0 - 255
+	};
+
+	//Every level of an RGBA8 image (MipGenerator makes the chain), the rows are kept in the order they come in.
+	//thread_count = 0 uses every hardware thread
+	static TextureImage Encode(const TextureImage& source, TextureFormat format, Quality quality = Quality::High,
+		unsigned int thread_count = 0, EncodeStats* stats = nullptr);
+
+	//Containers wider or taller than this are rejected (default 16384). Loads run on threads without a context,
+	//so the application passes GL_MAX_TEXTURE_SIZE in once its context exists
+	static void SetMaxDimension(int dimension);
+
+	static bool IsContainerFile(const std::string& file_path);		//.dds or .ktx
+	static bool Load(const std::string& file_path, TextureImage& image);
+	static bool Save(const std::string& file_path, const TextureImage& image);		//Rows are written as they are (bottom-up expected)
+
+private:
+	static bool LoadDDS(std::ifstream& file, TextureImage& image);
+	static bool LoadKTX(std::ifstream& file, TextureImage& image);
+	static bool SaveDDS(std::ofstream& file, const TextureImage& image);
+	static bool SaveKTX(std::ofstream& file, const TextureImage& image);
+
+	static void EncodeLevel(const unsigned char* pixels, int width, int height, TextureFormat format, Quality quality,
+		unsigned int thread_count, std::vector<unsigned char>& out, double* squared_error);
+	static std::string GetExtension(const std::string& file_path);
+};
\ No newline at end of file
@@ -0,0 +1,383 @@
+#include "TextureStreamer.h"
+#include "GLStateCache.h"
+#include "Renderer.h"
+#include "stb_image/stb_image.h"
+
+#include "imgui/imgui.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+
+
+TextureStreamer* TextureStreamer::instance = nullptr;
+
+
+//Constructor
+TextureStreamer::TextureStreamer(unsigned int budget_bytes, unsigned int stream_bytes_per_frame)
+	: budget(budget_bytes), streamLimit(stream_bytes_per_frame), residentSize(0), frame(0)
+{
+	instance = this;
+}
+
+//Destructor
+TextureStreamer::~TextureStreamer()
+{
+	//Textures still alive keep the levels they have
+	if (instance == this)
+		instance = nullptr;
+}
+
+
+TextureStreamer& TextureStreamer::Get()
+{
+	ASSERT(instance);
+	return *instance;
+}
+
+
+TextureStreamer* TextureStreamer::TryGet()
+{
+	return instance;
+}
+
+
+std::shared_ptr<Texture> TextureStreamer::Load(const std::string& file_path, const TextureParams& params)
+{
+	TextureImage image;
+	if (TextureCompressor::IsContainerFile(file_path))
+	{
+		TextureCompressor::Load(file_path, image);
+	}
+	else
+	{
+		int width = 0, height = 0, bpp = 0;
+		stbi_set_flip_vertically_on_load(1);
+		if (unsigned char* pixels = stbi_load(file_path.c_str(), &width, &height, &bpp, 4))
+		{
+			image.width = width;
+			image.height = height;
+			image.levels.emplace_back(pixels, pixels + width * height * 4);
+			stbi_image_free(pixels);
+		}
+	}
+
+	return Add(file_path, std::move(image), params);
+}
+
+
+//The mipmap source of the params doesn't matter, streaming always needs the chain in system memory
+std::shared_ptr<Texture> TextureStreamer::Add(const std::string& name, TextureImage image, const TextureParams& params)
+{
+	std::shared_ptr<Texture> texture = std::make_shared<Texture>(TextureImage(), params);
+	texture->filePath = name;
+
+	if (image.levels.empty())
+	{
+		std::cout << "ERROR::TextureStreamer.cpp::Add():: '" << name << "' has no image to stream" << std::endl;
+		return texture;
+	}
+
+	if (image.format == TextureFormat::RGBA8 && image.levels.size() == 1)
+		MipGenerator::Generate(image, params.mipFilter, params.srgb);
+
+	std::unique_ptr<Entry> entry = std::make_unique<Entry>();
+	entry->name = name;
+	entry->texture = texture;
+	entry->raw = texture.get();
+	entry->image = std::move(image);
+
+	//The first level that is small enough, or the last one of a short chain
+	int levelCount = (int)entry->image.levels.size();
+	entry->tailLevel = 0;
+	while (entry->tailLevel < levelCount - 1 &&
+		std::max(entry->image.width >> entry->tailLevel, entry->image.height >> entry->tailLevel) > tailSize)
+		entry->tailLevel++;
+
+	entry->residentLevel = entry->wantedLevel = entry->tailLevel;
+	entry->screenSize = 0.0f;
+	entry->levelUsed.assign(levelCount, frame);
+
+	//Only the tail goes up now, the finer levels once something asks for them
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D, texture->GetRendererID());
+	bool uploaded = texture->SetImage(entry->image, entry->tailLevel);
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D, 0);
+	if (!uploaded)
+		return texture;
+
+	residentSize += GetResidentSize(*entry);
+	lookup[entry->raw] = entry.get();
+	entries.push_back(std::move(entry));
+	return texture;
+}
+
+
+void TextureStreamer::Request(const Texture& texture, float screen_size)
+{
+	auto it = lookup.find(&texture);
+	if (it != lookup.end())
+		it->second->screenSize = std::max(it->second->screenSize, screen_size);
+}
+
+
+float TextureStreamer::GetScreenSize(const glm::mat4& mvp, const glm::vec2& rect_min, const glm::vec2& rect_max, const glm::vec2& viewport)
+{
+	const glm::vec2 corners[4] = { rect_min, glm::vec2(rect_max.x, rect_min.y), rect_max, glm::vec2(rect_min.x, rect_max.y) };
+	glm::vec2 screen[4];
+	int behind = 0;
+	for (int i = 0; i < 4; i++)
+	{
+		glm::vec4 clip = mvp * glm::vec4(corners[i], 0.0f, 1.0f);
+		if (clip.w <= 0.0001f)
+		{
+			behind++;
+			continue;
+		}
+		screen[i] = (glm::vec2(clip) / clip.w * 0.5f + 0.5f) * viewport;
+	}
+
+	//Entirely behind the camera it isn't seen, partly behind it reaches right up to the camera
+	if (behind == 4)
+		return 0.0f;
+	if (behind > 0)
+		return std::numeric_limits<float>::max();
+
+	float size = 0.0f;
+	for (int i = 0; i < 4; i++)
+		size = std::max(size, glm::length(screen[(i + 1) % 4] - screen[i]));
+	return size;
+}
+
+
+void TextureStreamer::Update()
+{
+	frame++;
+	stats.streamedIn = stats.evicted = 0;
+	stats.levelsIn = stats.levelsEvicted = 0;
+
+	//Textures nobody holds anymore took their GL object with them
+	for (size_t i = 0; i < entries.size();)
+	{
+		if (entries[i]->texture.expired())
+		{
+			//A new texture may already live at the same address
+			residentSize -= GetResidentSize(*entries[i]);
+			auto it = lookup.find(entries[i]->raw);
+			if (it != lookup.end() && it->second == entries[i].get())
+				lookup.erase(it);
+			entries[i] = std::move(entries.back());
+			entries.pop_back();
+		}
+		else
+		{
+			i++;
+		}
+	}
+
+	//What the last frame drew, every level from the wanted one down counts as used
+	for (std::unique_ptr<Entry>& entry : entries)
+	{
+		entry->wantedLevel = GetWantedLevel(*entry);
+		if (entry->screenSize > 0.0f)
+		{
+			for (int level = entry->wantedLevel; level < (int)entry->levelUsed.size(); level++)
+				entry->levelUsed[level] = frame;
+		}
+		entry->screenSize = 0.0f;
+	}
+
+	//The budget may have been lowered
+	while (residentSize > budget && EvictOne(false)) {}
+
+	//Textures furthest from what they want go first, then one level per texture & round so none of them waits for the others
+	std::vector<Entry*> pending;
+	for (std::unique_ptr<Entry>& entry : entries)
+	{
+		if (entry->wantedLevel < entry->residentLevel)
+			pending.push_back(entry.get());
+	}
+	std::sort(pending.begin(), pending.end(), [](const Entry* a, const Entry* b)
+		{ return a->residentLevel - a->wantedLevel > b->residentLevel - b->wantedLevel; });
+
+	bool progress = true;
+	while (progress)
+	{
+		progress = false;
+		for (Entry* entry : pending)
+		{
+			if (entry->residentLevel <= entry->wantedLevel)
+				continue;
+
+			//A level larger than the per frame limit still goes up, alone
+			unsigned int size = (unsigned int)entry->image.levels[entry->residentLevel - 1].size();
+			if (stats.streamedIn > 0 && stats.streamedIn + size > streamLimit)
+				continue;
+
+			while (residentSize + size > budget && EvictOne(true)) {}
+			if (residentSize + size > budget)
+				continue;		//Doesn't fit next to what is on screen
+
+			progress |= StreamIn(*entry);
+		}
+	}
+
+	if (stats.levelsIn || stats.levelsEvicted)
+		GLStateCache::Get().BindTexture(GL_TEXTURE_2D, 0);
+}
+
+
+std::vector<TextureStreamer::Residency> TextureStreamer::GetResidency() const
+{
+	std::vector<Residency> residency;
+	for (const std::unique_ptr<Entry>& entry : entries)
+	{
+		if (entry->texture.expired())
+			continue;
+
+		Residency info;
+		info.name = entry->name;
+		info.width = entry->image.width;
+		info.height = entry->image.height;
+		info.levelCount = (int)entry->image.levels.size();
+		info.residentLevel = entry->residentLevel;
+		info.wantedLevel = entry->wantedLevel;
+		info.tailLevel = entry->tailLevel;
+		info.residentSize = GetResidentSize(*entry);
+		info.fullSize = entry->image.GetSize();
+		info.framesUnused = frame - entry->levelUsed.back();
+		residency.push_back(info);
+	}
+
+	std::sort(residency.begin(), residency.end(), [](const Residency& a, const Residency& b) { return a.name < b.name; });
+	return residency;
+}
+
+
+void TextureStreamer::OnImGuiRender()
+{
+	const float MB = 1024.0f * 1024.0f;
+	ImGui::Text("%u streamed textures, %.2f MB resident (budget %.0f MB)", (unsigned int)entries.size(), residentSize / MB, budget / MB);
+	ImGui::Text("Last frame: %.1f KB in (%u levels), %.1f KB evicted (%u levels)", stats.streamedIn / 1024.0f, stats.levelsIn,
+		stats.evicted / 1024.0f, stats.levelsEvicted);
+	ImGui::Text("Total: %.2f MB in, %.2f MB evicted", stats.totalStreamedIn / MB, stats.totalEvicted / MB);
+
+	int budgetMB = budget / (1024 * 1024);
+	if (ImGui::SliderInt("Streaming budget (MB)", &budgetMB, 1, 256))
+		budget = budgetMB * 1024 * 1024;
+	int limitKB = streamLimit / 1024;
+	if (ImGui::SliderInt("Stream limit (KB / frame)", &limitKB, 64, 16384))
+		streamLimit = limitKB * 1024;
+
+	ImGui::Separator();
+	ImGui::Columns(5, "residency");
+	ImGui::Text("Texture");				ImGui::NextColumn();
+	ImGui::Text("Resident (KB)");		ImGui::NextColumn();
+	ImGui::Text("Level / wanted");		ImGui::NextColumn();
+	ImGui::Text("Resident size");		ImGui::NextColumn();
+	ImGui::Text("Unused (frames)");		ImGui::NextColumn();
+	ImGui::Separator();
+
+	for (const Residency& info : GetResidency())
+	{
+		char overlay[32];
+		snprintf(overlay, sizeof(overlay), "%.0f / %.0f", info.residentSize / 1024.0f, info.fullSize / 1024.0f);
+
+		ImGui::Text("%s", info.name.c_str());										ImGui::NextColumn();
+		ImGui::ProgressBar((float)info.residentSize / info.fullSize, ImVec2(-1.0f, 0.0f), overlay);	ImGui::NextColumn();
+		ImGui::Text("%d / %d (of %d)", info.residentLevel, info.wantedLevel, info.levelCount);	ImGui::NextColumn();
+		ImGui::Text("%dx%d", std::max(1, info.width >> info.residentLevel), std::max(1, info.height >> info.residentLevel));	ImGui::NextColumn();
+		ImGui::Text("%llu", info.framesUnused);										ImGui::NextColumn();
+	}
+	ImGui::Columns(1);
+}
+
+
+void TextureStreamer::ResetStats()
+{
+	stats = Stats();
+}
+
+
+//The coarsest level that still has a texel for every pixel the texture covers
+int TextureStreamer::GetWantedLevel(const Entry& entry) const
+{
+	if (entry.screenSize <= 0.0f)
+		return entry.tailLevel;
+
+	float size = (float)std::max(entry.image.width, entry.image.height);
+	int level = 0;
+	while (level < entry.tailLevel && size * 0.5f >= entry.screenSize)
+	{
+		size *= 0.5f;
+		level++;
+	}
+	return level;
+}
+
+
+unsigned int TextureStreamer::GetResidentSize(const Entry& entry) const
+{
+	unsigned int size = 0;
+	for (size_t level = entry.residentLevel; level < entry.image.levels.size(); level++)
+		size += (unsigned int)entry.image.levels[level].size();
+	return size;
+}
+
+
+bool TextureStreamer::StreamIn(Entry& entry)
+{
+	std::shared_ptr<Texture> texture = entry.texture.lock();
+	if (!texture)
+		return false;
+
+	//Sampling moves up only once the level has its data
+	int level = entry.residentLevel - 1;
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D, texture->GetRendererID());
+	texture->SpecifyLevel(level, &entry.image.levels[level]);
+	texture->SetBaseLevel(level);
+	entry.residentLevel = level;
+
+	unsigned int size = (unsigned int)entry.image.levels[level].size();
+	residentSize += size;
+	stats.streamedIn += size;
+	stats.totalStreamedIn += size;
+	stats.levelsIn++;
+	return true;
+}
+
+
+//The finest level of the texture whose levels were wanted the longest time ago
+bool TextureStreamer::EvictOne(bool keep_used)
+{
+	Entry* victim = nullptr;
+	for (std::unique_ptr<Entry>& entry : entries)
+	{
+		if (entry->residentLevel >= entry->tailLevel || entry->texture.expired())
+			continue;
+
+		unsigned long long used = entry->levelUsed[entry->residentLevel];
+		if (keep_used && used == frame)
+			continue;
+		if (!victim || used < victim->levelUsed[victim->residentLevel])
+			victim = entry.get();
+	}
+
+	if (!victim)
+		return false;
+
+	//Sampling moves off the level before its memory goes
+	std::shared_ptr<Texture> texture = victim->texture.lock();
+	int level = victim->residentLevel;
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D, texture->GetRendererID());
+	texture->SetBaseLevel(level + 1);
+	texture->SpecifyLevel(level, nullptr);
+	victim->residentLevel = level + 1;
+
+	unsigned int size = (unsigned int)victim->image.levels[level].size();
+	residentSize -= size;
+	stats.evicted += size;
+	stats.totalEvicted += size;
+	stats.levelsEvicted++;
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "Texture.h"
+
+
+/*
+Keeps textures only as detailed on the GPU as they are drawn on screen, within a budget of video memory.
+Every level of a streamed texture stays in system memory, the GPU starts with the small tail of the chain
+& gets finer levels (one at a time, coarse to fine) once Request() reports the texture covering enough pixels.
+Over the budget the finest level of the least recently used texture goes first, levels drawn this frame never do.
+The application creates one of these after the context, Get() hands it out to the rest of the code.
+*/
+class TextureStreamer
+{
+public:
+	//The per frame counters cover the last Update(), the totals since the last ResetStats()
+	struct Stats
+	{
+		unsigned int streamedIn = 0;		//Bytes uploaded in the last frame
+		unsigned int evicted = 0;			//Bytes given back in the last frame
+		unsigned int levelsIn = 0;
+		unsigned int levelsEvicted = 0;
+		unsigned long long totalStreamedIn = 0;
+		unsigned long long totalEvicted = 0;
+	};
+
+	//What one texture has on the GPU, for debugging views
+	struct Residency
+	{
+		std::string name;
+		int width, height;
+		int levelCount;
+		int residentLevel;		//Finest level on the GPU
+		int wantedLevel;		//Finest level its on-screen size asks for
+		int tailLevel;			//Always resident
+		unsigned int residentSize;		//Bytes
+		unsigned int fullSize;			//Bytes with every level resident
+		unsigned long long framesUnused;
+	};
+
+private:
+	struct Entry
+	{
+		std::string name;
+		std::weak_ptr<Texture> texture;
+		Texture* raw;		//Key of the lookup, only dereferenced while the weak pointer is alive
+		TextureImage image;		//Every level, the ones on the GPU included
+		int residentLevel;
+		int wantedLevel;
+		int tailLevel;
+		float screenSize;		//Largest size requested since the last Update()
+		std::vector<unsigned long long> levelUsed;		//Last frame each level was wanted
+	};
+
+	static TextureStreamer* instance;
+
+	std::vector<std::unique_ptr<Entry>> entries;
+	std::unordered_map<const Texture*, Entry*> lookup;
+	unsigned int budget;		//Bytes of video memory for all streamed textures
+	unsigned int streamLimit;		//Bytes uploaded per frame at most
+	unsigned int residentSize;
+	unsigned long long frame;
+
+	Stats stats;
+
+public:
+	static const int tailSize = 64;		//Levels this size & smaller are uploaded on load & never evicted
+
+	//Constructor & Destructor
+	TextureStreamer(unsigned int budget_bytes = 64 * 1024 * 1024, unsigned int stream_bytes_per_frame = 4 * 1024 * 1024);
+	~TextureStreamer();
+
+	static TextureStreamer& Get();
+	static TextureStreamer* TryGet();		//nullptr if there is no streamer (yet)
+
+	//Reads the whole chain (.dds & .ktx as they are, other images decoded to RGBA8 & mipmapped on the CPU)
+	std::shared_ptr<Texture> Load(const std::string& file_path, const TextureParams& params = TextureParams());
+	//An image from memory, RGBA8 images with only level 0 get their chain made here
+	std::shared_ptr<Texture> Add(const std::string& name, TextureImage image, const TextureParams& params = TextureParams());
+
+	//Every frame a texture is drawn: screen_size is how many pixels the longer side of the texture covers
+	void Request(const Texture& texture, float screen_size);
+	//Longer edge in pixels of a model space rectangle drawn with mvp, huge when it reaches behind the camera & 0 when it's all behind
+	static float GetScreenSize(const glm::mat4& mvp, const glm::vec2& rect_min, const glm::vec2& rect_max, const glm::vec2& viewport);
+
+	//Once per frame: evicts over the budget, then streams in what was requested
+	void Update();
+
+	std::vector<Residency> GetResidency() const;
+	void OnImGuiRender();
+
+	inline void SetBudget(unsigned int budget_bytes) { budget = budget_bytes; };
+	inline unsigned int GetBudget() const { return budget; };
+	inline void SetStreamLimit(unsigned int bytes_per_frame) { streamLimit = bytes_per_frame; };
+	inline unsigned int GetStreamLimit() const { return streamLimit; };
+	inline unsigned int GetResidentSize() const { return residentSize; };
+	inline unsigned int GetCount() const { return (unsigned int)entries.size(); };
+	void ResetStats();
+	inline const Stats& GetStats() const { return stats; };
+
+private:
+	int GetWantedLevel(const Entry& entry) const;
+	unsigned int GetResidentSize(const Entry& entry) const;
+	bool StreamIn(Entry& entry);		//The next finer level
+	bool EvictOne(bool keep_used);		//keep_used: levels wanted this frame stay
+};
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "UniformBuffer.h"
+#include "Renderer.h"
+#include "GLStateCache.h"
+
+#include <cstring>
+
+
+const char* GetUniformBlockName(UniformBlock block)
+{
+	switch (block)
+	{
+		case UniformBlock::PerFrame:	return "PerFrame";
+		case UniformBlock::PerView:		return "PerView";
+		case UniformBlock::PerObject:	return "PerObject";
+		default:						return "";
+	}
+}
+
+
+//  UniformBuffer   //
+//Constructor
+UniformBuffer::UniformBuffer(unsigned int size)
+	: rendererID(0), size(size)
+{
+	glErrorCall( glGenBuffers(1, &rendererID) );
+	GLStateCache::Get().BindBuffer(GL_UNIFORM_BUFFER, rendererID);
+	glErrorCall( glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW) );
+}
+
+//Destructor
+UniformBuffer::~UniformBuffer()
+{
+	GLStateCache::Get().OnDeleteBuffer(rendererID);
+	glErrorCall( glDeleteBuffers(1, &rendererID) );
+}
+
+
+void UniformBuffer::SetData(const void* data, unsigned int size, unsigned int offset)
+{
+	GLStateCache::Get().BindBuffer(GL_UNIFORM_BUFFER, rendererID);
+	glErrorCall( glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data) );
+}
+
+
+void UniformBuffer::BindBase(UniformBlock block) const
+{
+	GLStateCache::Get().BindBufferBase(GL_UNIFORM_BUFFER, (unsigned int)block, rendererID);
+}
+
+
+//  FrameUniforms   //
+FrameUniforms* FrameUniforms::instance = nullptr;
+
+
+//Constructor
+FrameUniforms::FrameUniforms()
+	: offsetAlignment(256)
+{
+	int alignment = 0;
+	glErrorCall( glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment) );
+	if (alignment > 0)
+		offsetAlignment = alignment;
+
+	perFrame = std::make_unique<UniformBuffer>((unsigned int)sizeof(PerFrameData));
+	perView = std::make_unique<UniformBuffer>((unsigned int)sizeof(PerViewData));
+	perFrame->BindBase(UniformBlock::PerFrame);
+	perView->BindBase(UniformBlock::PerView);
+
+	//Room for a few thousand objects per region
+	unsigned int objectSize = std140::Align((unsigned int)sizeof(PerObjectData), offsetAlignment);
+	perObject = std::make_unique<StreamingBuffer>(GL_UNIFORM_BUFFER, objectSize * 4096);
+
+	instance = this;
+}
+
+//Destructor
+FrameUniforms::~FrameUniforms()
+{
+	if (instance == this)
+		instance = nullptr;
+}
+
+
+FrameUniforms& FrameUniforms::Get()
+{
+	ASSERT(instance);
+	return *instance;
+}
+
+
+void FrameUniforms::SetFrame(const PerFrameData& data)
+{
+	perFrame->SetData(&data, sizeof(data));
+}
+
+
+void FrameUniforms::SetView(const PerViewData& data)
+{
+	perView->SetData(&data, sizeof(data));
+}
+
+
+void FrameUniforms::SetObject(const PerObjectData& data)
+{
+	StreamingBuffer::Allocation allocation = perObject->Allocate(sizeof(data), offsetAlignment);
+	if (!allocation.data)
+		return;
+
+	std::memcpy(allocation.data, &data, sizeof(data));
+	perObject->Commit(allocation, sizeof(data));
+	perObject->BindRange((unsigned int)UniformBlock::PerObject, allocation.offset, sizeof(data));
+}
+
+
+void FrameUniforms::EndFrame()
+{
+	perObject->EndFrame();
+}
\ No newline at end of file
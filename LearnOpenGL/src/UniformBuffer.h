@@ -0,0 +1,127 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <memory>
+
+#include "StreamingBuffer.h"
+
+
+//  std140 Layout   //
+namespace std140
+{
+	//Base alignments (in bytes) of the std140 rules
+	constexpr unsigned int scalarAlignment = 4;		//float, int, uint, bool
+	constexpr unsigned int vec2Alignment = 8;
+	constexpr unsigned int vec4Alignment = 16;		//vec3 & vec4
+	constexpr unsigned int arrayAlignment = 16;		//Every array element & matrix column is rounded up to a vec4
+
+	constexpr unsigned int Align(unsigned int offset, unsigned int alignment)
+	{
+		return (offset + alignment - 1) / alignment * alignment;
+	}
+
+	//Offset of a member that comes right after a member ending at previous_end
+	constexpr unsigned int NextOffset(unsigned int previous_end, unsigned int alignment)
+	{
+		return Align(previous_end, alignment);
+	}
+
+	//Size of an array in a block, each element padded to 16 bytes
+	constexpr unsigned int ArraySize(unsigned int element_size, unsigned int count)
+	{
+		return Align(element_size, arrayAlignment) * count;
+	}
+}
+
+
+//Fixed binding points, every shader that declares a block with one of these names gets it bound on link
+enum class UniformBlock : unsigned int
+{
+	PerFrame = 0,
+	PerView = 1,
+	PerObject = 2,
+	Count
+};
+
+const char* GetUniformBlockName(UniformBlock block);
+
+
+//  Block Layouts   //
+//Have to match the blocks in the shaders member for member, the static_asserts check them against std140
+
+struct PerFrameData
+{
+	float time;				//Seconds since startup
+	float deltaTime;
+	glm::vec2 resolution;	//Framebuffer size in pixels
+};
+static_assert(offsetof(PerFrameData, deltaTime) == std140::NextOffset(offsetof(PerFrameData, time) + 4, std140::scalarAlignment), "PerFrame: deltaTime breaks std140");
+static_assert(offsetof(PerFrameData, resolution) == std140::NextOffset(offsetof(PerFrameData, deltaTime) + 4, std140::vec2Alignment), "PerFrame: resolution breaks std140");
+
+struct PerViewData
+{
+	glm::mat4 view;
+	glm::mat4 proj;
+	glm::mat4 viewProj;
+};
+static_assert(offsetof(PerViewData, proj) == std140::NextOffset(offsetof(PerViewData, view) + 64, std140::arrayAlignment), "PerView: proj breaks std140");
+static_assert(offsetof(PerViewData, viewProj) == std140::NextOffset(offsetof(PerViewData, proj) + 64, std140::arrayAlignment), "PerView: viewProj breaks std140");
+
+struct PerObjectData
+{
+	glm::mat4 model;
+	glm::vec4 color;
+};
+static_assert(offsetof(PerObjectData, color) == std140::NextOffset(offsetof(PerObjectData, model) + 64, std140::vec4Alignment), "PerObject: color breaks std140");
+
+
+class UniformBuffer
+{
+private:
+	unsigned int rendererID;
+	unsigned int size;
+
+public:
+	//Constructor & Destructor
+	UniformBuffer(unsigned int size);
+	~UniformBuffer();
+
+	void SetData(const void* data, unsigned int size, unsigned int offset = 0);
+	void BindBase(UniformBlock block) const;
+
+	inline unsigned int GetSize() const { return size; };
+};
+
+
+/*
+Owner of the shared blocks: PerFrame & PerView are uploaded once per frame (or view) & seen by every shader,
+PerObject data is sub-allocated from a ring & bound by range for each draw.
+The application creates one of these after the context, Get() hands it out to the rest of the code.
+*/
+class FrameUniforms
+{
+private:
+	static FrameUniforms* instance;
+
+	std::unique_ptr<UniformBuffer> perFrame;
+	std::unique_ptr<UniformBuffer> perView;
+	std::unique_ptr<StreamingBuffer> perObject;
+	unsigned int offsetAlignment;		//GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+
+public:
+	//Constructor & Destructor
+	FrameUniforms();
+	~FrameUniforms();
+
+	static FrameUniforms& Get();
+
+	void SetFrame(const PerFrameData& data);
+	void SetView(const PerViewData& data);
+	void SetObject(const PerObjectData& data);		//Binds a fresh copy to the PerObject binding point
+	void EndFrame();
+
+	inline const StreamingBuffer& GetObjectRing() const { return *perObject; };
+};
\ No newline at end of file
@@ -0,0 +1,242 @@
+#include "UploadManager.h"
+#include "Renderer.h"
+#include "GLStateCache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+
+UploadManager* UploadManager::instance = nullptr;
+
+static const unsigned int bytesPerPixel = 4;		//Everything goes up as RGBA8
+
+
+//Constructor
+UploadManager::UploadManager(unsigned int budget_bytes)
+	: budget(0)
+{
+	staging = std::make_unique<StreamingBuffer>(GL_PIXEL_UNPACK_BUFFER, maxBudget);
+	SetBudget(budget_bytes);
+
+	instance = this;
+}
+
+//Destructor
+UploadManager::~UploadManager()
+{
+	if (instance == this)
+		instance = nullptr;
+}
+
+
+UploadManager& UploadManager::Get()
+{
+	ASSERT(instance);
+	return *instance;
+}
+
+
+UploadManager* UploadManager::TryGet()
+{
+	return instance;
+}
+
+
+void UploadManager::UploadTexture(unsigned int texture_id, int level, int x, int y, int width, int height, const void* pixels, bool generate_mipmaps)
+{
+	unsigned int size = width * height * bytesPerPixel;
+	const unsigned char* bytes = (const unsigned char*)pixels;
+
+	Job job;
+	job.target = GL_TEXTURE_2D;
+	job.id = texture_id;
+	job.data.assign(bytes, bytes + size);
+	job.done = 0;
+	job.level = level;
+	job.x = x;
+	job.y = y;
+	job.width = width;
+	job.height = height;
+	job.generateMipmaps = generate_mipmaps;
+	job.offset = 0;
+	jobs.push_back(std::move(job));
+}
+
+
+void UploadManager::UploadBuffer(unsigned int buffer_id, unsigned int offset, const void* data, unsigned int size)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+
+	Job job;
+	job.target = GL_ARRAY_BUFFER;
+	job.id = buffer_id;
+	job.data.assign(bytes, bytes + size);
+	job.done = 0;
+	job.level = job.x = job.y = job.width = job.height = 0;
+	job.generateMipmaps = false;
+	job.offset = offset;
+	jobs.push_back(std::move(job));
+}
+
+
+void UploadManager::Cancel(unsigned int target, unsigned int id)
+{
+	auto matches = [target, id](const Job& job) { return job.target == target && job.id == id; };
+	jobs.erase(std::remove_if(jobs.begin(), jobs.end(), matches), jobs.end());
+}
+
+
+bool UploadManager::IsPending(unsigned int target, unsigned int id) const
+{
+	for (const Job& job : jobs)
+	{
+		if (job.target == target && job.id == id)
+			return true;
+	}
+
+	return false;
+}
+
+
+void UploadManager::Flush(unsigned int target, unsigned int id)
+{
+	//With an unpack buffer bound the pointers would be read as offsets into it
+	GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	for (const Job& job : jobs)
+	{
+		if (job.target != target || job.id != id)
+			continue;
+
+		if (job.target == GL_TEXTURE_2D)
+		{
+			unsigned int rowSize = job.width * bytesPerPixel;
+			GLStateCache::Get().BindTexture(GL_TEXTURE_2D, job.id);
+			glErrorCall( glTexSubImage2D(GL_TEXTURE_2D, job.level, job.x, job.y + job.done, job.width, job.height - job.done,
+				GL_RGBA, GL_UNSIGNED_BYTE, job.data.data() + job.done * rowSize) );
+			if (job.generateMipmaps)
+			{
+				glErrorCall( glGenerateMipmap(GL_TEXTURE_2D) );
+			}
+		}
+		else
+		{
+			GLStateCache::Get().BindBuffer(GL_COPY_WRITE_BUFFER, job.id);
+			glErrorCall( glBufferSubData(GL_COPY_WRITE_BUFFER, job.offset + job.done, job.data.size() - job.done, job.data.data() + job.done) );
+		}
+	}
+
+	Cancel(target, id);
+}
+
+
+void UploadManager::Update()
+{
+	stats = Stats();
+
+	unsigned int available = budget;
+	while (!jobs.empty() && available > 0)
+	{
+		Job& job = jobs.front();
+		unsigned int used = job.target == GL_TEXTURE_2D ? UploadTextureRows(job, available) : UploadBufferChunk(job, available);
+		if (used == 0)
+			break;		//Not even one row fits in what's left of the budget
+
+		available = used < available ? available - used : 0;
+		stats.bytesUploaded += used;
+		stats.chunks++;
+
+		bool finished = job.target == GL_TEXTURE_2D ? job.done == (unsigned int)job.height : job.done == job.data.size();
+		if (finished)
+		{
+			if (job.generateMipmaps)
+			{
+				GLStateCache::Get().BindTexture(GL_TEXTURE_2D, job.id);
+				glErrorCall( glGenerateMipmap(GL_TEXTURE_2D) );
+			}
+			jobs.pop_front();
+		}
+	}
+
+	//A bound unpack buffer would turn the pointers of every later glTexImage2D into offsets
+	GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	staging->EndFrame();
+
+	stats.pendingJobs = (unsigned int)jobs.size();
+	for (const Job& job : jobs)
+		stats.pendingBytes += (unsigned int)job.data.size() - (job.target == GL_TEXTURE_2D ? job.done * job.width * bytesPerPixel : job.done);
+}
+
+
+void UploadManager::SetBudget(unsigned int budget_bytes)
+{
+	//Everything of one frame has to fit in one region of the ring
+	budget = budget_bytes < maxBudget ? budget_bytes : maxBudget;
+	if (budget < bytesPerPixel)
+		budget = bytesPerPixel;
+}
+
+
+//Copies as many whole rows as the budget allows, a single row always goes if the budget is untouched
+unsigned int UploadManager::UploadTextureRows(Job& job, unsigned int available)
+{
+	unsigned int rowSize = job.width * bytesPerPixel;
+	unsigned int rows = std::min(available / rowSize, (unsigned int)job.height - job.done);
+	if (rows == 0)
+	{
+		if (available < budget)
+			return 0;
+		rows = 1;
+	}
+
+	unsigned int size = rows * rowSize;
+	StreamingBuffer::Allocation allocation = staging->Allocate(size, bytesPerPixel);
+	const unsigned char* source = job.data.data() + job.done * rowSize;
+
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D, job.id);
+	if (allocation.data)
+	{
+		std::memcpy(allocation.data, source, size);
+		staging->Commit(allocation, size);
+		staging->Bind();
+		glErrorCall( glTexSubImage2D(GL_TEXTURE_2D, job.level, job.x, job.y + job.done, job.width, rows, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)(uintptr_t)allocation.offset) );
+	}
+	else
+	{
+		//A row wider than a whole region (over 2M pixels), straight from memory
+		GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		glErrorCall( glTexSubImage2D(GL_TEXTURE_2D, job.level, job.x, job.y + job.done, job.width, rows, GL_RGBA, GL_UNSIGNED_BYTE, source) );
+	}
+
+	job.done += rows;
+	return size;
+}
+
+
+unsigned int UploadManager::UploadBufferChunk(Job& job, unsigned int available)
+{
+	unsigned int remaining = (unsigned int)job.data.size() - job.done;
+	unsigned int size = std::min(available, remaining);
+
+	//Keeping chunks 4 byte aligned, except for the tail
+	if (size < remaining)
+		size &= ~3u;
+	if (size == 0)
+		return 0;
+
+	StreamingBuffer::Allocation allocation = staging->Allocate(size, 4);
+	if (!allocation.data)
+		return 0;
+
+	std::memcpy(allocation.data, job.data.data() + job.done, size);
+	staging->Commit(allocation, size);
+
+	//Copying on the GPU, from the staging ring to the destination (through the copy target, so no vertex array state is touched)
+	staging->Bind();
+	GLStateCache::Get().BindBuffer(GL_COPY_WRITE_BUFFER, job.id);
+	glErrorCall( glCopyBufferSubData(GL_PIXEL_UNPACK_BUFFER, GL_COPY_WRITE_BUFFER, allocation.offset, job.offset + job.done, size) );
+
+	job.done += size;
+	return size;
+}
\ No newline at end of file
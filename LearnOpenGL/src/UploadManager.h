@@ -0,0 +1,90 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "StreamingBuffer.h"
+
+
+/*
+Spreads texture & buffer uploads over several frames.
+Data is copied into a ring of pixel buffer objects (a StreamingBuffer on GL_PIXEL_UNPACK_BUFFER, fenced per frame)
+& handed to GL from there, at most budget bytes per frame. Textures go up a few rows at a time, buffers in chunks,
+so a huge image never lands in one frame. Uploads smaller than directUploadSize skip the queue.
+Until its upload is done a texture or buffer holds undefined data, IsPending() tells if that's the case.
+The application creates one of these after the context, Get() hands it out to the rest of the code.
+*/
+class UploadManager
+{
+public:
+	//Counters of the latest Update()
+	struct Stats
+	{
+		unsigned int bytesUploaded = 0;
+		unsigned int chunks = 0;			//glTexSubImage2D / glCopyBufferSubData calls
+		unsigned int pendingJobs = 0;
+		unsigned int pendingBytes = 0;
+	};
+
+	static const unsigned int directUploadSize = 16 * 1024;
+	static const unsigned int maxBudget = 8 * 1024 * 1024;		//Size of one ring region
+
+private:
+	struct Job
+	{
+		unsigned int target;		//GL_TEXTURE_2D or GL_ARRAY_BUFFER
+		unsigned int id;
+		std::vector<unsigned char> data;
+		unsigned int done;			//Rows for textures, bytes for buffers
+
+		//Textures (RGBA8) only
+		int level, x, y, width, height;
+		bool generateMipmaps;		//glGenerateMipmap once the last row is up
+
+		//Buffers only
+		unsigned int offset;
+	};
+
+	static UploadManager* instance;
+
+	std::unique_ptr<StreamingBuffer> staging;
+	std::deque<Job> jobs;
+	unsigned int budget;
+
+	Stats stats;
+
+public:
+	//Constructor & Destructor
+	UploadManager(unsigned int budget_bytes = 1024 * 1024);
+	~UploadManager();
+
+	static UploadManager& Get();
+	static UploadManager* TryGet();		//nullptr if there is no manager (yet)
+
+	//Queues a sub-rectangle of one mip level, pixels are copied so they can be freed right away.
+	//generate_mipmaps rebuilds the levels below from the finished image
+	void UploadTexture(unsigned int texture_id, int level, int x, int y, int width, int height, const void* pixels, bool generate_mipmaps = false);
+	void UploadBuffer(unsigned int buffer_id, unsigned int offset, const void* data, unsigned int size);
+
+	//Owners have to cancel their uploads before deleting the object, GL could hand the name out again
+	//target = GL_TEXTURE_2D or GL_ARRAY_BUFFER (any buffer), textures & buffers have separate names
+	void Cancel(unsigned int target, unsigned int id);
+	bool IsPending(unsigned int target, unsigned int id) const;
+	//Uploads what is queued for the object right away, straight from memory & outside the budget (e.g. to time a load)
+	void Flush(unsigned int target, unsigned int id);
+
+	//Runs the queue within the budget & fences the staging memory used, once per frame
+	void Update();
+
+	void SetBudget(unsigned int budget_bytes);
+	inline unsigned int GetBudget() const { return budget; };
+	inline const Stats& GetStats() const { return stats; };
+	inline const StreamingBuffer& GetStagingBuffer() const { return *staging; };
+
+private:
+	unsigned int UploadTextureRows(Job& job, unsigned int available);
+	unsigned int UploadBufferChunk(Job& job, unsigned int available);
+};
\ No newline at end of file
@@ -1,10 +1,12 @@
 #include "VertexArray.h"
 #include "Renderer.h"
 #include "VertexBufferLayout.h"
+#include "GLStateCache.h"
 
 
 //Constructor
 VertexArray::VertexArray()
+	: attribCount(0)
 {
 	glErrorCall( glGenVertexArrays(1, &rendererID) );
 }
@@ -12,6 +14,7 @@ VertexArray::VertexArray()
 //Destructor
 VertexArray::~VertexArray()
 {
+	GLStateCache::Get().OnDeleteVertexArray(rendererID);
 	glErrorCall( glDeleteVertexArrays(1, &rendererID) );
 }
 
@@ -20,30 +23,56 @@ void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& la
 {
 	Bind();
 	vb.Bind();
+	SetupAttributes(layout);
+}
 
-	const auto& elements = layout.GetElements();
-	unsigned int offset = 0;
-	for (unsigned int i = 0; i < elements.size(); i++)
-	{
-		const auto& element = elements[i];
-
-		//Enabling & specifying vertex attributes
-		glErrorCall( glEnableVertexAttribArray(i) );
-		glErrorCall( glVertexAttribPointer(i, element.count, element.type,
-			element.normalized, layout.GetStride(), (const void*) offset) );
-
-		offset += element.count * VertexBufferElement::GetSizeOfType(element.type);
-	}
+void VertexArray::AddBuffer(const StreamingBuffer& sb, const VertexBufferLayout& layout)
+{
+	Bind();
+	sb.Bind();
+	SetupAttributes(layout);
+}
 
-	
+void VertexArray::AddBuffer(unsigned int buffer_id, const VertexBufferLayout& layout)
+{
+	Bind();
+	GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, buffer_id);
+	SetupAttributes(layout);
 }
 
 void VertexArray::Bind() const
 {
-	glErrorCall( glBindVertexArray(rendererID) );
+	GLStateCache::Get().BindVertexArray(rendererID);
 }
 
 void VertexArray::Unbind() const
 {
-	glErrorCall( glBindVertexArray(0) );
+	GLStateCache::Get().BindVertexArray(0);
+}
+
+
+void VertexArray::SetupAttributes(const VertexBufferLayout& layout)
+{
+	const auto& elements = layout.GetElements();
+	unsigned int offset = 0;
+	for (unsigned int i = 0; i < elements.size(); i++)
+	{
+		const auto& element = elements[i];
+		unsigned int index = attribCount++;
+
+		//Enabling & specifying vertex attributes
+		glErrorCall( glEnableVertexAttribArray(index) );
+		if (element.integer)
+		{
+			glErrorCall( glVertexAttribIPointer(index, element.count, element.type, layout.GetStride(), (const void*) offset) );
+		}
+		else
+		{
+			glErrorCall( glVertexAttribPointer(index, element.count, element.type,
+				element.normalized, layout.GetStride(), (const void*) offset) );
+		}
+		glErrorCall( glVertexAttribDivisor(index, element.divisor) );
+
+		offset += element.GetSize();
+	}
 }
@@ -1,21 +1,49 @@
 #pragma once
 
 #include "VertexBuffer.h"
+#include "StreamingBuffer.h"
 
 class VertexBufferLayout;
+template<typename Vertex> struct VertexLayoutOf;		//StaticVertexLayout.h
 
 class VertexArray
 {
 private:
 	unsigned int rendererID;
+	unsigned int attribCount;	//Next free attribute index, so that every added buffer continues after the last one
 
 public:
 	//Constructor & Destructor
 	VertexArray();
 	~VertexArray();
 
+	//Every call adds the layout's attributes after the ones already added
 	void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout);
+	void AddBuffer(const StreamingBuffer& sb, const VertexBufferLayout& layout);	//Draws pick the frame's data with a base vertex
+	void AddBuffer(unsigned int buffer_id, const VertexBufferLayout& layout);		//A GL buffer owned by someone else (GpuHeap)
+
+	//Layout of a vertex struct declared with VERTEX_LAYOUT, set up without walking a runtime layout
+	template<typename Vertex>
+	void AddBuffer(const VertexBuffer& vb, unsigned int divisor = 0)
+	{
+		Bind();
+		vb.Bind();
+		VertexLayoutOf<Vertex>::Type::Setup(attribCount, divisor);
+		attribCount += VertexLayoutOf<Vertex>::Type::locationCount;
+	}
+
+	template<typename Vertex>
+	void AddBuffer(const StreamingBuffer& sb, unsigned int divisor = 0)
+	{
+		Bind();
+		sb.Bind();
+		VertexLayoutOf<Vertex>::Type::Setup(attribCount, divisor);
+		attribCount += VertexLayoutOf<Vertex>::Type::locationCount;
+	}
 
 	void Bind() const;
 	void Unbind() const;
+
+private:
+	void SetupAttributes(const VertexBufferLayout& layout);		//For the buffer bound to GL_ARRAY_BUFFER
 };
\ No newline at end of file
@@ -0,0 +1,247 @@
+#include "VertexArrayCache.h"
+#include "Renderer.h"
+#include "VertexBufferLayout.h"
+#include "GLStateCache.h"
+#include "Hash.h"
+
+
+VertexArrayCache* VertexArrayCache::instance = nullptr;
+
+
+//Constructor
+VertexArrayCache::VertexArrayCache()
+	: attribBindingSupported(GLEW_VERSION_4_3 || GLEW_ARB_vertex_attrib_binding), attribBinding(false)
+{
+	attribBinding = attribBindingSupported;
+	instance = this;
+}
+
+//Destructor
+VertexArrayCache::~VertexArrayCache()
+{
+	Clear();
+
+	if (instance == this)
+		instance = nullptr;
+}
+
+
+VertexArrayCache& VertexArrayCache::Get()
+{
+	ASSERT(instance);
+	return *instance;
+}
+
+
+VertexArrayCache* VertexArrayCache::TryGet()
+{
+	return instance;
+}
+
+
+void VertexArrayCache::Bind(const Stream* streams, unsigned int stream_count, unsigned int index_buffer)
+{
+	ASSERT(stream_count > 0 && stream_count <= maxStreams);
+	stats.binds++;
+
+	//The buffers are part of the key only where they are baked into the vertex array
+	uint64_t key = GetFormatKey(streams, stream_count);
+	if (!attribBinding)
+	{
+		for (unsigned int s = 0; s < stream_count; s++)
+		{
+			key = HashBytes(&streams[s].buffer, sizeof(streams[s].buffer), key);
+			key = HashBytes(&streams[s].offset, sizeof(streams[s].offset), key);
+		}
+		key = HashBytes(&index_buffer, sizeof(index_buffer), key);
+	}
+
+	auto it = entries.find(key);
+	if (it == entries.end())
+		it = entries.emplace(key, CreateEntry(streams, stream_count, index_buffer)).first;
+
+	Entry& entry = it->second;
+	GLStateCache::Get().BindVertexArray(entry.vertexArray);
+
+	if (attribBinding)
+	{
+		for (unsigned int s = 0; s < stream_count; s++)
+		{
+			if (entry.buffers[s] == streams[s].buffer && entry.offsets[s] == streams[s].offset)
+				continue;
+
+			glErrorCall( glBindVertexBuffer(s, streams[s].buffer, streams[s].offset, streams[s].layout->GetStride()) );
+			entry.buffers[s] = streams[s].buffer;
+			entry.offsets[s] = streams[s].offset;
+			stats.bufferBinds++;
+		}
+	}
+
+	GLStateCache::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer);
+}
+
+
+void VertexArrayCache::Bind(const VertexBuffer& vb, const VertexBufferLayout& layout, const IndexBuffer& ib)
+{
+	Stream stream = { vb.GetRendererID(), &layout, 0 };
+	Bind(&stream, 1, ib.GetRendererID());
+}
+
+
+void VertexArrayCache::OnDeleteBuffer(unsigned int id)
+{
+	for (auto it = entries.begin(); it != entries.end();)
+	{
+		Entry& entry = it->second;
+
+		//Format vertex arrays only forget the binding, the next draw binds whatever it needs
+		if (attribBinding)
+		{
+			for (unsigned int s = 0; s < entry.streamCount; s++)
+			{
+				if (entry.buffers[s] == id)
+					entry.buffers[s] = 0;
+			}
+			++it;
+			continue;
+		}
+
+		bool uses = entry.indexBuffer == id;
+		for (unsigned int s = 0; s < entry.streamCount; s++)
+			uses = uses || entry.buffers[s] == id;
+
+		if (uses)
+		{
+			GLStateCache::Get().OnDeleteVertexArray(entry.vertexArray);
+			glErrorCall( glDeleteVertexArrays(1, &entry.vertexArray) );
+			it = entries.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+
+void VertexArrayCache::SetAttribBinding(bool enabled)
+{
+	enabled = enabled && attribBindingSupported;
+	if (enabled == attribBinding)
+		return;
+
+	Clear();
+	attribBinding = enabled;
+}
+
+
+void VertexArrayCache::ResetStats()
+{
+	stats = Stats();
+}
+
+
+VertexArrayCache::Entry VertexArrayCache::CreateEntry(const Stream* streams, unsigned int stream_count, unsigned int index_buffer)
+{
+	Entry entry;
+	entry.streamCount = stream_count;
+	entry.indexBuffer = attribBinding ? 0 : index_buffer;
+	glErrorCall( glGenVertexArrays(1, &entry.vertexArray) );
+	GLStateCache::Get().BindVertexArray(entry.vertexArray);
+	stats.created++;
+
+	unsigned int location = 0;
+	for (unsigned int s = 0; s < stream_count; s++)
+	{
+		const VertexBufferLayout& layout = *streams[s].layout;
+		const auto& elements = layout.GetElements();
+
+		//Attribute binding: the format only, relative to the binding point, buffers come in Bind()
+		if (attribBinding)
+		{
+			unsigned int relativeOffset = 0;
+			for (const VertexBufferElement& element : elements)
+			{
+				glErrorCall( glEnableVertexAttribArray(location) );
+				if (element.integer)
+				{
+					glErrorCall( glVertexAttribIFormat(location, element.count, element.type, relativeOffset) );
+				}
+				else
+				{
+					glErrorCall( glVertexAttribFormat(location, element.count, element.type, element.normalized, relativeOffset) );
+				}
+				glErrorCall( glVertexAttribBinding(location, s) );
+
+				relativeOffset += element.GetSize();
+				location++;
+			}
+
+			//One divisor per binding point, the layout's attributes advance together
+			glErrorCall( glVertexBindingDivisor(s, elements.empty() ? 0 : elements[0].divisor) );
+			entry.buffers[s] = 0;
+			entry.offsets[s] = 0;
+			continue;
+		}
+
+		GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, streams[s].buffer);
+		unsigned int offset = streams[s].offset;
+		for (const VertexBufferElement& element : elements)
+		{
+			glErrorCall( glEnableVertexAttribArray(location) );
+			if (element.integer)
+			{
+				glErrorCall( glVertexAttribIPointer(location, element.count, element.type, layout.GetStride(), (const void*)(size_t)offset) );
+			}
+			else
+			{
+				glErrorCall( glVertexAttribPointer(location, element.count, element.type, element.normalized,
+					layout.GetStride(), (const void*)(size_t)offset) );
+			}
+			glErrorCall( glVertexAttribDivisor(location, element.divisor) );
+
+			offset += element.GetSize();
+			location++;
+		}
+		entry.buffers[s] = streams[s].buffer;
+		entry.offsets[s] = streams[s].offset;
+	}
+
+	if (!attribBinding)
+		GLStateCache::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer);
+
+	return entry;
+}
+
+
+void VertexArrayCache::Clear()
+{
+	for (auto& entry : entries)
+	{
+		GLStateCache::Get().OnDeleteVertexArray(entry.second.vertexArray);
+		glErrorCall( glDeleteVertexArrays(1, &entry.second.vertexArray) );
+	}
+	entries.clear();
+}
+
+
+//Everything that goes into a vertex array's attribute state: per stream the stride & every element with its divisor
+uint64_t VertexArrayCache::GetFormatKey(const Stream* streams, unsigned int stream_count)
+{
+	uint64_t key = HashBytes(&stream_count, sizeof(stream_count));
+	for (unsigned int s = 0; s < stream_count; s++)
+	{
+		const VertexBufferLayout& layout = *streams[s].layout;
+		unsigned int stride = layout.GetStride();
+		unsigned int elementCount = (unsigned int)layout.GetElements().size();
+		key = HashBytes(&stride, sizeof(stride), key);
+		key = HashBytes(&elementCount, sizeof(elementCount), key);
+
+		for (const VertexBufferElement& element : layout.GetElements())
+		{
+			const unsigned int fields[] = { element.type, element.count, element.normalized, element.integer, element.divisor };
+			key = HashBytes(fields, sizeof(fields), key);
+		}
+	}
+	return key;
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+class VertexBuffer;
+class IndexBuffer;
+class VertexBufferLayout;
+
+
+/*
+Vertex arrays made on demand for the buffers & layouts that are drawn, so nothing has to build its own.
+With ARB_vertex_attrib_binding (GL 4.3) there is one vertex array per vertex format (layouts & divisors of the streams),
+drawing other buffers of the same format only rebinds them with glBindVertexBuffer.
+Without it a vertex array is tied to its buffers, so there is one per set of buffers, layouts & index buffer.
+The application creates one of these after the context, Get() hands it out to the rest of the code.
+Buffers tell it when they are deleted (OnDeleteBuffer), a new buffer with the same name must not find the old vertex array.
+*/
+class VertexArrayCache
+{
+public:
+	static const unsigned int maxStreams = 4;
+
+	//A vertex buffer & the layout of its data, starting offset bytes in
+	struct Stream
+	{
+		unsigned int buffer;
+		const VertexBufferLayout* layout;
+		unsigned int offset;
+	};
+
+	//Counters, reset by the user with ResetStats() (usually once per frame)
+	struct Stats
+	{
+		unsigned int binds = 0;
+		unsigned int created = 0;			//Vertex arrays made
+		unsigned int bufferBinds = 0;		//glBindVertexBuffer calls, attribute binding only
+	};
+
+private:
+	static VertexArrayCache* instance;
+
+	struct Entry
+	{
+		unsigned int vertexArray;
+		unsigned int streamCount;
+		unsigned int buffers[maxStreams];	//Attribute binding: what is bound to each binding point, otherwise what the attributes point at
+		unsigned int offsets[maxStreams];
+		unsigned int indexBuffer;			//Without attribute binding only
+	};
+
+	std::unordered_map<uint64_t, Entry> entries;
+	bool attribBindingSupported;
+	bool attribBinding;
+
+	Stats stats;
+
+public:
+	//Constructor & Destructor
+	VertexArrayCache();
+	~VertexArrayCache();
+
+	static VertexArrayCache& Get();
+	static VertexArrayCache* TryGet();		//nullptr if there is no cache (yet)
+
+	//Binds a vertex array with the streams' attributes (locations in order, continuing over the streams) & the index buffer
+	void Bind(const Stream* streams, unsigned int stream_count, unsigned int index_buffer);
+	void Bind(const VertexBuffer& vb, const VertexBufferLayout& layout, const IndexBuffer& ib);
+
+	void OnDeleteBuffer(unsigned int id);
+
+	//Off forces the per buffer set vertex arrays even where attribute binding is supported, for comparison
+	void SetAttribBinding(bool enabled);
+	inline bool UsesAttribBinding() const { return attribBinding; };
+	inline bool IsAttribBindingSupported() const { return attribBindingSupported; };
+
+	inline unsigned int GetCount() const { return (unsigned int)entries.size(); };
+	void ResetStats();
+	inline const Stats& GetStats() const { return stats; };
+
+private:
+	Entry CreateEntry(const Stream* streams, unsigned int stream_count, unsigned int index_buffer);
+	void Clear();
+
+	static uint64_t GetFormatKey(const Stream* streams, unsigned int stream_count);
+};
\ No newline at end of file
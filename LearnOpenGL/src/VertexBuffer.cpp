@@ -1,18 +1,47 @@
 #include "VertexBuffer.h"
 #include "Renderer.h"
+#include "GLStateCache.h"
+#include "VertexArrayCache.h"
+#include "UploadManager.h"
 
 
 //Constructor
 VertexBuffer::VertexBuffer(const void* data, unsigned int size)
 {
     glErrorCall( glGenBuffers(1, &rendererID) );       //Generating a buffer
-    glErrorCall( glBindBuffer(GL_ARRAY_BUFFER, rendererID) );      //Binding the buffer
-    glErrorCall( glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW) );    //Updating vertex data
+    GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, rendererID);      //Binding the buffer
+
+    //Large buffers are only allocated here, the upload manager copies the data over the next frames
+    UploadManager* uploads = UploadManager::TryGet();
+    if (uploads && data && size > UploadManager::directUploadSize)
+    {
+        glErrorCall( glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STATIC_DRAW) );
+        uploads->UploadBuffer(rendererID, 0, data, size);
+    }
+    else
+    {
+        glErrorCall( glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW) );    //Updating vertex data
+    }
+}
+
+//Constructor (dynamic)
+VertexBuffer::VertexBuffer(unsigned int size)
+{
+    glErrorCall( glGenBuffers(1, &rendererID) );
+    GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, rendererID);
+    glErrorCall( glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW) );    //Only allocating, data comes in with SetData()
 }
 
 //Destructor
 VertexBuffer::~VertexBuffer()
 {
+    if (UploadManager* uploads = UploadManager::TryGet())
+        uploads->Cancel(GL_ARRAY_BUFFER, rendererID);
+
+    if (VertexArrayCache* vertexArrays = VertexArrayCache::TryGet())
+        vertexArrays->OnDeleteBuffer(rendererID);
+
+    GLStateCache::Get().OnDeleteBuffer(rendererID);
     glErrorCall( glDeleteBuffers(1, &rendererID) );
 }
 
@@ -20,7 +49,7 @@ VertexBuffer::~VertexBuffer()
 //Binding the buffers
 void VertexBuffer::Bind() const
 {
-    glErrorCall( glBindBuffer(GL_ARRAY_BUFFER, rendererID) );
+    GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, rendererID);
 
 }
 
@@ -28,6 +57,21 @@ void VertexBuffer::Bind() const
 //Unbinding the buffers
 void VertexBuffer::Unbind() const
 {
-    glErrorCall( glBindBuffer(GL_ARRAY_BUFFER, 0) );
+    GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, 0);
+
+}
+
+
+//Updating vertex data of a dynamic buffer
+void VertexBuffer::SetData(const void* data, unsigned int size, unsigned int offset)
+{
+    GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, rendererID);
+    glErrorCall( glBufferSubData(GL_ARRAY_BUFFER, offset, size, data) );
+}
+
 
+bool VertexBuffer::IsReady() const
+{
+    UploadManager* uploads = UploadManager::TryGet();
+    return !(uploads && uploads->IsPending(GL_ARRAY_BUFFER, rendererID));
 }
\ No newline at end of file
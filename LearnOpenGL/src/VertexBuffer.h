@@ -9,8 +9,18 @@ private:
 public:
 	//Constructor & Destructor
 	VertexBuffer(const void* data, unsigned int sie);
+	VertexBuffer(unsigned int size);	//Dynamic buffer, filled later through SetData()
 	~VertexBuffer();
 
 	void Bind() const;
 	void Unbind() const;
+
+	//Updating (part of) a dynamic buffer
+	void SetData(const void* data, unsigned int size, unsigned int offset = 0);
+
+	//False while the upload manager is still copying the initial data
+	bool IsReady() const;
+
+	//Getter
+	inline unsigned int GetRendererID() const { return rendererID; }
 };
\ No newline at end of file
@@ -1,40 +1,75 @@
 #pragma once
 
 #include <GL/glew.h>
+#include <glm/glm.hpp>
 
+#include <cstdint>
 #include <vector>
-#include <stdexcept>
 
 #include "Renderer.h"
 
 
+//Attribute types that have no C++ type of their own, for VertexBufferLayout::Push()
+struct Half
+{
+	uint16_t bits;		//IEEE 754 half precision, VertexQuantizer::FloatToHalf() makes them
+};
+
+struct Snorm1010102
+{
+	uint32_t bits;		//x, y & z in 10 bits each & w in 2 bits, all signed normalized (GL_INT_2_10_10_10_REV)
+};
+
+
 struct VertexBufferElement
 {
 	unsigned int type;
 	unsigned int count;
 	unsigned char normalized;
+	unsigned int divisor;		//0 = per vertex, n = advances once every n instances
+	bool integer;				//Read as ints by the shader (glVertexAttribIPointer) instead of being converted to floats
 
 	static unsigned int GetSizeOfType(unsigned int type)
 	{
 		switch (type)
 		{
-			case GL_FLOAT:			return 4;
-			case GL_UNSIGNED_INT:	return 4;
-			case GL_UNSIGNED_BYTE:	return 4;
+			case GL_FLOAT:						return 4;
+			case GL_HALF_FLOAT:					return 2;
+			case GL_INT:						return 4;
+			case GL_UNSIGNED_INT:				return 4;
+			case GL_SHORT:						return 2;
+			case GL_UNSIGNED_SHORT:				return 2;
+			case GL_BYTE:						return 1;
+			case GL_UNSIGNED_BYTE:				return 1;
+			case GL_INT_2_10_10_10_REV:			return 4;	//All 4 components together
+			case GL_UNSIGNED_INT_2_10_10_10_REV:return 4;
 		}
 
 		ASSERT(false);
 		return 0;
 	}
 
-	VertexBufferElement(unsigned int t, unsigned int c, bool n)
-		: count(c), type(t), normalized(n)
+	VertexBufferElement(unsigned int t, unsigned int c, bool n, unsigned int d = 0, bool i = false)
+		: count(c), type(t), normalized(n), divisor(d), integer(i)
 	{
 
 	}
+
+	//Bytes the attribute takes up in a vertex
+	inline unsigned int GetSize() const
+	{
+		bool packed = type == GL_INT_2_10_10_10_REV || type == GL_UNSIGNED_INT_2_10_10_10_REV;
+		return packed ? GetSizeOfType(type) : count * GetSizeOfType(type);
+	}
 };
 
 
+/*
+Push<T>() adds attributes the shader reads as floats: float, Half, unsigned int (converted as is)
+& normalized integers (signed char, unsigned char, short, unsigned short & Snorm1010102, which is always 4 components).
+PushInteger<T>() adds attributes the shader reads as int / uint (ivec / uvec).
+Types without a specialization don't compile.
+*/
 class VertexBufferLayout
 {
 private:
@@ -51,32 +86,125 @@ public:
 
 	//Templates
 	template<typename T>
-	void Push(unsigned int count)
+	void Push(unsigned int count, unsigned int divisor = 0)
 	{
-		std::runtime_error(false);
+		static_assert(sizeof(T) == 0, "VertexBufferLayout::Push<T>(): T isn't a vertex attribute type");
 	}
 
-	template<>
-	void Push<float>(unsigned int count)
+	template<typename T>
+	void PushInteger(unsigned int count, unsigned int divisor = 0)
 	{
-		elements.push_back(VertexBufferElement({ GL_FLOAT, count, GL_FALSE }));
-		stride += count * VertexBufferElement::GetSizeOfType(GL_FLOAT);
+		static_assert(sizeof(T) == 0, "VertexBufferLayout::PushInteger<T>(): T isn't an integer vertex attribute type");
 	}
 
-	template<>
-	void Push<unsigned int>(unsigned int count)
-	{
-		elements.push_back(VertexBufferElement({ GL_UNSIGNED_INT, count, GL_FALSE }));
-		stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_INT);
-	}
+	inline const std::vector<VertexBufferElement>& GetElements() const { return elements; };
+	inline unsigned int GetStride() const { return stride; };
 
-	template<>
-	void Push<unsigned char>(unsigned int count)
+private:
+	void AddElement(const VertexBufferElement& element)
 	{
-		elements.push_back(VertexBufferElement({ GL_UNSIGNED_BYTE, count, GL_TRUE }));
-		stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_BYTE);
+		elements.push_back(element);
+		stride += element.GetSize();
 	}
+};
 
-	inline const std::vector<VertexBufferElement> GetElements() const { return elements; };
-	inline unsigned int GetStride() const { return stride; };
-};
\ No newline at end of file
+
+//  Float Attributes    //
+template<>
+inline void VertexBufferLayout::Push<float>(unsigned int count, unsigned int divisor)
+{
+	AddElement({ GL_FLOAT, count, GL_FALSE, divisor });
+}
+
+template<>
+inline void VertexBufferLayout::Push<Half>(unsigned int count, unsigned int divisor)
+{
+	AddElement({ GL_HALF_FLOAT, count, GL_FALSE, divisor });
+}
+
+template<>
+inline void VertexBufferLayout::Push<unsigned int>(unsigned int count, unsigned int divisor)
+{
+	AddElement({ GL_UNSIGNED_INT, count, GL_FALSE, divisor });
+}
+
+template<>
+inline void VertexBufferLayout::Push<signed char>(unsigned int count, unsigned int divisor)
+{
+	AddElement({ GL_BYTE, count, GL_TRUE, divisor });
+}
+
+template<>
+inline void VertexBufferLayout::Push<unsigned char>(unsigned int count, unsigned int divisor)
+{
+	AddElement({ GL_UNSIGNED_BYTE, count, GL_TRUE, divisor });
+}
+
+template<>
+inline void VertexBufferLayout::Push<short>(unsigned int count, unsigned int divisor)
+{
+	AddElement({ GL_SHORT, count, GL_TRUE, divisor });
+}
+
+template<>
+inline void VertexBufferLayout::Push<unsigned short>(unsigned int count, unsigned int divisor)
+{
+	AddElement({ GL_UNSIGNED_SHORT, count, GL_TRUE, divisor });
+}
+
+//count is the number of packed values, each one is a whole 4 component attribute
+template<>
+inline void VertexBufferLayout::Push<Snorm1010102>(unsigned int count, unsigned int divisor)
+{
+	for (unsigned int i = 0; i < count; i++)
+		AddElement({ GL_INT_2_10_10_10_REV, 4, GL_TRUE, divisor });
+}
+
+//A matrix takes up 4 attribute locations, one vec4 column each
+template<>
+inline void VertexBufferLayout::Push<glm::mat4>(unsigned int count, unsigned int divisor)
+{
+	for (unsigned int i = 0; i < count * 4; i++)
+		AddElement({ GL_FLOAT, 4, GL_FALSE, divisor });
+}
+
+
+//  Integer Attributes  //
+template<>
+inline void VertexBufferLayout::PushInteger<int>(unsigned int count, unsigned int divisor)
+{
+	AddElement({ GL_INT, count, GL_FALSE, divisor, true });
+}
+
+template<>
+inline void VertexBufferLayout::PushInteger<unsigned int>(unsigned int count, unsigned int divisor)
+{
+	AddElement({ GL_UNSIGNED_INT, count, GL_FALSE, divisor, true });
+}
+
+template<>
+inline void VertexBufferLayout::PushInteger<short>(unsigned int count, unsigned int divisor)
+{
+	AddElement({ GL_SHORT, count, GL_FALSE, divisor, true });
+}
+
+template<>
+inline void VertexBufferLayout::PushInteger<unsigned short>(unsigned int count, unsigned int divisor)
+{
+	AddElement({ GL_UNSIGNED_SHORT, count, GL_FALSE, divisor, true });
+}
+
+template<>
+inline void VertexBufferLayout::PushInteger<signed char>(unsigned int count, unsigned int divisor)
+{
+	AddElement({ GL_BYTE, count, GL_FALSE, divisor, true });
+}
+
+template<>
+inline void VertexBufferLayout::PushInteger<unsigned char>(unsigned int count, unsigned int divisor)
+{
+	AddElement({ GL_UNSIGNED_BYTE, count, GL_FALSE, divisor, true });
+}
+
+
+static_assert(sizeof(Half) == 2 && sizeof(Snorm1010102) == 4, "Attribute types must match the size GL reads");
\ No newline at end of file
@@ -0,0 +1,307 @@
+#include "VertexQuantizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+QuantizedMesh VertexQuantizer::Quantize(const float* vertices, unsigned int vertex_count, const std::vector<VertexAttributeFormat>& attributes)
+{
+	QuantizedMesh mesh;
+	mesh.vertexCount = vertex_count;
+
+	unsigned int sourceStride = 0;
+	for (const VertexAttributeFormat& attribute : attributes)
+	{
+		sourceStride += attribute.components;
+		PushAttribute(mesh.layout, attribute);
+	}
+	mesh.sourceSize = vertex_count * sourceStride * sizeof(float);
+
+	unsigned int stride = mesh.layout.GetStride();
+	mesh.data.resize(vertex_count * stride);
+
+	unsigned int sourceOffset = 0, offset = 0;
+	for (const VertexAttributeFormat& attribute : attributes)
+	{
+		glm::vec4 scale(1.0f), bias(0.0f);
+		float maxError = 0.0f;
+
+		//Fitting the bounds of every component into -1 - 1 or 0 - 1
+		bool isSigned = false;
+		if (IsNormalized(attribute.format, isSigned) && attribute.fitBounds && vertex_count > 0)
+		{
+			for (unsigned int c = 0; c < attribute.components && c < 4; c++)
+			{
+				float minimum = vertices[sourceOffset + c], maximum = minimum;
+				for (unsigned int v = 1; v < vertex_count; v++)
+				{
+					float value = vertices[v * sourceStride + sourceOffset + c];
+					minimum = std::min(minimum, value);
+					maximum = std::max(maximum, value);
+				}
+
+				float range = maximum - minimum;
+				if (range <= 0.0f)
+					range = 1.0f;
+				scale[c] = isSigned ? range * 0.5f : range;
+				bias[c] = isSigned ? (minimum + maximum) * 0.5f : minimum;
+			}
+		}
+
+		unsigned int stored = GetStoredComponents(attribute);
+		unsigned int componentSize = GetComponentSize(attribute.format);
+		for (unsigned int v = 0; v < vertex_count; v++)
+		{
+			const float* source = vertices + v * sourceStride + sourceOffset;
+			unsigned char* destination = mesh.data.data() + v * stride + offset;
+
+			glm::vec4 value(0.0f), decoded(0.0f);
+			for (unsigned int c = 0; c < attribute.components && c < 4; c++)
+				value[c] = (source[c] - bias[c]) / scale[c];
+
+			if (attribute.format == VertexFormat::Snorm1010102)
+			{
+				uint32_t packed = PackSnorm1010102(value);
+				std::memcpy(destination, &packed, sizeof(packed));
+				decoded = UnpackSnorm1010102(packed);
+			}
+			else
+			{
+				//Components past the 4th can't be fitted, they are only clamped
+				for (unsigned int c = 0; c < stored; c++)
+				{
+					float component = c < 4 ? value[c] : (c < attribute.components ? source[c] : 0.0f);
+					float result = StoreComponent(attribute.format, component, destination + c * componentSize);
+					if (c < 4)
+						decoded[c] = result;
+					else if (c < attribute.components)
+						maxError = std::max(maxError, std::abs(result - source[c]));
+				}
+			}
+
+			for (unsigned int c = 0; c < attribute.components && c < 4; c++)
+				maxError = std::max(maxError, std::abs(decoded[c] * scale[c] + bias[c] - source[c]));
+		}
+
+		mesh.scales.push_back(scale);
+		mesh.offsets.push_back(bias);
+		mesh.maxErrors.push_back(maxError);
+
+		sourceOffset += attribute.components;
+		offset += componentSize ? stored * componentSize : 4;
+	}
+
+	return mesh;
+}
+
+
+//  Half Floats //
+uint16_t VertexQuantizer::FloatToHalf(float value)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+
+	uint32_t sign = (bits >> 16) & 0x8000;
+	uint32_t biasedExponent = (bits >> 23) & 0xFF;
+	uint32_t mantissa = bits & 0x7FFFFF;
+	int exponent = (int)biasedExponent - 127 + 15;
+
+	if (biasedExponent == 0xFF)
+		return (uint16_t)(sign | 0x7C00 | (mantissa ? 0x200 : 0));		//Infinity or NaN
+	if (exponent >= 31)
+		return (uint16_t)(sign | 0x7C00);
+
+	//Too small for a normal half, the implicit 1 moves into the mantissa
+	if (exponent <= 0)
+	{
+		if (exponent < -10)
+			return (uint16_t)sign;
+
+		mantissa |= 0x800000;
+		uint32_t shift = 14 - exponent;
+		uint32_t half = mantissa >> shift;
+		uint32_t remainder = mantissa & ((1u << shift) - 1), halfway = 1u << (shift - 1);
+		if (remainder > halfway || (remainder == halfway && (half & 1)))
+			half++;
+		return (uint16_t)(sign | half);
+	}
+
+	//Rounding can carry into the exponent, which is still the right result (up to infinity)
+	uint32_t half = ((uint32_t)exponent << 10) | (mantissa >> 13);
+	uint32_t remainder = mantissa & 0x1FFF;
+	if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+		half++;
+	return (uint16_t)(sign | half);
+}
+
+
+float VertexQuantizer::HalfToFloat(uint16_t half)
+{
+	uint32_t sign = (uint32_t)(half & 0x8000) << 16;
+	uint32_t exponent = (half >> 10) & 0x1F;
+	uint32_t mantissa = half & 0x3FF;
+
+	if (exponent == 0)
+	{
+		float value = std::ldexp((float)mantissa, -24);
+		return sign ? -value : value;
+	}
+
+	uint32_t bits = exponent == 31 ? sign | 0x7F800000 | (mantissa << 13) : sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+	float value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+
+//  Packed Normals  //
+uint32_t VertexQuantizer::PackSnorm1010102(const glm::vec4& value)
+{
+	auto pack = [](float component, float max, uint32_t mask)
+	{
+		int quantized = (int)std::round(std::min(std::max(component, -1.0f), 1.0f) * max);
+		return (uint32_t)quantized & mask;
+	};
+
+	return pack(value.x, 511.0f, 0x3FF) | (pack(value.y, 511.0f, 0x3FF) << 10) | (pack(value.z, 511.0f, 0x3FF) << 20) | (pack(value.w, 1.0f, 0x3) << 30);
+}
+
+
+glm::vec4 VertexQuantizer::UnpackSnorm1010102(uint32_t packed)
+{
+	//Sign extending each field, GL 4.2+ decodes as max(c / max, -1)
+	auto unpack = [](int32_t field, int bits, float max)
+	{
+		int32_t value = (int32_t)((uint32_t)field << (32 - bits)) >> (32 - bits);
+		return std::max(value / max, -1.0f);
+	};
+
+	return glm::vec4(unpack(packed & 0x3FF, 10, 511.0f), unpack((packed >> 10) & 0x3FF, 10, 511.0f),
+		unpack((packed >> 20) & 0x3FF, 10, 511.0f), unpack(packed >> 30, 2, 1.0f));
+}
+
+
+//  Formats //
+unsigned int VertexQuantizer::GetStoredComponents(const VertexAttributeFormat& attribute)
+{
+	unsigned int size = GetComponentSize(attribute.format);
+	if (size == 0)
+		return 4;
+
+	unsigned int perWord = 4 / size;
+	return (attribute.components + perWord - 1) / perWord * perWord;
+}
+
+
+unsigned int VertexQuantizer::GetComponentSize(VertexFormat format)
+{
+	switch (format)
+	{
+		case VertexFormat::Float:			return 4;
+		case VertexFormat::Half:			return 2;
+		case VertexFormat::Snorm16:			return 2;
+		case VertexFormat::Unorm16:			return 2;
+		case VertexFormat::Snorm8:			return 1;
+		case VertexFormat::Unorm8:			return 1;
+		case VertexFormat::Snorm1010102:	return 0;
+		case VertexFormat::UInt8:			return 1;
+		case VertexFormat::UInt16:			return 2;
+		case VertexFormat::UInt32:			return 4;
+	}
+
+	return 4;
+}
+
+
+void VertexQuantizer::PushAttribute(VertexBufferLayout& layout, const VertexAttributeFormat& attribute)
+{
+	unsigned int count = GetStoredComponents(attribute);
+	switch (attribute.format)
+	{
+		case VertexFormat::Float:			layout.Push<float>(count);					break;
+		case VertexFormat::Half:			layout.Push<Half>(count);					break;
+		case VertexFormat::Snorm16:			layout.Push<short>(count);					break;
+		case VertexFormat::Unorm16:			layout.Push<unsigned short>(count);			break;
+		case VertexFormat::Snorm8:			layout.Push<signed char>(count);			break;
+		case VertexFormat::Unorm8:			layout.Push<unsigned char>(count);			break;
+		case VertexFormat::Snorm1010102:	layout.Push<Snorm1010102>(1);				break;
+		case VertexFormat::UInt8:			layout.PushInteger<unsigned char>(count);	break;
+		case VertexFormat::UInt16:			layout.PushInteger<unsigned short>(count);	break;
+		case VertexFormat::UInt32:			layout.PushInteger<unsigned int>(count);	break;
+	}
+}
+
+
+bool VertexQuantizer::IsNormalized(VertexFormat format, bool& is_signed)
+{
+	is_signed = format == VertexFormat::Snorm16 || format == VertexFormat::Snorm8 || format == VertexFormat::Snorm1010102;
+	return is_signed || format == VertexFormat::Unorm16 || format == VertexFormat::Unorm8;
+}
+
+
+float VertexQuantizer::StoreComponent(VertexFormat format, float value, unsigned char* out)
+{
+	auto clamp = [](float x, float low, float high) { return std::min(std::max(x, low), high); };
+
+	switch (format)
+	{
+		case VertexFormat::Float:
+		{
+			std::memcpy(out, &value, sizeof(value));
+			return value;
+		}
+		case VertexFormat::Half:
+		{
+			uint16_t half = FloatToHalf(value);
+			std::memcpy(out, &half, sizeof(half));
+			return HalfToFloat(half);
+		}
+		case VertexFormat::Snorm16:
+		{
+			int16_t quantized = (int16_t)std::round(clamp(value, -1.0f, 1.0f) * 32767.0f);
+			std::memcpy(out, &quantized, sizeof(quantized));
+			return std::max(quantized / 32767.0f, -1.0f);
+		}
+		case VertexFormat::Unorm16:
+		{
+			uint16_t quantized = (uint16_t)std::round(clamp(value, 0.0f, 1.0f) * 65535.0f);
+			std::memcpy(out, &quantized, sizeof(quantized));
+			return quantized / 65535.0f;
+		}
+		case VertexFormat::Snorm8:
+		{
+			int8_t quantized = (int8_t)std::round(clamp(value, -1.0f, 1.0f) * 127.0f);
+			std::memcpy(out, &quantized, sizeof(quantized));
+			return std::max(quantized / 127.0f, -1.0f);
+		}
+		case VertexFormat::Unorm8:
+		{
+			uint8_t quantized = (uint8_t)std::round(clamp(value, 0.0f, 1.0f) * 255.0f);
+			*out = quantized;
+			return quantized / 255.0f;
+		}
+		case VertexFormat::UInt8:
+		{
+			uint8_t quantized = (uint8_t)std::round(clamp(value, 0.0f, 255.0f));
+			*out = quantized;
+			return quantized;
+		}
+		case VertexFormat::UInt16:
+		{
+			uint16_t quantized = (uint16_t)std::round(clamp(value, 0.0f, 65535.0f));
+			std::memcpy(out, &quantized, sizeof(quantized));
+			return quantized;
+		}
+		case VertexFormat::UInt32:
+		{
+			uint32_t quantized = (uint32_t)std::round(std::min(std::max((double)value, 0.0), 4294967295.0));
+			std::memcpy(out, &quantized, sizeof(quantized));
+			return (float)quantized;
+		}
+		case VertexFormat::Snorm1010102:
+			break;		//Whole attributes only, see Quantize()
+	}
+
+	return value;
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "VertexBufferLayout.h"
+
+
+//How one attribute is stored in a quantized vertex
+enum class VertexFormat
+{
+	Float,			//32 bit float, as it is
+	Half,			//16 bit float, ~3 significant digits
+	Snorm16,		//short, -1 - 1 in steps of 1 / 32767
+	Unorm16,		//unsigned short, 0 - 1 in steps of 1 / 65535
+	Snorm8,			//signed char, -1 - 1 in steps of 1 / 127
+	Unorm8,			//unsigned char, 0 - 1 in steps of 1 / 255
+	Snorm1010102,	//x, y & z in 10 bits (steps of 1 / 511) & w in 2 bits (-1, 0 or 1), 4 bytes for up to 4 components
+	UInt8,			//Integer attributes, read as uint / uvec by the shader, values are rounded
+	UInt16,
+	UInt32
+};
+
+struct VertexAttributeFormat
+{
+	unsigned int components;
+	VertexFormat format;
+	bool fitBounds;		//Normalized formats: values are remapped from their bounds to the format's range, otherwise they are clamped to it
+
+	VertexAttributeFormat(unsigned int components, VertexFormat format, bool fit_bounds = false)
+		: components(components), format(format), fitBounds(fit_bounds)
+	{
+
+	}
+};
+
+//Interleaved quantized vertices & what is needed to draw & decode them
+struct QuantizedMesh
+{
+	std::vector<unsigned char> data;
+	VertexBufferLayout layout;
+	unsigned int vertexCount = 0;
+	unsigned int sourceSize = 0;		//Bytes of the float vertices it was made from
+
+	//Per attribute: original = stored * scale + offset, for the shader (or folded into a matrix)
+	std::vector<glm::vec4> scales, offsets;
+	std::vector<float> maxErrors;		//Per attribute, largest difference of a decoded component to the original
+
+	inline unsigned int GetSize() const { return (unsigned int)data.size(); };
+};
+
+
+/*
+Converts float meshes into smaller vertex formats.
+Attributes are padded to a multiple of 4 bytes (e.g. 3 halves are stored as 4), unaligned attributes are slow to fetch
+on a lot of hardware, so a 3 component attribute is read as a vec4 with 0 in the padding.
+*/
+class VertexQuantizer
+{
+public:
+	//vertices are interleaved floats, the components of every attribute in the order they are given
+	static QuantizedMesh Quantize(const float* vertices, unsigned int vertex_count, const std::vector<VertexAttributeFormat>& attributes);
+
+	static uint16_t FloatToHalf(float value);		//Rounded to nearest even, out of range values become infinity
+	static float HalfToFloat(uint16_t half);
+	static uint32_t PackSnorm1010102(const glm::vec4& value);
+	static glm::vec4 UnpackSnorm1010102(uint32_t packed);
+
+	static unsigned int GetStoredComponents(const VertexAttributeFormat& attribute);		//With the padding
+	static unsigned int GetComponentSize(VertexFormat format);		//Bytes, 0 for packed formats
+
+private:
+	static void PushAttribute(VertexBufferLayout& layout, const VertexAttributeFormat& attribute);
+	static bool IsNormalized(VertexFormat format, bool& is_signed);
+	//Stores one component & returns the value it decodes to (before scale & offset)
+	static float StoreComponent(VertexFormat format, float value, unsigned char* out);
+};
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "imgui/imgui.h"
+
+#include "TestAsyncTextures.h"
+#include "Renderer.h"
+#include "AsyncTextureLoader.h"
+#include "UploadManager.h"
+
+#include <chrono>
+#include <vector>
+
+
+namespace test
+{
+	TestAsyncTextures::TestAsyncTextures()
+		: proj(glm::ortho(0.0f, 1280.0f, 0.0f, 720.0f)),
+		textureCount(128), uploadsPerFrame(8), uploadBudget(UploadManager::Get().GetBudget() / 1024),
+		largeTextureTime(0.0f), syncLoadTime(0.0f)
+	{
+		float positions[] = {
+			 0.0f,  0.0f, 0.0f, 0.0f,
+			40.0f,  0.0f, 1.0f, 0.0f,
+			40.0f, 40.0f, 1.0f, 1.0f,
+			 0.0f, 40.0f, 0.0f, 1.0f
+		};
+
+		unsigned int indices[] = {
+			0, 1, 2,
+			2, 3, 0
+		};
+
+		va = std::make_unique<VertexArray>();
+		vb = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+		VertexBufferLayout layout;
+		layout.Push<float>(2);
+		layout.Push<float>(2);
+		va->AddBuffer(*vb, layout);
+
+		ib = std::make_unique<IndexBuffer>(indices, 6);
+
+		shader = std::make_unique<Shader>("res/shaders/Texture.shader");
+		shader->Bind();
+		shader->SetUniform1i("u_Texture", 0);
+
+		LoadTextures();
+	}
+
+	TestAsyncTextures::~TestAsyncTextures()
+	{
+	}
+
+
+	void TestAsyncTextures::OnUpdate(float delta_time)
+	{
+		//The application already uploads a few per frame, this lets the slider push harder
+		AsyncTextureLoader::Get().Update(uploadsPerFrame);
+		UploadManager::Get().SetBudget(uploadBudget * 1024);
+	}
+
+
+	void TestAsyncTextures::OnRender()
+	{
+		glErrorCall( glClearColor(0.0f, 0.0f, 0.0f, 1.0f) );
+		glErrorCall( glClear(GL_COLOR_BUFFER_BIT) );
+
+		Renderer renderer;
+		shader->Bind();
+
+		//Placeholders are drawn like any other texture
+		for (unsigned int i = 0; i < textures.size(); i++)
+		{
+			glm::vec3 position(20.0f + (i % 28) * 44.0f, 660.0f - (i / 28) * 44.0f, 0.0f);
+			textures[i]->Bind();
+			shader->SetUniformMat4f(UNIFORM_ID("u_MVP"), glm::translate(proj, position));
+			renderer.Draw(*va, *ib, *shader);
+		}
+
+		//Fills in from the bottom, a few rows per frame
+		if (largeTexture)
+		{
+			glm::mat4 model = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(1000.0f, 20.0f, 0.0f)), glm::vec3(6.4f));
+			largeTexture->Bind();
+			shader->SetUniformMat4f(UNIFORM_ID("u_MVP"), proj * model);
+			renderer.Draw(*va, *ib, *shader);
+		}
+	}
+
+
+	void TestAsyncTextures::OnImGuiRender()
+	{
+		ImGui::SliderInt("Textures", &textureCount, 1, 364);
+		ImGui::SliderInt("Uploads per frame", &uploadsPerFrame, 1, 64);
+		if (ImGui::Button("Reload"))
+			LoadTextures();
+
+		ImGui::SliderInt("Upload budget (KB/frame)", &uploadBudget, 64, UploadManager::maxBudget / 1024);
+		if (ImGui::Button("Create 4096x4096 texture"))
+			CreateLargeTexture();
+		if (largeTexture)
+		{
+			ImGui::SameLine();
+			ImGui::Text("%s, constructor took %.2f ms", largeTexture->IsLoaded() ? "uploaded" : "uploading", largeTextureTime);
+		}
+
+		unsigned int loaded = 0;
+		for (const std::shared_ptr<Texture>& texture : textures)
+			loaded += texture->IsLoaded();
+
+		AsyncTextureLoader& loader = AsyncTextureLoader::Get();
+		const AsyncTextureLoader::Stats& stats = loader.GetStats();
+		ImGui::Text("%u of %u textures loaded, %u workers", loaded, (unsigned int)textures.size(), loader.GetWorkerCount());
+		ImGui::Text("Queue depth: %u waiting for a worker, %u waiting for upload", stats.queued, stats.decoded);
+		ImGui::Text("Latency: %.2f ms until decoded, %.2f ms until uploaded (avg)", stats.decodeLatency, stats.uploadLatency);
+		ImGui::Text("Loading one texture on the render thread: %.2f ms", syncLoadTime);
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+
+	void TestAsyncTextures::LoadTextures()
+	{
+		//What every texture used to cost the frame
+		auto start = std::chrono::high_resolution_clock::now();
+		{
+			Texture texture("res/textures/Spookzie_Logo.png");
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+		syncLoadTime = std::chrono::duration<float, std::milli>(end - start).count();
+
+		//Dropping the old ones first also cancels whatever of them wasn't decoded yet
+		textures.clear();
+		AsyncTextureLoader::Get().ResetStats();
+		for (int i = 0; i < textureCount; i++)
+			textures.push_back(AsyncTextureLoader::Get().Load("res/textures/Spookzie_Logo.png"));
+	}
+
+
+	//64 MB of gradient, enough to stall a frame when uploaded in one go
+	void TestAsyncTextures::CreateLargeTexture()
+	{
+		const int size = 4096;
+		std::vector<unsigned char> pixels(size * size * 4);
+		for (int y = 0; y < size; y++)
+		{
+			for (int x = 0; x < size; x++)
+			{
+				unsigned char* pixel = &pixels[(y * size + x) * 4];
+				pixel[0] = (unsigned char)(x * 255 / size);
+				pixel[1] = (unsigned char)(y * 255 / size);
+				pixel[2] = (unsigned char)(((x / 256) + (y / 256)) % 2 * 255);
+				pixel[3] = 255;
+			}
+		}
+
+		auto start = std::chrono::high_resolution_clock::now();
+		largeTexture = std::make_unique<Texture>(size, size, pixels.data());
+		auto end = std::chrono::high_resolution_clock::now();
+		largeTextureTime = std::chrono::duration<float, std::milli>(end - start).count();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Test.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+
+#include <memory>
+#include <vector>
+
+
+namespace test
+{
+	//Loads a grid of textures through the AsyncTextureLoader, they pop in while the frame keeps going.
+	//A generated 4096x4096 texture shows the UploadManager spreading one image over many frames.
+	class TestAsyncTextures : public Test
+	{
+	private:
+		std::unique_ptr<VertexArray> va;
+		std::unique_ptr<VertexBuffer> vb;
+		std::unique_ptr<IndexBuffer> ib;
+		std::unique_ptr<Shader> shader;
+		std::vector<std::shared_ptr<Texture>> textures;
+		std::unique_ptr<Texture> largeTexture;
+
+		glm::mat4 proj;
+
+		int textureCount;
+		int uploadsPerFrame;
+		int uploadBudget;		//KB per frame
+		float largeTextureTime;		//ms the constructor of the large texture took
+		float syncLoadTime;		//ms for loading one texture on the render thread, for comparison
+
+	public:
+		TestAsyncTextures();
+		~TestAsyncTextures();
+
+		void OnUpdate(float delta_time) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		void LoadTextures();
+		void CreateLargeTexture();
+	};
+}
\ No newline at end of file
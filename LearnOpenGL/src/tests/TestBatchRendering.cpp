@@ -0,0 +1,130 @@
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "imgui/imgui.h"
+
+#include "TestBatchRendering.h"
+#include "VertexBufferLayout.h"
+
+#include <chrono>
+#include <cmath>
+
+
+namespace test
+{
+	TestBatchRendering::TestBatchRendering()
+		: proj(glm::ortho(0.0f, 1280.0f, 0.0f, 720.0f)),
+		view(glm::mat4(1.0f)),
+		quadCount(10000), batched(true), renderTime(0.0f), drawCalls(0)
+	{
+		batchRenderer = std::make_unique<BatchRenderer>();
+		texture = std::make_unique<Texture>("res/textures/Spookzie_Logo.png");
+
+		//Same vertex format as the batch renderer, so both paths run the same shader
+		BatchVertex vertices[] = {
+			{ { -0.5f, -0.5f, 0.0f }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f }, 0.0f },
+			{ {  0.5f, -0.5f, 0.0f }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 1.0f, 0.0f }, 0.0f },
+			{ {  0.5f,  0.5f, 0.0f }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f }, 0.0f },
+			{ { -0.5f,  0.5f, 0.0f }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 0.0f, 1.0f }, 0.0f }
+		};
+
+		unsigned int indices[] = {
+			0, 1, 2,
+			2, 3, 0
+		};
+
+		va = std::make_unique<VertexArray>();
+		vb = std::make_unique<VertexBuffer>(vertices, (unsigned int)sizeof(vertices));
+		VertexBufferLayout layout;
+		layout.Push<float>(3);
+		layout.Push<float>(4);
+		layout.Push<float>(2);
+		layout.Push<float>(1);
+		va->AddBuffer(*vb, layout);
+
+		ib = std::make_unique<IndexBuffer>(indices, 6);
+
+		int samplers[BatchRenderer::maxTextureSlots] = { 0 };
+		shader = std::make_unique<Shader>("res/shaders/Batch.shader");
+		shader->Bind();
+		shader->SetUniform1iv("u_Textures", BatchRenderer::maxTextureSlots, samplers);
+	}
+
+	TestBatchRendering::~TestBatchRendering()
+	{
+	}
+
+
+	void TestBatchRendering::OnUpdate(float delta_time)
+	{
+	}
+
+
+	void TestBatchRendering::OnRender()
+	{
+		glErrorCall( glClearColor(0.0f, 0.0f, 0.0f, 1.0f) );
+		glErrorCall( glClear(GL_COLOR_BUFFER_BIT) );
+
+		auto start = std::chrono::high_resolution_clock::now();
+		glm::mat4 viewProj = proj * view;
+
+		if (batched)
+		{
+			batchRenderer->ResetStats();
+			batchRenderer->BeginBatch(viewProj);
+
+			for (int i = 0; i < quadCount; i++)
+				batchRenderer->SubmitQuad(GetQuadTransform(i), glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), glm::vec4(1.0f), texture.get());
+
+			batchRenderer->EndBatch();
+			drawCalls = batchRenderer->GetStats().flushCount;
+		}
+		else
+		{
+			//The current path: uniform upload & a full draw for every single quad
+			Renderer renderer;
+			texture->Bind();
+
+			for (int i = 0; i < quadCount; i++)
+			{
+				shader->Bind();
+				shader->SetUniformMat4f(UNIFORM_ID("u_ViewProj"), viewProj * GetQuadTransform(i));
+				renderer.Draw(*va, *ib, *shader);
+			}
+			drawCalls = quadCount;
+		}
+
+		auto end = std::chrono::high_resolution_clock::now();
+		renderTime = std::chrono::duration<float, std::milli>(end - start).count();
+	}
+
+
+	void TestBatchRendering::OnImGuiRender()
+	{
+		ImGui::RadioButton("10k", &quadCount, 10000);		ImGui::SameLine();
+		ImGui::RadioButton("100k", &quadCount, 100000);	ImGui::SameLine();
+		ImGui::RadioButton("1M", &quadCount, 1000000);
+		ImGui::Checkbox("Batched", &batched);
+
+		ImGui::Text("Quads: %d", quadCount);
+		ImGui::Text("Draw calls: %u", drawCalls);
+		ImGui::Text("Submit + draw (CPU): %.3f ms", renderTime);
+
+		const StreamingBuffer& stream = batchRenderer->GetVertexStream();
+		ImGui::Text("Vertex stream: %s", stream.IsPersistent() ? "persistent mapping" : "unsynchronized mapping + orphaning");
+		ImGui::Text("Stalls: %u (%.3f ms), orphans: %u", stream.GetStats().stalls, stream.GetStats().stallTime, stream.GetStats().orphans);
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+
+	//Laying the quads out in a grid that fills the window
+	glm::mat4 TestBatchRendering::GetQuadTransform(int index) const
+	{
+		int columns = (int)std::ceil(std::sqrt(quadCount * 1280.0f / 720.0f));
+		float size = 1280.0f / columns;
+
+		glm::vec3 position((index % columns + 0.5f) * size, (index / columns + 0.5f) * size, 0.0f);
+		glm::mat4 model = glm::translate(glm::mat4(1.0f), position);
+		return glm::scale(model, glm::vec3(size, size, 1.0f));
+	}
+}
\ No newline at end of file
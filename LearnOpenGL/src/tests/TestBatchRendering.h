@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Test.h"
+#include "BatchRenderer.h"
+
+#include <memory>
+
+
+namespace test
+{
+	//Stress test comparing the batch renderer against one Renderer::Draw per quad
+	class TestBatchRendering : public Test
+	{
+	private:
+		std::unique_ptr<BatchRenderer> batchRenderer;
+		std::unique_ptr<Texture> texture;
+
+		//Single quad for the per-quad path
+		std::unique_ptr<VertexArray> va;
+		std::unique_ptr<VertexBuffer> vb;
+		std::unique_ptr<IndexBuffer> ib;
+		std::unique_ptr<Shader> shader;
+
+		glm::mat4 proj, view;
+
+		int quadCount;
+		bool batched;
+		float renderTime;	//CPU time of the last OnRender() in ms
+		unsigned int drawCalls;
+
+	public:
+		TestBatchRendering();
+		~TestBatchRendering();
+
+		void OnUpdate(float delta_time) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		glm::mat4 GetQuadTransform(int index) const;
+	};
+}
\ No newline at end of file
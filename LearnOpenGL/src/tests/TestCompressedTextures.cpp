@@ -0,0 +1,220 @@
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "imgui/imgui.h"
+
+#include "TestCompressedTextures.h"
+#include "Renderer.h"
+#include "TextureCompressor.h"
+#include "MipGenerator.h"
+#include "UploadManager.h"
+#include "stb_image/stb_image.h"
+
+#include <chrono>
+
+#ifdef _WIN32
+	#include <direct.h>
+#else
+	#include <sys/stat.h>
+#endif
+
+
+namespace test
+{
+	static const char* sourceFile = "res/textures/Spookzie_Logo.png";
+	static const char* cacheDirectory = "res/textures/cache/";
+	static const char* candidateNames[] = { "RGBA8 (PNG)", "BC1", "BC3" };
+	static const int loadRepeats = 8;
+
+
+	TestCompressedTextures::TestCompressedTextures()
+		: proj(glm::ortho(0.0f, 1280.0f, 0.0f, 720.0f)),
+		quality((int)TextureCompressor::Quality::High), passes(20), preview(1),
+		supported(IsTextureFormatSupported(TextureFormat::BC1))
+	{
+		//Covers the whole window, every pass samples 1280x720 texels
+		float positions[] = {
+			   0.0f,   0.0f, 0.0f, 0.0f,
+			1280.0f,   0.0f, 1.0f, 0.0f,
+			1280.0f, 720.0f, 1.0f, 1.0f,
+			   0.0f, 720.0f, 0.0f, 1.0f
+		};
+
+		unsigned int indices[] = {
+			0, 1, 2,
+			2, 3, 0
+		};
+
+		va = std::make_unique<VertexArray>();
+		vb = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+		VertexBufferLayout layout;
+		layout.Push<float>(2);
+		layout.Push<float>(2);
+		va->AddBuffer(*vb, layout);
+
+		ib = std::make_unique<IndexBuffer>(indices, 6);
+
+		shader = std::make_unique<Shader>("res/shaders/Texture.shader");
+		shader->Bind();
+		shader->SetUniform1i("u_Texture", 0);
+
+		Prepare();
+	}
+
+	TestCompressedTextures::~TestCompressedTextures()
+	{
+	}
+
+
+	void TestCompressedTextures::OnUpdate(float delta_time)
+	{
+	}
+
+
+	void TestCompressedTextures::OnRender()
+	{
+		glErrorCall( glClearColor(0.0f, 0.0f, 0.0f, 1.0f) );
+		glErrorCall( glClear(GL_COLOR_BUFFER_BIT) );
+
+		shader->Bind();
+		for (Candidate& candidate : candidates)
+		{
+			if (candidate.texture)
+				MeasureSampling(candidate);
+		}
+
+		//The passes above are only for timing, the preview is drawn at the image's own size
+		glErrorCall( glClear(GL_COLOR_BUFFER_BIT) );
+		Texture* texture = candidates[preview].texture.get();
+		if (texture)
+		{
+			glm::vec3 position(640.0f - texture->GetWidth() / 2, 360.0f - texture->GetHeight() / 2, 0.0f);
+			glm::vec3 scale(texture->GetWidth() / 1280.0f, texture->GetHeight() / 720.0f, 1.0f);
+			texture->Bind();
+			shader->SetUniformMat4f(UNIFORM_ID("u_MVP"), glm::scale(glm::translate(proj, position), scale));
+
+			Renderer renderer;
+			renderer.Draw(*va, *ib, *shader);
+		}
+	}
+
+
+	void TestCompressedTextures::OnImGuiRender()
+	{
+		if (!supported)
+		{
+			ImGui::Text("The driver doesn't support S3TC (BC1/BC3) textures");
+			return;
+		}
+
+		const char* qualityNames[] = { "Fast", "High" };
+		ImGui::Combo("Encoder quality", &quality, qualityNames, 2);
+		ImGui::SameLine();
+		if (ImGui::Button("Encode & reload"))
+			Prepare();
+
+		ImGui::SliderInt("Passes per frame", &passes, 1, 100);
+		ImGui::Combo("Preview", &preview, candidateNames, formatCount);
+
+		ImGui::Separator();
+		ImGui::Columns(6, "formats");
+		ImGui::Text("Format");				ImGui::NextColumn();
+		ImGui::Text("Load (ms)");			ImGui::NextColumn();
+		ImGui::Text("GPU memory (KB)");		ImGui::NextColumn();
+		ImGui::Text("Encode (ms)");			ImGui::NextColumn();
+		ImGui::Text("RMSE");				ImGui::NextColumn();
+		ImGui::Text("Gtexels/s");			ImGui::NextColumn();
+		ImGui::Separator();
+
+		for (int i = 0; i < formatCount; i++)
+		{
+			const Candidate& candidate = candidates[i];
+			float gpuTime = candidate.timer.GetMilliseconds();
+			float sampleRate = gpuTime > 0.0f ? passes * 1280.0f * 720.0f / (gpuTime * 1.0e6f) : 0.0f;		//Texels per ns = Gtexels/s
+			ImGui::Text("%s", candidateNames[i]);									ImGui::NextColumn();
+			ImGui::Text("%.2f", candidate.loadTime);								ImGui::NextColumn();
+			ImGui::Text("%.1f", candidate.texture ? candidate.texture->GetSize() / 1024.0f : 0.0f);		ImGui::NextColumn();
+			ImGui::Text("%.2f", candidate.encodeTime);								ImGui::NextColumn();
+			ImGui::Text("%.2f", candidate.rmse);									ImGui::NextColumn();
+			ImGui::Text("%.2f", sampleRate);										ImGui::NextColumn();
+		}
+		ImGui::Columns(1);
+
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+
+	//Encodes the source into the cache directory, then times loading each file the way the application would
+	void TestCompressedTextures::Prepare()
+	{
+		if (!supported)
+			return;
+
+		#ifdef _WIN32
+			_mkdir(cacheDirectory);
+		#else
+			mkdir(cacheDirectory, 0755);
+		#endif
+
+		candidates[0].filePath = sourceFile;
+		candidates[1].filePath = std::string(cacheDirectory) + "Spookzie_Logo_bc1.dds";
+		candidates[2].filePath = std::string(cacheDirectory) + "Spookzie_Logo_bc3.dds";
+
+		//Containers are bottom-up, the source is flipped like the texture loader flips PNGs
+		int width, height, bpp;
+		stbi_set_flip_vertically_on_load(1);
+		unsigned char* pixels = stbi_load(sourceFile, &width, &height, &bpp, 4);
+		if (!pixels)
+			return;
+
+		TextureImage source;
+		source.width = width;
+		source.height = height;
+		source.levels.emplace_back(pixels, pixels + width * height * 4);
+		stbi_image_free(pixels);
+		MipGenerator::Generate(source);
+
+		const TextureFormat formats[] = { TextureFormat::BC1, TextureFormat::BC3 };
+		for (int i = 1; i < formatCount; i++)
+		{
+			TextureCompressor::EncodeStats stats;
+			TextureImage image = TextureCompressor::Encode(source, formats[i - 1], (TextureCompressor::Quality)quality, 0, &stats);
+			TextureCompressor::Save(candidates[i].filePath, image);
+			candidates[i].encodeTime = stats.time;
+			candidates[i].rmse = stats.rmse;
+		}
+
+		//Large RGBA8 levels would go up through the upload manager over the next frames while compressed levels go up right away,
+		//so every load is flushed & glFinish waits for the GPU: all formats are timed until their texture is complete
+		for (Candidate& candidate : candidates)
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+			for (int i = 0; i < loadRepeats; i++)
+			{
+				candidate.texture = std::make_unique<Texture>(candidate.filePath);
+				UploadManager::Get().Flush(GL_TEXTURE_2D, candidate.texture->GetRendererID());
+			}
+			glErrorCall( glFinish() );
+			auto end = std::chrono::high_resolution_clock::now();
+
+			candidate.loadTime = std::chrono::duration<float, std::milli>(end - start).count() / loadRepeats;
+			candidate.timer.Reset();
+		}
+	}
+
+
+	//Timed only when the previous measurement is back, the GPU is never waited on
+	void TestCompressedTextures::MeasureSampling(Candidate& candidate)
+	{
+		if (!candidate.timer.Begin())
+			return;
+
+		Renderer renderer;
+		candidate.texture->Bind();
+		shader->SetUniformMat4f(UNIFORM_ID("u_MVP"), proj);
+		for (int i = 0; i < passes; i++)
+			renderer.Draw(*va, *ib, *shader);
+
+		candidate.timer.End();
+	}
+}
\ No newline at end of file
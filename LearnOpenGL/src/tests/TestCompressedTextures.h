@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Test.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+#include "GpuTimer.h"
+
+#include <memory>
+#include <string>
+
+
+namespace test
+{
+	//Benchmarks the PNG -> RGBA8 path against BC1 & BC3 containers made from the same image:
+	//load time, GPU memory, encoder error & sampling throughput (full screen passes timed with GL_TIME_ELAPSED)
+	class TestCompressedTextures : public Test
+	{
+	private:
+		static const int formatCount = 3;		//RGBA8 (PNG), BC1, BC3
+
+		struct Candidate
+		{
+			std::string filePath;
+			std::unique_ptr<Texture> texture;
+			float loadTime = 0.0f;		//ms per load, averaged
+			float encodeTime = 0.0f;
+			float rmse = 0.0f;
+			GpuTimer timer;				//All passes of a frame
+		};
+
+		std::unique_ptr<VertexArray> va;
+		std::unique_ptr<VertexBuffer> vb;
+		std::unique_ptr<IndexBuffer> ib;
+		std::unique_ptr<Shader> shader;
+		Candidate candidates[formatCount];
+
+		glm::mat4 proj;
+
+		int quality;		//TextureCompressor::Quality
+		int passes;		//Full screen draws per format & frame
+		int preview;		//Candidate drawn on screen
+		bool supported;
+
+	public:
+		TestCompressedTextures();
+		~TestCompressedTextures();
+
+		void OnUpdate(float delta_time) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		void Prepare();
+		void MeasureSampling(Candidate& candidate);
+	};
+}
\ No newline at end of file
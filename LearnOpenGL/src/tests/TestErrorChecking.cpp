@@ -0,0 +1,162 @@
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "imgui/imgui.h"
+
+#include "TestErrorChecking.h"
+#include "Renderer.h"
+
+#include <chrono>
+
+
+namespace test
+{
+	static const char* modeNames[] = { "None", "Debug output (async)", "Debug output (sync)", "Poll (glGetError)" };
+
+
+	TestErrorChecking::TestErrorChecking()
+		: proj(glm::ortho(0.0f, 1280.0f, 0.0f, 720.0f)),
+		drawsPerMode(2000), selectedMode((int)GetGLErrorMode()), callTime()
+	{
+		float positions[] = {
+			-5.0f, -5.0f, 0.0f, 0.0f,
+			 5.0f, -5.0f, 1.0f, 0.0f,
+			 5.0f,  5.0f, 1.0f, 1.0f,
+			-5.0f,  5.0f, 0.0f, 1.0f
+		};
+
+		unsigned int indices[] = {
+			0, 1, 2,
+			2, 3, 0
+		};
+
+		va = std::make_unique<VertexArray>();
+		vb = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+		VertexBufferLayout layout;
+		layout.Push<float>(2);
+		layout.Push<float>(2);
+		va->AddBuffer(*vb, layout);
+
+		ib = std::make_unique<IndexBuffer>(indices, 6);
+
+		shader = std::make_unique<Shader>("res/shaders/Texture.shader");
+		shader->Bind();
+		shader->SetUniform1i("u_Texture", 0);
+	}
+
+	TestErrorChecking::~TestErrorChecking()
+	{
+	}
+
+
+	void TestErrorChecking::OnUpdate(float delta_time)
+	{
+	}
+
+
+	void TestErrorChecking::OnRender()
+	{
+		glErrorCall( glClearColor(0.0f, 0.0f, 0.0f, 1.0f) );
+		glErrorCall( glClear(GL_COLOR_BUFFER_BIT) );
+
+		//Every mode runs the same loop each frame, then the user's choice is put back for the rest of the frame.
+		//Polling is spelled out in the loop, so it is measured in every build (release included)
+		GLErrorMode applied = GetGLErrorMode();
+		for (int mode = 0; mode < modeCount; mode++)
+		{
+			if (!IsModeAvailable((GLErrorMode)mode))
+				continue;
+
+			float time = MeasureMode((GLErrorMode)mode);
+			callTime[mode] = callTime[mode] == 0.0f ? time : callTime[mode] * 0.95f + time * 0.05f;
+		}
+
+		SetGLErrorMode(applied);
+	}
+
+
+	void TestErrorChecking::OnImGuiRender()
+	{
+		const char* compiledModes[] = { "NONE", "DEBUG_OUTPUT_ASYNC", "DEBUG_OUTPUT_SYNC", "POLL" };
+		ImGui::Text("Compiled with GL_ERROR_CHECK_%s", compiledModes[GL_ERROR_CHECK]);
+
+		//Only the modes this build & driver can switch to, picking one is applied once
+		const char* selectableNames[modeCount];
+		int selectableModes[modeCount];
+		int selectableCount = 0, current = 0;
+		for (int mode = 0; mode < modeCount; mode++)
+		{
+			if (!IsModeSelectable((GLErrorMode)mode))
+				continue;
+
+			if (mode == selectedMode)
+				current = selectableCount;
+			selectableNames[selectableCount] = modeNames[mode];
+			selectableModes[selectableCount++] = mode;
+		}
+
+		if (ImGui::Combo("Runtime mode", &current, selectableNames, selectableCount))
+		{
+			selectedMode = selectableModes[current];
+			SetGLErrorMode((GLErrorMode)selectedMode);
+		}
+		ImGui::SliderInt("Draws per mode", &drawsPerMode, 100, 20000);
+
+		ImGui::Separator();
+		for (int mode = 0; mode < modeCount; mode++)
+		{
+			if (!IsModeAvailable((GLErrorMode)mode))
+				ImGui::Text("%-22s needs GL 4.3 or KHR_debug", modeNames[mode]);
+			else
+				ImGui::Text("%-22s %8.1f ns/call (+%.1f)", modeNames[mode], callTime[mode], callTime[mode] - callTime[0]);
+		}
+
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+
+	//Average CPU time of one GL call (uniform upload or draw) with the given checking
+	float TestErrorChecking::MeasureMode(GLErrorMode mode)
+	{
+		//The global mode only drives glErrorCall(), which the loop doesn't use, & polling may not be compiled in
+		SetGLErrorMode(mode == GLErrorMode::Poll ? GLErrorMode::None : mode);
+		shader->Bind();
+		va->Bind();
+		ib->Bind();
+
+		bool poll = mode == GLErrorMode::Poll;
+		int location = glGetUniformLocation(shader->GetRendererID(), "u_MVP");
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < drawsPerMode; i++)
+		{
+			glm::mat4 mvp = glm::translate(proj, glm::vec3((i * 13) % 1280, (i * 7) % 720, 0.0f));
+
+			//Spelled out instead of glErrorCall(), so that all modes can be measured in one build
+			if (poll) glClearErrors();
+			glUniformMatrix4fv(location, 1, GL_FALSE, &mvp[0][0]);
+			if (poll) glLogCall("glUniformMatrix4fv", __FILE__, __LINE__);
+
+			if (poll) glClearErrors();
+			glDrawElements(GL_TRIANGLES, ib->GetCount(), ib->GetType(), nullptr);
+			if (poll) glLogCall("glDrawElements", __FILE__, __LINE__);
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+
+		return std::chrono::duration<float, std::nano>(end - start).count() / (drawsPerMode * 2);
+	}
+
+
+	bool TestErrorChecking::IsModeAvailable(GLErrorMode mode)
+	{
+		bool debugOutput = mode == GLErrorMode::DebugOutputAsync || mode == GLErrorMode::DebugOutputSync;
+		return !debugOutput || GLEW_VERSION_4_3 || GLEW_KHR_debug;
+	}
+
+
+	//Polling can be measured in any build, but only a POLL build can switch glErrorCall() to it
+	bool TestErrorChecking::IsModeSelectable(GLErrorMode mode)
+	{
+		return IsModeAvailable(mode) && (mode != GLErrorMode::Poll || GL_ERROR_CHECK == GL_ERROR_CHECK_POLL);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Test.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+
+#include <memory>
+
+
+namespace test
+{
+	//Measures what each error checking mode adds to every GL call of a draw heavy loop
+	class TestErrorChecking : public Test
+	{
+	private:
+		static const int modeCount = 4;
+
+		std::unique_ptr<VertexArray> va;
+		std::unique_ptr<VertexBuffer> vb;
+		std::unique_ptr<IndexBuffer> ib;
+		std::unique_ptr<Shader> shader;
+
+		glm::mat4 proj;
+
+		int drawsPerMode;
+		int selectedMode;		//Runtime override of the compiled in mode
+		float callTime[modeCount];		//Smoothed ns per GL call, indexed by GLErrorMode
+
+	public:
+		TestErrorChecking();
+		~TestErrorChecking();
+
+		void OnUpdate(float delta_time) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		float MeasureMode(GLErrorMode mode);
+		static bool IsModeAvailable(GLErrorMode mode);
+		static bool IsModeSelectable(GLErrorMode mode);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "imgui/imgui.h"
+
+#include "TestGpuHeap.h"
+#include "Renderer.h"
+#include "GLStateCache.h"
+
+#include <chrono>
+#include <cmath>
+
+
+namespace test
+{
+	TestGpuHeap::TestGpuHeap()
+		: format(0), proj(glm::ortho(0.0f, 1280.0f, 0.0f, 720.0f)),
+		rng(7), useHeap(true), renderTime(0.0f), stateChanges(0)
+	{
+		VertexBufferLayout layout;
+		layout.Push<float>(2);
+		layout.Push<float>(2);
+
+		//Room for every mesh at the largest size, so refilling with other sizes fragments instead of failing
+		heap = std::make_unique<GpuHeap>(meshCount * 32 * 3);
+		format = heap->AddFormat(layout, meshCount * 33);
+
+		std::uniform_real_distribution<float> x(0.0f, 1280.0f), y(0.0f, 720.0f);
+		std::uniform_int_distribution<int> sides(3, 32);
+		std::vector<float> vertices;
+		std::vector<unsigned int> indices;
+		for (int i = 0; i < meshCount; i++)
+		{
+			Object object;
+			object.position = glm::vec2(x(rng), y(rng));
+			object.sides = sides(rng);
+			AllocateMesh(object);
+			objects.push_back(object);
+
+			//The same mesh the old way, for comparison
+			MakePolygon(object.sides, vertices, indices);
+			vas.push_back(std::make_unique<VertexArray>());
+			vbs.push_back(std::make_unique<VertexBuffer>(vertices.data(), (unsigned int)(vertices.size() * sizeof(float))));
+			vas.back()->AddBuffer(*vbs.back(), layout);
+			ibs.push_back(std::make_unique<IndexBuffer>(indices.data(), (unsigned int)indices.size()));
+		}
+
+		shader = std::make_unique<Shader>("res/shaders/Texture.shader");
+		shader->Bind();
+		shader->SetUniform1i("u_Texture", 0);
+		texture = std::make_unique<Texture>("res/textures/Spookzie_Logo.png");
+	}
+
+	TestGpuHeap::~TestGpuHeap()
+	{
+	}
+
+
+	void TestGpuHeap::OnUpdate(float delta_time)
+	{
+	}
+
+
+	void TestGpuHeap::OnRender()
+	{
+		glErrorCall( glClearColor(0.0f, 0.0f, 0.0f, 1.0f) );
+		glErrorCall( glClear(GL_COLOR_BUFFER_BIT) );
+
+		Renderer renderer;
+		texture->Bind();
+		shader->Bind();
+
+		unsigned int missesBefore = GLStateCache::Get().GetStats().misses;
+		auto start = std::chrono::high_resolution_clock::now();
+
+		for (size_t i = 0; i < objects.size(); i++)
+		{
+			const Object& object = objects[i];
+			if (useHeap && object.mesh == GpuHeap::invalidMesh)
+				continue;
+
+			glm::mat4 mvp = proj * glm::translate(glm::mat4(1.0f), glm::vec3(object.position, 0.0f));
+			shader->SetUniformMat4f(UNIFORM_ID("u_MVP"), mvp);
+
+			if (useHeap)
+				renderer.Draw(*heap, object.mesh, *shader);
+			else
+				renderer.Draw(*vas[i], *ibs[i], *shader);
+		}
+
+		auto end = std::chrono::high_resolution_clock::now();
+		renderTime = std::chrono::duration<float, std::milli>(end - start).count();
+		stateChanges = GLStateCache::Get().GetStats().misses - missesBefore;
+	}
+
+
+	void TestGpuHeap::OnImGuiRender()
+	{
+		ImGui::Checkbox("Draw from GpuHeap", &useHeap);
+		ImGui::Text("Meshes: %d", meshCount);
+		ImGui::Text("Draws (CPU): %.3f ms", renderTime);
+		ImGui::Text("Binds that reached GL: %u", stateChanges);
+
+		ImGui::Separator();
+		if (ImGui::Button("Free 40%"))
+		{
+			for (Object& object : objects)
+			{
+				if (object.mesh != GpuHeap::invalidMesh && rng() % 10 < 4)
+				{
+					heap->Free(object.mesh);
+					object.mesh = GpuHeap::invalidMesh;
+				}
+			}
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Refill"))
+		{
+			//Other sizes than before, the new meshes don't fit the holes exactly
+			std::uniform_int_distribution<int> sides(3, 32);
+			for (Object& object : objects)
+			{
+				if (object.mesh == GpuHeap::invalidMesh)
+				{
+					object.sides = sides(rng);
+					AllocateMesh(object);
+				}
+			}
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Compact"))
+			heap->Compact();
+
+		const OffsetAllocator::Stats pools[2] = { heap->GetVertexStats(format), heap->GetIndexStats() };
+		const char* names[2] = { "Vertices", "Indices" };
+		const unsigned int unitSizes[2] = { heap->GetStride(format), sizeof(unsigned int) };
+		for (int i = 0; i < 2; i++)
+		{
+			const OffsetAllocator::Stats& stats = pools[i];
+			ImGui::Text("%s: %.1f / %.1f KB (%u allocations)", names[i], stats.used * unitSizes[i] / 1024.0f,
+				stats.capacity * unitSizes[i] / 1024.0f, stats.allocations);
+			ImGui::ProgressBar(stats.GetUtilization(), ImVec2(-1.0f, 0.0f), "Utilization");
+			ImGui::Text("  Free ranges: %u, largest: %.1f KB, fragmentation: %.1f%%", stats.freeRanges,
+				stats.largestFree * unitSizes[i] / 1024.0f, stats.GetFragmentation() * 100.0f);
+		}
+
+		const GpuHeap::Stats& heapStats = heap->GetStats();
+		ImGui::Text("Compactions: %u, moved %.1f KB, last took %.3f ms", heapStats.compactions,
+			heapStats.bytesMoved / 1024.0f, heapStats.compactTime);
+
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+
+	void TestGpuHeap::MakePolygon(int sides, std::vector<float>& vertices, std::vector<unsigned int>& indices)
+	{
+		const float radius = 8.0f, pi = 3.14159265f;
+		vertices.clear();
+		indices.clear();
+
+		for (int i = 0; i < sides; i++)
+		{
+			float angle = 2.0f * pi * i / sides;
+			float c = std::cos(angle), s = std::sin(angle);
+			vertices.insert(vertices.end(), { c * radius, s * radius, c * 0.5f + 0.5f, s * 0.5f + 0.5f });
+		}
+
+		for (int i = 1; i + 1 < sides; i++)
+			indices.insert(indices.end(), { 0u, (unsigned int)i, (unsigned int)i + 1 });
+	}
+
+
+	void TestGpuHeap::AllocateMesh(Object& object)
+	{
+		std::vector<float> vertices;
+		std::vector<unsigned int> indices;
+		MakePolygon(object.sides, vertices, indices);
+		object.mesh = heap->Allocate(format, vertices.data(), object.sides, indices.data(), (unsigned int)indices.size());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Test.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+#include "GpuHeap.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+
+namespace test
+{
+	//Thousands of small polygons drawn one call each, either with a vertex array, vertex buffer & index buffer per mesh
+	//or sub-allocated from one GpuHeap. Meshes can be freed & refilled with other sizes to fragment the heap
+	class TestGpuHeap : public Test
+	{
+	private:
+		static const int meshCount = 4000;
+
+		struct Object
+		{
+			glm::vec2 position;
+			int sides;
+			GpuHeap::MeshID mesh;		//invalidMesh while freed
+		};
+
+		std::vector<std::unique_ptr<VertexArray>> vas;
+		std::vector<std::unique_ptr<VertexBuffer>> vbs;
+		std::vector<std::unique_ptr<IndexBuffer>> ibs;
+
+		std::unique_ptr<GpuHeap> heap;
+		unsigned int format;
+
+		std::vector<Object> objects;
+		std::unique_ptr<Shader> shader;
+		std::unique_ptr<Texture> texture;
+		glm::mat4 proj;
+		std::mt19937 rng;
+
+		bool useHeap;
+		float renderTime;			//CPU time of the draws in ms
+		unsigned int stateChanges;	//Binds that went to GL during the draws
+
+	public:
+		TestGpuHeap();
+		~TestGpuHeap();
+
+		void OnUpdate(float delta_time) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		//Triangle fan of a regular polygon, position & tex coord per vertex
+		static void MakePolygon(int sides, std::vector<float>& vertices, std::vector<unsigned int>& indices);
+		void AllocateMesh(Object& object);
+	};
+}
\ No newline at end of file
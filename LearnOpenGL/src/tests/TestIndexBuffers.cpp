@@ -0,0 +1,151 @@
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "imgui/imgui.h"
+
+#include "TestIndexBuffers.h"
+#include "Renderer.h"
+
+#include <vector>
+
+
+namespace test
+{
+	static const char* candidateNames[] = { "Triangles, 32 bit", "Triangles, automatic", "Strips + restart" };
+
+
+	TestIndexBuffers::TestIndexBuffers()
+		: proj(glm::ortho(0.0f, 1280.0f, 0.0f, 720.0f)), draws(20), preview(2), wireframe(false)
+	{
+		//A grid over most of the window, position & tex coord per vertex
+		std::vector<float> vertices;
+		for (int row = 0; row <= rows; row++)
+		{
+			for (int column = 0; column <= columns; column++)
+			{
+				float u = (float)column / columns, v = (float)row / rows;
+				vertices.insert(vertices.end(), { 40.0f + u * 1200.0f, 40.0f + v * 640.0f, u, v });
+			}
+		}
+
+		std::vector<unsigned int> triangles, strips;
+		for (int row = 0; row < rows; row++)
+		{
+			for (int column = 0; column < columns; column++)
+			{
+				unsigned int a = row * (columns + 1) + column, b = a + columns + 1;
+				triangles.insert(triangles.end(), { a, b, a + 1, a + 1, b, b + 1 });
+			}
+
+			//Zig-zag between this row of vertices & the next, then a restart before the next strip
+			if (row > 0)
+				strips.push_back(IndexBuffer::restartIndex);
+			for (int column = 0; column <= columns; column++)
+			{
+				unsigned int a = row * (columns + 1) + column;
+				strips.insert(strips.end(), { a, a + columns + 1 });
+			}
+		}
+
+		VertexBufferLayout layout;
+		layout.Push<float>(2);
+		layout.Push<float>(2);
+		va = std::make_unique<VertexArray>();
+		vb = std::make_unique<VertexBuffer>(vertices.data(), (unsigned int)(vertices.size() * sizeof(float)));
+		va->AddBuffer(*vb, layout);
+
+		candidates[0].ib = std::make_unique<IndexBuffer>(triangles.data(), (unsigned int)triangles.size(), GL_TRIANGLES, GL_UNSIGNED_INT);
+		candidates[1].ib = std::make_unique<IndexBuffer>(triangles.data(), (unsigned int)triangles.size());
+		candidates[2].ib = std::make_unique<IndexBuffer>(strips.data(), (unsigned int)strips.size(), GL_TRIANGLE_STRIP);
+
+		shader = std::make_unique<Shader>("res/shaders/Texture.shader");
+		shader->Bind();
+		shader->SetUniform1i("u_Texture", 0);
+		texture = std::make_unique<Texture>("res/textures/Spookzie_Logo.png");
+	}
+
+	TestIndexBuffers::~TestIndexBuffers()
+	{
+	}
+
+
+	void TestIndexBuffers::OnUpdate(float delta_time)
+	{
+	}
+
+
+	void TestIndexBuffers::OnRender()
+	{
+		glErrorCall( glClearColor(0.0f, 0.0f, 0.0f, 1.0f) );
+		glErrorCall( glClear(GL_COLOR_BUFFER_BIT) );
+
+		shader->Bind();
+		shader->SetUniformMat4f(UNIFORM_ID("u_MVP"), proj);
+		texture->Bind();
+		for (Candidate& candidate : candidates)
+		{
+			if (candidate.timer.Begin())
+			{
+				DrawGrids(candidate);
+				candidate.timer.End();
+			}
+		}
+
+		//Every candidate covers the same grid, the one on screen is drawn again by itself (optionally as lines)
+		glErrorCall( glClear(GL_COLOR_BUFFER_BIT) );
+		if (wireframe)
+		{
+			glErrorCall( glPolygonMode(GL_FRONT_AND_BACK, GL_LINE) );
+		}
+
+		Renderer renderer;
+		renderer.Draw(*va, *candidates[preview].ib, *shader);
+
+		if (wireframe)
+		{
+			glErrorCall( glPolygonMode(GL_FRONT_AND_BACK, GL_FILL) );
+		}
+	}
+
+
+	void TestIndexBuffers::OnImGuiRender()
+	{
+		ImGui::SliderInt("Grids per candidate", &draws, 1, 100);
+		ImGui::Combo("Preview", &preview, candidateNames, candidateCount);
+		ImGui::Checkbox("Wireframe", &wireframe);
+		ImGui::Text("%d x %d quads, %d vertices, one draw call per grid", columns, rows, (columns + 1) * (rows + 1));
+		ImGui::Text("Strips without restart would take %d draw calls per grid", rows);
+
+		ImGui::Separator();
+		ImGui::Columns(5, "candidates");
+		ImGui::Text("Indices");				ImGui::NextColumn();
+		ImGui::Text("Type");				ImGui::NextColumn();
+		ImGui::Text("Count");				ImGui::NextColumn();
+		ImGui::Text("Size (KB)");			ImGui::NextColumn();
+		ImGui::Text("GPU (ms)");			ImGui::NextColumn();
+		ImGui::Separator();
+
+		const unsigned int fullSize = candidates[0].ib->GetCount() * candidates[0].ib->GetIndexSize();
+		for (int i = 0; i < candidateCount; i++)
+		{
+			const IndexBuffer& ib = *candidates[i].ib;
+			unsigned int size = ib.GetCount() * ib.GetIndexSize();
+			ImGui::Text("%s", candidateNames[i]);									ImGui::NextColumn();
+			ImGui::Text("%u bit", ib.GetIndexSize() * 8);							ImGui::NextColumn();
+			ImGui::Text("%u", ib.GetCount());										ImGui::NextColumn();
+			ImGui::Text("%.1f (%.0f%% saved)", size / 1024.0f, 100.0f * (1.0f - (float)size / fullSize));	ImGui::NextColumn();
+			ImGui::Text("%.3f", candidates[i].timer.GetMilliseconds());								ImGui::NextColumn();
+		}
+		ImGui::Columns(1);
+
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+
+	void TestIndexBuffers::DrawGrids(const Candidate& candidate)
+	{
+		Renderer renderer;
+		for (int i = 0; i < draws; i++)
+			renderer.Draw(*va, *candidate.ib, *shader);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Test.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+#include "GpuTimer.h"
+
+#include <memory>
+
+
+namespace test
+{
+	//One grid mesh indexed three ways: a triangle list in 32 bit indices, the same list in the automatically picked type (16 bit)
+	//& triangle strips, one per row, joined by restart indices into a single draw. Index buffer size & GPU time of the draws
+	class TestIndexBuffers : public Test
+	{
+	private:
+		static const int candidateCount = 3;
+		static const int columns = 256, rows = 128;		//Quads, (columns + 1) * (rows + 1) = 33153 vertices
+
+		struct Candidate
+		{
+			std::unique_ptr<IndexBuffer> ib;
+			GpuTimer timer;
+		};
+
+		std::unique_ptr<VertexArray> va;
+		std::unique_ptr<VertexBuffer> vb;
+		std::unique_ptr<Shader> shader;
+		std::unique_ptr<Texture> texture;
+		Candidate candidates[candidateCount];
+
+		glm::mat4 proj;
+
+		int draws;		//Grids per candidate & frame
+		int preview;	//Candidate drawn on screen
+		bool wireframe;
+
+	public:
+		TestIndexBuffers();
+		~TestIndexBuffers();
+
+		void OnUpdate(float delta_time) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		void DrawGrids(const Candidate& candidate);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "imgui/imgui.h"
+
+#include "TestInstancing.h"
+#include "Renderer.h"
+
+#include <vector>
+#include <random>
+
+
+namespace test
+{
+	TestInstancing::TestInstancing()
+		: proj(glm::ortho(0.0f, 1280.0f, 0.0f, 720.0f)),
+		view(glm::mat4(1.0f)),
+		instanceCount(maxInstances)
+	{
+		//Same quad as TestTexture2D
+		float positions[] = {
+			-50.0f, -50.0f, 0.0f, 0.0f,
+			 50.0f, -50.0f, 1.0f, 0.0f,
+			 50.0f,  50.0f, 1.0f, 1.0f,
+			-50.0f,  50.0f, 0.0f, 1.0f
+		};
+
+		unsigned int indices[] = {
+			0, 1, 2,
+			2, 3, 0
+		};
+
+		//Scattering the instances over the window, scaled down so that they don't cover each other completely
+		std::vector<glm::mat4> models(maxInstances);
+		std::mt19937 rng(1234);
+		std::uniform_real_distribution<float> x(0.0f, 1280.0f), y(0.0f, 720.0f), scale(0.05f, 0.2f);
+		for (auto& model : models)
+		{
+			float s = scale(rng);
+			model = glm::translate(glm::mat4(1.0f), glm::vec3(x(rng), y(rng), 0.0f));
+			model = glm::scale(model, glm::vec3(s, s, 1.0f));
+		}
+
+		va = std::make_unique<VertexArray>();
+		vb = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+		VertexBufferLayout layout;
+		layout.Push<float>(2);
+		layout.Push<float>(2);
+		va->AddBuffer(*vb, layout);
+
+		//Second stream: attribute indices continue at 2, advancing once per instance
+		instanceVB = std::make_unique<VertexBuffer>(models.data(), maxInstances * (unsigned int)sizeof(glm::mat4));
+		VertexBufferLayout instanceLayout;
+		instanceLayout.Push<glm::mat4>(1, 1);
+		va->AddBuffer(*instanceVB, instanceLayout);
+
+		ib = std::make_unique<IndexBuffer>(indices, 6);
+
+		shader = std::make_unique<Shader>("res/shaders/Instanced.shader");
+		shader->Bind();
+		texture = std::make_unique<Texture>("res/textures/Spookzie_Logo.png");
+		shader->SetUniform1i("u_Texture", 0);
+	}
+
+	TestInstancing::~TestInstancing()
+	{
+	}
+
+
+	void TestInstancing::OnUpdate(float delta_time)
+	{
+	}
+
+
+	void TestInstancing::OnRender()
+	{
+		glErrorCall( glClearColor(0.0f, 0.0f, 0.0f, 1.0f) );
+		glErrorCall( glClear(GL_COLOR_BUFFER_BIT) );
+
+		Renderer renderer;
+		texture->Bind();
+
+		shader->Bind();
+		shader->SetUniformMat4f("u_ViewProj", proj * view);
+		renderer.DrawInstanced(*va, *ib, *shader, instanceCount);
+	}
+
+
+	void TestInstancing::OnImGuiRender()
+	{
+		ImGui::SliderInt("Instances", &instanceCount, 1, maxInstances);
+		ImGui::Text("Draw calls: 1");
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+}
\ No newline at end of file
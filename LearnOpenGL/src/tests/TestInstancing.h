@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Test.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+
+#include <memory>
+
+
+namespace test
+{
+	//Draws many copies of the TestTexture2D quad with a single instanced draw call
+	class TestInstancing : public Test
+	{
+	private:
+		std::unique_ptr<VertexArray> va;
+		std::unique_ptr<VertexBuffer> vb;
+		std::unique_ptr<VertexBuffer> instanceVB;	//One model matrix per instance
+		std::unique_ptr<IndexBuffer> ib;
+		std::unique_ptr<Shader> shader;
+		std::unique_ptr<Texture> texture;
+
+		glm::mat4 proj, view;
+
+		static const int maxInstances = 100000;
+		int instanceCount;
+
+	public:
+		TestInstancing();
+		~TestInstancing();
+
+		void OnUpdate(float delta_time) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	};
+}
\ No newline at end of file
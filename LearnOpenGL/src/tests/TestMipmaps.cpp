@@ -0,0 +1,135 @@
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "imgui/imgui.h"
+
+#include "TestMipmaps.h"
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "UniformBuffer.h"
+#include "UploadManager.h"
+
+#include <chrono>
+
+
+namespace test
+{
+	static const char* sourceFile = "res/textures/Spookzie_Logo.png";
+	static const char* sourceNames[] = { "None", "GPU (glGenerateMipmap)", "CPU box", "CPU Kaiser" };
+	static const char* filterNames[] = { "Nearest", "Bilinear", "Trilinear" };
+	static const float floorSize = 200.0f;
+	static const float floorTiles = 32.0f;
+
+
+	TestMipmaps::TestMipmaps()
+		: proj(glm::perspective(glm::radians(60.0f), 1280.0f / 720.0f, 0.1f, 500.0f)),
+		view(glm::lookAt(glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(0.0f, 0.0f, -20.0f), glm::vec3(0.0f, 1.0f, 0.0f))),
+		source(2), srgb(true), filter((int)TextureFilter::Trilinear), anisotropy(1.0f), buildTime(0.0f)
+	{
+		//The floor lies in the xy plane, the model matrix turns it flat
+		float positions[] = {
+			-floorSize, -floorSize, 0.0f, 0.0f,
+			 floorSize, -floorSize, floorTiles, 0.0f,
+			 floorSize,  floorSize, floorTiles, floorTiles,
+			-floorSize,  floorSize, 0.0f, floorTiles
+		};
+
+		unsigned int indices[] = {
+			0, 1, 2,
+			2, 3, 0
+		};
+
+		va = std::make_unique<VertexArray>();
+		vb = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+		VertexBufferLayout layout;
+		layout.Push<float>(2);
+		layout.Push<float>(2);
+		va->AddBuffer(*vb, layout);
+
+		ib = std::make_unique<IndexBuffer>(indices, 6);
+
+		shader = std::make_unique<Shader>("res/shaders/BaseShader.shader");
+		shader->Bind();
+		shader->SetUniform1i("u_Texture", 0);
+
+		Build();
+	}
+
+	TestMipmaps::~TestMipmaps()
+	{
+	}
+
+
+	void TestMipmaps::OnUpdate(float delta_time)
+	{
+	}
+
+
+	void TestMipmaps::OnRender()
+	{
+		glErrorCall( glClearColor(0.1f, 0.1f, 0.1f, 1.0f) );
+		glErrorCall( glClear(GL_COLOR_BUFFER_BIT) );
+
+		Renderer renderer;
+		texture->Bind();
+
+		FrameUniforms::Get().SetView({ view, proj, proj * view });
+		glm::mat4 model = glm::rotate(glm::mat4(1.0f), glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+		FrameUniforms::Get().SetObject({ model, glm::vec4(1.0f) });
+
+		//sRGB textures are sampled as linear colour, the framebuffer turns it back into sRGB on the way out
+		if (srgb)
+			GLStateCache::Get().Enable(GL_FRAMEBUFFER_SRGB);
+		renderer.Draw(*va, *ib, *shader);
+		if (srgb)
+			GLStateCache::Get().Disable(GL_FRAMEBUFFER_SRGB);
+	}
+
+
+	void TestMipmaps::OnImGuiRender()
+	{
+		if (ImGui::Combo("Mip levels", &source, sourceNames, 4))
+			Build();
+		if (ImGui::Checkbox("sRGB texture (filtered in linear light)", &srgb))
+			Build();
+
+		bool samplerChanged = ImGui::Combo("Filter", &filter, filterNames, 3);
+		samplerChanged |= ImGui::SliderFloat("Anisotropy", &anisotropy, 1.0f, SamplerCache::Get().GetMaxAnisotropy());
+		if (samplerChanged)
+			texture->SetSampler(GetSamplerState());
+
+		ImGui::Separator();
+		ImGui::Text("Build: %.2f ms (%d levels, %.1f KB)", buildTime, texture->GetLevelCount(), texture->GetSize() / 1024.0f);
+		ImGui::Text("Sampler objects: %u", SamplerCache::Get().GetCount());
+		ImGui::Text("Max anisotropy: %.0fx", SamplerCache::Get().GetMaxAnisotropy());
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+
+	//Decode, mip levels & upload. Large levels would go up through the upload manager over the next frames,
+	//so they are flushed here & glFinish waits until the GPU has every level (generated ones included)
+	void TestMipmaps::Build()
+	{
+		TextureParams params;
+		params.mipmaps = source == 0 ? MipmapSource::None : source == 1 ? MipmapSource::GPU : MipmapSource::CPU;
+		params.mipFilter = source == 3 ? MipFilter::Kaiser : MipFilter::Box;
+		params.srgb = srgb;
+		params.sampler = GetSamplerState();
+
+		auto start = std::chrono::high_resolution_clock::now();
+		texture = std::make_unique<Texture>(sourceFile, params);
+		UploadManager::Get().Flush(GL_TEXTURE_2D, texture->GetRendererID());
+		glErrorCall( glFinish() );
+		buildTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+
+	SamplerState TestMipmaps::GetSamplerState() const
+	{
+		SamplerState state;
+		state.filter = (TextureFilter)filter;
+		state.wrap = TextureWrap::Repeat;
+		state.anisotropy = anisotropy;
+		return state;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Test.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+
+#include <memory>
+
+
+namespace test
+{
+	//A tiled floor running into the distance, drawn with each way of making mip levels & each sampler setting,
+	//with the time every texture build took (CPU filtering included)
+	class TestMipmaps : public Test
+	{
+	private:
+		std::unique_ptr<VertexArray> va;
+		std::unique_ptr<VertexBuffer> vb;
+		std::unique_ptr<IndexBuffer> ib;
+		std::unique_ptr<Shader> shader;
+		std::unique_ptr<Texture> texture;
+
+		glm::mat4 proj, view;
+
+		int source;		//None, GPU, CPU box, CPU Kaiser
+		bool srgb;
+		int filter;		//TextureFilter
+		float anisotropy;
+		float buildTime;		//ms
+
+	public:
+		TestMipmaps();
+		~TestMipmaps();
+
+		void OnUpdate(float delta_time) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		void Build();
+		SamplerState GetSamplerState() const;
+	};
+}
\ No newline at end of file
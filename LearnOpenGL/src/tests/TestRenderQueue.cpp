@@ -0,0 +1,133 @@
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "imgui/imgui.h"
+
+#include "TestRenderQueue.h"
+#include "Renderer.h"
+
+#include <chrono>
+#include <random>
+
+
+namespace test
+{
+	TestRenderQueue::TestRenderQueue()
+		: proj(glm::ortho(0.0f, 1280.0f, 0.0f, 720.0f)),
+		view(glm::mat4(1.0f)),
+		useQueue(true), renderTime(0.0f)
+	{
+		float positions[] = {
+			-10.0f, -10.0f, 0.0f, 0.0f,
+			 10.0f, -10.0f, 1.0f, 0.0f,
+			 10.0f,  10.0f, 1.0f, 1.0f,
+			-10.0f,  10.0f, 0.0f, 1.0f
+		};
+
+		unsigned int indices[] = {
+			0, 1, 2,
+			2, 3, 0
+		};
+
+		va = std::make_unique<VertexArray>();
+		vb = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+		VertexBufferLayout layout;
+		layout.Push<float>(2);
+		layout.Push<float>(2);
+		va->AddBuffer(*vb, layout);
+
+		ib = std::make_unique<IndexBuffer>(indices, 6);
+
+		//Two separate programs, so that switching between them costs a real glUseProgram
+		for (int i = 0; i < 2; i++)
+		{
+			shaders.push_back(std::make_unique<Shader>("res/shaders/Texture.shader"));
+			shaders.back()->Bind();
+			shaders.back()->SetUniform1i("u_Texture", 0);
+		}
+
+		textures.push_back(std::make_unique<Texture>("res/textures/Spookzie_Logo.png"));
+		const unsigned char colors[3][4] = { { 255, 64, 64, 160 }, { 64, 255, 64, 160 }, { 64, 64, 255, 160 } };
+		for (const auto& color : colors)
+			textures.push_back(std::make_unique<Texture>(1, 1, color));
+
+		//Submission order is random on purpose, this is the order an unsorted renderer pays for
+		std::mt19937 rng(42);
+		std::uniform_real_distribution<float> x(0.0f, 1280.0f), y(0.0f, 720.0f), depth(0.0f, 1.0f);
+		for (int i = 0; i < 5000; i++)
+		{
+			Sprite sprite;
+			sprite.position = glm::vec3(x(rng), y(rng), depth(rng));
+			sprite.layer = rng() % 2;
+			sprite.shader = rng() % shaders.size();
+			sprite.texture = rng() % textures.size();
+			sprite.translucent = sprite.texture != 0;
+			sprites.push_back(sprite);
+		}
+	}
+
+	TestRenderQueue::~TestRenderQueue()
+	{
+	}
+
+
+	void TestRenderQueue::OnUpdate(float delta_time)
+	{
+	}
+
+
+	void TestRenderQueue::OnRender()
+	{
+		glErrorCall( glClearColor(0.0f, 0.0f, 0.0f, 1.0f) );
+		glErrorCall( glClear(GL_COLOR_BUFFER_BIT) );
+
+		auto start = std::chrono::high_resolution_clock::now();
+		Renderer renderer;
+
+		for (const Sprite& sprite : sprites)
+		{
+			glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(sprite.position.x, sprite.position.y, 0.0f));
+			glm::mat4 mvp = proj * view * model;
+			Shader* shader = shaders[sprite.shader].get();
+			const Texture* texture = textures[sprite.texture].get();
+
+			if (useQueue)
+			{
+				uint64_t key = RenderQueue::MakeKey(sprite.layer, sprite.translucent, shader->GetRendererID(),
+					texture->GetRendererID(), sprite.position.z);
+				queue.Submit({ key, va.get(), ib.get(), shader, texture, mvp });
+			}
+			else
+			{
+				texture->Bind();
+				shader->Bind();
+				shader->SetUniformMat4f(UNIFORM_ID("u_MVP"), mvp);
+				renderer.Draw(*va, *ib, *shader);
+			}
+		}
+
+		if (useQueue)
+			queue.Flush();
+
+		auto end = std::chrono::high_resolution_clock::now();
+		renderTime = std::chrono::duration<float, std::milli>(end - start).count();
+	}
+
+
+	void TestRenderQueue::OnImGuiRender()
+	{
+		ImGui::Checkbox("Use render queue", &useQueue);
+		ImGui::Text("Sprites: %u", (unsigned int)sprites.size());
+		ImGui::Text("Submit + draw (CPU): %.3f ms", renderTime);
+
+		if (useQueue)
+		{
+			const RenderQueue::Stats& stats = queue.GetStats();
+			ImGui::Text("Packets: %u", stats.packetCount);
+			ImGui::Text("State changes: %u (%u avoided)", stats.stateChanges, stats.stateChangesAvoided);
+			ImGui::Text("Sort time: %.3f ms", stats.sortTime);
+		}
+
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Test.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+#include "RenderQueue.h"
+
+#include <memory>
+#include <vector>
+
+
+namespace test
+{
+	//Draws quads with mixed shaders, textures & layers either immediately or through the sorted render queue
+	class TestRenderQueue : public Test
+	{
+	private:
+		//A quad to draw, in submission order
+		struct Sprite
+		{
+			glm::vec3 position;
+			unsigned int layer;
+			bool translucent;
+			int shader, texture;
+		};
+
+		std::unique_ptr<VertexArray> va;
+		std::unique_ptr<VertexBuffer> vb;
+		std::unique_ptr<IndexBuffer> ib;
+		std::vector<std::unique_ptr<Shader>> shaders;
+		std::vector<std::unique_ptr<Texture>> textures;
+
+		std::vector<Sprite> sprites;
+		RenderQueue queue;
+
+		glm::mat4 proj, view;
+		bool useQueue;
+		float renderTime;	//CPU time of the last OnRender() in ms
+
+	public:
+		TestRenderQueue();
+		~TestRenderQueue();
+
+		void OnUpdate(float delta_time) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "imgui/imgui.h"
+
+#include "TestShaderLoading.h"
+#include "Renderer.h"
+#include "ProgramBinaryCache.h"
+
+#include <chrono>
+#include <cmath>
+
+
+namespace test
+{
+	static const char* shaderFiles[] = {
+		"res/shaders/BaseShader.shader",
+		"res/shaders/Batch.shader",
+		"res/shaders/Instanced.shader",
+		"res/shaders/Texture.shader"
+	};
+
+
+	TestShaderLoading::TestShaderLoading()
+		: proj(glm::ortho(0.0f, 1280.0f, 0.0f, 720.0f)),
+		bypassBinaryCache(false), binaryCacheWasEnabled(ProgramBinaryCache::Get().IsEnabled()),
+		loadingFrames(0), sequentialTime(0.0f)
+	{
+		float positions[] = {
+			-100.0f, -100.0f, 0.0f, 0.0f,
+			 100.0f, -100.0f, 1.0f, 0.0f,
+			 100.0f,  100.0f, 1.0f, 1.0f,
+			-100.0f,  100.0f, 0.0f, 1.0f
+		};
+
+		unsigned int indices[] = {
+			0, 1, 2,
+			2, 3, 0
+		};
+
+		va = std::make_unique<VertexArray>();
+		vb = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+		VertexBufferLayout layout;
+		layout.Push<float>(2);
+		layout.Push<float>(2);
+		va->AddBuffer(*vb, layout);
+
+		ib = std::make_unique<IndexBuffer>(indices, 6);
+		texture = std::make_unique<Texture>("res/textures/Spookzie_Logo.png");
+
+		StartLoading();
+	}
+
+	TestShaderLoading::~TestShaderLoading()
+	{
+		ProgramBinaryCache::Get().SetEnabled(binaryCacheWasEnabled);
+	}
+
+
+	void TestShaderLoading::OnUpdate(float delta_time)
+	{
+		library->Update();
+	}
+
+
+	void TestShaderLoading::OnRender()
+	{
+		//Loading screen, it only has to prove that frames keep coming
+		if (!library->IsReady())
+		{
+			loadingFrames++;
+			float pulse = 0.5f + 0.5f * std::sin(loadingFrames * 0.1f);
+			glErrorCall( glClearColor(0.1f * pulse, 0.1f * pulse, 0.2f * pulse, 1.0f) );
+			glErrorCall( glClear(GL_COLOR_BUFFER_BIT) );
+			return;
+		}
+
+		glErrorCall( glClearColor(0.0f, 0.0f, 0.0f, 1.0f) );
+		glErrorCall( glClear(GL_COLOR_BUFFER_BIT) );
+
+		Shader* shader = library->Get("res/shaders/Texture.shader", { "ALPHA_TEST" });
+		if (!shader->GetRendererID())
+			return;
+
+		Renderer renderer;
+		texture->Bind();
+		shader->Bind();
+		shader->SetUniform1i(UNIFORM_ID("u_Texture"), 0);
+		shader->SetUniformMat4f(UNIFORM_ID("u_MVP"), glm::translate(proj, glm::vec3(640.0f, 360.0f, 0.0f)));
+		renderer.Draw(*va, *ib, *shader);
+	}
+
+
+	void TestShaderLoading::OnImGuiRender()
+	{
+		ImGui::Text("Parallel compile (GL_KHR_parallel_shader_compile): %s", library->IsParallel() ? "yes" : "no");
+		ImGui::Checkbox("Bypass program binary cache", &bypassBinaryCache);
+		if (ImGui::Button("Reload asynchronously"))
+			StartLoading();
+		ImGui::SameLine();
+		if (ImGui::Button("Load sequentially"))
+			LoadSequentially();
+
+		const ShaderLibrary::Stats& stats = library->GetStats();
+		ImGui::ProgressBar(stats.loaded ? (float)stats.finished / stats.loaded : 1.0f);
+		ImGui::Text("%u of %u shaders ready, %u frames rendered while loading", stats.finished, stats.loaded, loadingFrames);
+		ImGui::Text("Async: %.2f ms submitting, %.2f ms finishing, %.2f ms until ready", stats.submitTime, stats.finishTime, stats.loadTime);
+		const ShaderVariantCache::Stats& variantStats = library->GetVariantCache().GetStats();
+		ImGui::Text("Variants: %u requested, %u compiled, %u variant hits, %u identical source hits",
+			variantStats.requests, variantStats.compiled, variantStats.variantHits, variantStats.sourceHits);
+
+		if (sequentialTime > 0.0f)
+			ImGui::Text("Sequential: %.2f ms blocking", sequentialTime);
+
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+
+	void TestShaderLoading::StartLoading()
+	{
+		ProgramBinaryCache::Get().SetEnabled(!bypassBinaryCache);
+
+		library = std::make_unique<ShaderLibrary>();
+		loadingFrames = 0;
+		for (const char* shaderFile : shaderFiles)
+			library->Load(shaderFile);
+
+		//A real variant, one with a define Texture.shader never mentions (shares the plain program) & a repeated request
+		library->Load("res/shaders/Texture.shader", { "ALPHA_TEST" });
+		library->Load("res/shaders/Texture.shader", { "USE_VERTEX_COLOR" });
+		library->Load("res/shaders/Texture.shader");
+	}
+
+
+	//The blocking path, for comparison
+	void TestShaderLoading::LoadSequentially()
+	{
+		ProgramBinaryCache::Get().SetEnabled(!bypassBinaryCache);
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (const char* shaderFile : shaderFiles)
+			Shader shader(shaderFile);
+		auto end = std::chrono::high_resolution_clock::now();
+
+		sequentialTime = std::chrono::duration<float, std::milli>(end - start).count();
+	}
+}
\ No newline at end of file
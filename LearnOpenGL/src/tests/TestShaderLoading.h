@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Test.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+#include "ShaderLibrary.h"
+
+#include <memory>
+
+
+namespace test
+{
+	//Builds every shader through a ShaderLibrary while a loading screen keeps rendering
+	class TestShaderLoading : public Test
+	{
+	private:
+		std::unique_ptr<ShaderLibrary> library;
+		std::unique_ptr<VertexArray> va;
+		std::unique_ptr<VertexBuffer> vb;
+		std::unique_ptr<IndexBuffer> ib;
+		std::unique_ptr<Texture> texture;
+
+		glm::mat4 proj;
+
+		bool bypassBinaryCache;		//Forces cold compiles, so that there is something to wait for
+		bool binaryCacheWasEnabled;
+		unsigned int loadingFrames;		//Frames rendered while shaders were still pending
+		float sequentialTime;		//ms for building the same shaders one by one with the blocking constructor
+
+	public:
+		TestShaderLoading();
+		~TestShaderLoading();
+
+		void OnUpdate(float delta_time) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		void StartLoading();
+		void LoadSequentially();
+	};
+}
\ No newline at end of file
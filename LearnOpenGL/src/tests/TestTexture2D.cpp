@@ -5,6 +5,9 @@
 
 #include "TestTexture2D.h"
 #include "Renderer.h"
+#include "GLStateCache.h"
+#include "UniformBuffer.h"
+#include "ResourceCache.h"
 
 
 namespace test
@@ -33,8 +36,8 @@ namespace test
         };
 
         //Blending
-        glErrorCall(glEnable(GL_BLEND));
-        glErrorCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+        GLStateCache::Get().Enable(GL_BLEND);
+        GLStateCache::Get().BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
         //Setting up vertex array & buffer
         va = std::make_unique<VertexArray>();
@@ -47,9 +50,9 @@ namespace test
         ib = std::make_unique<IndexBuffer>(indices, 6);
 
         //Setting up shader & texture
-        shader = std::make_unique<Shader>("res/shaders/BaseShader.shader");
+        shader = ResourceCache::Get().GetShader("res/shaders/BaseShader.shader");
         shader->Bind();
-        texture = std::make_unique<Texture>("res/textures/Spookzie_Logo.png");
+        texture = ResourceCache::Get().GetTexture("res/textures/Spookzie_Logo.png");
         shader->SetUniform1i("u_Texture", 0);
 	}
 
@@ -72,12 +75,13 @@ namespace test
         Renderer renderer;
         texture->Bind();
 
+        //View & projection go up once, the shader combines them with each model matrix
+        FrameUniforms::Get().SetView({ view, proj, proj * view });
+
         //First
         {
             glm::mat4 model = glm::translate(glm::mat4(1.0f), translationA);
-            glm::mat4 mvp = proj * view * model;
-            shader->Bind();
-            shader->SetUniformMat4f("u_MVP", mvp);
+            FrameUniforms::Get().SetObject({ model, glm::vec4(1.0f) });
 
             renderer.Draw(*va, *ib, *shader);
         }
@@ -85,9 +89,7 @@ namespace test
         //Second
         {
             glm::mat4 model = glm::translate(glm::mat4(1.0f), translationB);
-            glm::mat4 mvp = proj * view * model;
-            shader->Bind();
-            shader->SetUniformMat4f("u_MVP", mvp);
+            FrameUniforms::Get().SetObject({ model, glm::vec4(1.0f) });
 
             renderer.Draw(*va, *ib, *shader);
         }
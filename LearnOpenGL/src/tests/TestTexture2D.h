@@ -16,8 +16,9 @@ namespace test
 		std::unique_ptr<VertexArray> va;
 		std::unique_ptr<VertexBuffer> vb;
 		std::unique_ptr<IndexBuffer> ib;
-		std::unique_ptr<Shader> shader;
-		std::unique_ptr<Texture> texture;
+		//Shared through the resource cache, reopening the test finds them resident
+		std::shared_ptr<Shader> shader;
+		std::shared_ptr<Texture> texture;		//Decoded in the background, a placeholder until then
 
 		glm::vec3 translationA, translationB;
 		glm::mat4 proj, view;
@@ -0,0 +1,178 @@
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "imgui/imgui.h"
+
+#include "TestTextureArrays.h"
+#include "Renderer.h"
+#include "StaticVertexLayout.h"
+
+#include <random>
+
+
+//Model matrix at locations 2 to 5, layer at 6
+VERTEX_LAYOUT(test::SpriteInstance,
+	VERTEX_ATTRIBUTE(test::SpriteInstance, model),
+	VERTEX_ATTRIBUTE(test::SpriteInstance, layer));
+
+
+namespace test
+{
+	TestTextureArrays::TestTextureArrays()
+		: proj(glm::ortho(0.0f, 1280.0f, 0.0f, 720.0f)),
+		mode(BatchedArray), drawCalls(0), refills(0)
+	{
+		batchRenderer = std::make_unique<BatchRenderer>();
+
+		//The same images twice: as separate textures & as layers of one array
+		TextureParams params;
+		params.mipmaps = MipmapSource::CPU;
+		textureArray = std::make_unique<TextureArray>(imageSize, imageSize, imageCount, params);
+		for (int i = 0; i < imageCount; i++)
+		{
+			std::vector<unsigned char> pixels = MakeImage(i, 0);
+			textures.push_back(std::make_unique<Texture>(imageSize, imageSize, pixels.data(), params));
+			layers.push_back(textureArray->AddLayer(pixels.data()));
+		}
+
+		std::mt19937 rng(99);
+		std::uniform_real_distribution<float> x(0.0f, 1280.0f), y(0.0f, 720.0f), scale(12.0f, 40.0f);
+		for (int i = 0; i < spriteCount; i++)
+		{
+			float s = scale(rng);
+			glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(x(rng), y(rng), 0.0f));
+			instances.push_back({ glm::scale(model, glm::vec3(s, s, 1.0f)), (float)layers[i % imageCount] });
+		}
+
+		//Unit quad, the same corners the batch renderer writes
+		float positions[] = {
+			-0.5f, -0.5f, 0.0f, 0.0f,
+			 0.5f, -0.5f, 1.0f, 0.0f,
+			 0.5f,  0.5f, 1.0f, 1.0f,
+			-0.5f,  0.5f, 0.0f, 1.0f
+		};
+
+		unsigned int indices[] = {
+			0, 1, 2,
+			2, 3, 0
+		};
+
+		va = std::make_unique<VertexArray>();
+		vb = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+		VertexBufferLayout layout;
+		layout.Push<float>(2);
+		layout.Push<float>(2);
+		va->AddBuffer(*vb, layout);
+
+		//Per instance, continuing after the quad's attributes
+		instanceVB = std::make_unique<VertexBuffer>(instances.data(), spriteCount * (unsigned int)sizeof(SpriteInstance));
+		va->AddBuffer<SpriteInstance>(*instanceVB, 1);
+
+		ib = std::make_unique<IndexBuffer>(indices, 6);
+
+		instancedShader = std::make_unique<Shader>("res/shaders/Instanced.shader", ShaderDefines{ "TEXTURE_ARRAY" });
+		instancedShader->Bind();
+		instancedShader->SetUniform1i("u_TextureArray", 0);
+	}
+
+	TestTextureArrays::~TestTextureArrays()
+	{
+	}
+
+
+	void TestTextureArrays::OnUpdate(float delta_time)
+	{
+	}
+
+
+	void TestTextureArrays::OnRender()
+	{
+		glErrorCall( glClearColor(0.0f, 0.0f, 0.0f, 1.0f) );
+		glErrorCall( glClear(GL_COLOR_BUFFER_BIT) );
+
+		if (mode == InstancedArray)
+		{
+			Renderer renderer;
+			textureArray->Bind();
+			instancedShader->Bind();
+			instancedShader->SetUniformMat4f("u_ViewProj", proj);
+			renderer.DrawInstanced(*va, *ib, *instancedShader, spriteCount);
+			drawCalls = 1;
+			return;
+		}
+
+		batchRenderer->ResetStats();
+		batchRenderer->BeginBatch(proj);
+
+		const glm::vec4 uv(0.0f, 0.0f, 1.0f, 1.0f);
+		for (int i = 0; i < spriteCount; i++)
+		{
+			if (mode == SeparateTextures)
+				batchRenderer->SubmitQuad(instances[i].model, uv, glm::vec4(1.0f), textures[i % imageCount].get());
+			else
+				batchRenderer->SubmitQuad(instances[i].model, uv, glm::vec4(1.0f), *textureArray, layers[i % imageCount]);
+		}
+
+		batchRenderer->EndBatch();
+		drawCalls = batchRenderer->GetStats().flushCount;
+	}
+
+
+	void TestTextureArrays::OnImGuiRender()
+	{
+		ImGui::RadioButton("Batched, separate textures", &mode, SeparateTextures);
+		ImGui::RadioButton("Batched, texture array", &mode, BatchedArray);
+		ImGui::RadioButton("Instanced, texture array", &mode, InstancedArray);
+		if (ImGui::Button("Free & refill 8 layers"))
+			RefillLayers();
+
+		ImGui::Text("Sprites: %d using %d textures of %dx%d", spriteCount, imageCount, imageSize, imageSize);
+		ImGui::Text("Draw calls: %u", drawCalls);
+		ImGui::Text("Array: %d / %d layers, %d levels, %.1f KB", textureArray->GetLayerCount(), textureArray->GetLayerCapacity(),
+			textureArray->GetLevelCount(), textureArray->GetSize() / 1024.0f);
+		ImGui::Text("Layers refilled: %u", refills);
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+
+	//Stripes at an angle & in a colour of their own
+	std::vector<unsigned char> TestTextureArrays::MakeImage(int index, int variant) const
+	{
+		std::vector<unsigned char> pixels(imageSize * imageSize * 4);
+		int period = 4 + index % 8 * 2 + variant;
+		for (int y = 0; y < imageSize; y++)
+		{
+			for (int x = 0; x < imageSize; x++)
+			{
+				bool stripe = ((index % 2 ? x + y : x - y + imageSize) / period) % 2 == 0;
+				unsigned char* pixel = &pixels[(y * imageSize + x) * 4];
+				pixel[0] = (unsigned char)(stripe ? 60 + (index * 37 + variant * 90) % 196 : 20);
+				pixel[1] = (unsigned char)(stripe ? 60 + (index * 71) % 196 : 20);
+				pixel[2] = (unsigned char)(stripe ? 60 + (index * 113) % 196 : 20);
+				pixel[3] = 255;
+			}
+		}
+		return pixels;
+	}
+
+
+	//Giving 8 layers back & filling them with new images, the free list hands the same layers out again
+	void TestTextureArrays::RefillLayers()
+	{
+		refills += 8;
+		int first = refills % imageCount;
+		for (int i = first; i < first + 8; i++)
+			textureArray->FreeLayer(layers[i % imageCount]);
+
+		for (int i = first; i < first + 8; i++)
+		{
+			std::vector<unsigned char> pixels = MakeImage(i % imageCount, refills / 8 % 4);
+			layers[i % imageCount] = textureArray->AddLayer(pixels.data());
+			textures[i % imageCount]->SetData(imageSize, imageSize, pixels.data());
+		}
+
+		for (int i = 0; i < spriteCount; i++)
+			instances[i].layer = (float)layers[i % imageCount];
+		instanceVB->SetData(instances.data(), spriteCount * (unsigned int)sizeof(SpriteInstance));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Test.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+#include "TextureArray.h"
+#include "BatchRenderer.h"
+
+#include <memory>
+#include <vector>
+
+
+namespace test
+{
+	//Per instance data of the instanced path, its layout is declared in the .cpp
+	struct SpriteInstance
+	{
+		glm::mat4 model;
+		float layer;
+	};
+
+	//Sprites with 64 different same-sized textures: batched with one 2D texture each (16 per batch),
+	//batched from one texture array, or instanced from it with a layer per instance
+	class TestTextureArrays : public Test
+	{
+	private:
+		static const int imageCount = 64;
+		static const int imageSize = 64;
+		static const int spriteCount = 20000;
+
+		enum Mode
+		{
+			SeparateTextures,
+			BatchedArray,
+			InstancedArray
+		};
+
+		std::unique_ptr<BatchRenderer> batchRenderer;
+		std::vector<std::unique_ptr<Texture>> textures;
+		std::unique_ptr<TextureArray> textureArray;
+		std::vector<int> layers;		//Layer of every image
+
+		std::unique_ptr<VertexArray> va;
+		std::unique_ptr<VertexBuffer> vb;
+		std::unique_ptr<VertexBuffer> instanceVB;
+		std::unique_ptr<IndexBuffer> ib;
+		std::unique_ptr<Shader> instancedShader;		//Instanced.shader with TEXTURE_ARRAY
+
+		std::vector<SpriteInstance> instances;		//Sprite i uses image i % imageCount
+		glm::mat4 proj;
+
+		int mode;
+		unsigned int drawCalls;
+		unsigned int refills;
+
+	public:
+		TestTextureArrays();
+		~TestTextureArrays();
+
+		void OnUpdate(float delta_time) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		std::vector<unsigned char> MakeImage(int index, int variant) const;
+		void RefillLayers();
+	};
+}
\ No newline at end of file
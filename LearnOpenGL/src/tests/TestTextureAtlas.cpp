@@ -0,0 +1,172 @@
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "imgui/imgui.h"
+
+#include "TestTextureAtlas.h"
+#include "Renderer.h"
+
+#include <chrono>
+#include <random>
+
+#ifdef _WIN32
+	#include <direct.h>
+#else
+	#include <sys/stat.h>
+#endif
+
+
+namespace test
+{
+	static const char* cacheDirectory = "res/textures/cache/";
+	static const char* atlasPath = "res/textures/cache/sprites";
+
+
+	TestTextureAtlas::TestTextureAtlas()
+		: proj(glm::ortho(0.0f, 1280.0f, 0.0f, 720.0f)),
+		useAtlas(true), drawCalls(), renderTime(0.0f)
+	{
+		batchRenderer = std::make_unique<BatchRenderer>();
+		atlas = std::make_unique<TextureAtlas>();
+
+		//Discs & rings of every size & colour, each one its own texture & an entry of the atlas
+		std::mt19937 rng(7);
+		std::uniform_int_distribution<int> size(12, 64), channel(64, 255);
+		for (int i = 0; i < imageCount; i++)
+		{
+			int width = size(rng), height = size(rng);
+			unsigned char color[3] = { (unsigned char)channel(rng), (unsigned char)channel(rng), (unsigned char)channel(rng) };
+			bool ring = i % 2 == 1;
+
+			std::vector<unsigned char> pixels(width * height * 4);
+			for (int y = 0; y < height; y++)
+			{
+				for (int x = 0; x < width; x++)
+				{
+					float dx = (x + 0.5f) / width * 2.0f - 1.0f, dy = (y + 0.5f) / height * 2.0f - 1.0f;
+					float distance = std::sqrt(dx * dx + dy * dy);
+					bool inside = distance <= 1.0f && (!ring || distance >= 0.6f);
+
+					unsigned char* pixel = &pixels[(y * width + x) * 4];
+					pixel[0] = color[0];
+					pixel[1] = color[1];
+					pixel[2] = color[2];
+					pixel[3] = inside ? 255 : 0;
+				}
+			}
+
+			textures.push_back(std::make_unique<Texture>(width, height, pixels.data()));
+			imageSizes.emplace_back(width, height);
+			atlas->Add("sprite" + std::to_string(i), width, height, pixels.data());
+		}
+
+		atlas->Build();
+		atlas->CreateTextures();
+		FindRegions();
+
+		std::uniform_real_distribution<float> x(0.0f, 1280.0f), y(0.0f, 720.0f);
+		std::uniform_int_distribution<int> image(0, imageCount - 1);
+		for (int i = 0; i < spriteCount; i++)
+			sprites.push_back({ glm::vec2(x(rng), y(rng)), image(rng) });
+	}
+
+	TestTextureAtlas::~TestTextureAtlas()
+	{
+	}
+
+
+	void TestTextureAtlas::OnUpdate(float delta_time)
+	{
+	}
+
+
+	void TestTextureAtlas::OnRender()
+	{
+		glErrorCall( glClearColor(0.0f, 0.0f, 0.0f, 1.0f) );
+		glErrorCall( glClear(GL_COLOR_BUFFER_BIT) );
+
+		auto start = std::chrono::high_resolution_clock::now();
+		batchRenderer->ResetStats();
+		batchRenderer->BeginBatch(proj);
+
+		for (const Sprite& sprite : sprites)
+		{
+			glm::vec2 size = imageSizes[sprite.image];
+			glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(sprite.position, 0.0f));
+			transform = glm::scale(transform, glm::vec3(size, 1.0f));
+
+			//Only the UVs & the texture differ, the atlas keeps every sprite on the same one
+			if (useAtlas)
+			{
+				const AtlasRegion& region = *regions[sprite.image];
+				batchRenderer->SubmitQuad(transform, TextureAtlas::RemapUV(region), glm::vec4(1.0f), atlas->GetTexture(region.page));
+			}
+			else
+			{
+				batchRenderer->SubmitQuad(transform, glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), glm::vec4(1.0f), textures[sprite.image].get());
+			}
+		}
+
+		batchRenderer->EndBatch();
+		drawCalls[useAtlas] = batchRenderer->GetStats().flushCount;
+
+		auto end = std::chrono::high_resolution_clock::now();
+		renderTime = std::chrono::duration<float, std::milli>(end - start).count();
+	}
+
+
+	void TestTextureAtlas::OnImGuiRender()
+	{
+		ImGui::Checkbox("Use atlas", &useAtlas);
+		if (ImGui::Button("Save & reload (offline path)"))
+			SaveAndReload();
+
+		const TextureAtlas::Stats& stats = atlas->GetStats();
+		ImGui::Text("Atlas: %u images in %u %dx%d pages, %.1f%% efficiency, packed in %.2f ms", stats.imageCount, stats.pageCount,
+			atlas->GetSettings().pageSize, atlas->GetSettings().pageSize, stats.efficiency * 100.0f, stats.packTime);
+
+		ImGui::Separator();
+		ImGui::Text("Sprites: %d using %d images", spriteCount, imageCount);
+		ImGui::Text("Draw calls: %u with separate textures, %u with the atlas (unbatched: %d)", drawCalls[0], drawCalls[1], spriteCount);
+		if (drawCalls[0] && drawCalls[1])
+			ImGui::Text("Saved by the atlas: %d draw calls per frame", (int)drawCalls[0] - (int)drawCalls[1]);
+		ImGui::Text("Submit + draw (CPU): %.3f ms", renderTime);
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+
+		//The first page, v flipped since ImGui's UVs run top-down
+		if (atlas->GetPageCount() > 0)
+		{
+			ImGui::Separator();
+			ImGui::Image((void*)(intptr_t)atlas->GetTexture(0)->GetRendererID(), ImVec2(256.0f, 256.0f), ImVec2(0.0f, 1.0f), ImVec2(1.0f, 0.0f));
+		}
+	}
+
+
+	//What the offline tool writes, read back the way a game would ship it
+	void TestTextureAtlas::SaveAndReload()
+	{
+		#ifdef _WIN32
+			_mkdir(cacheDirectory);
+		#else
+			mkdir(cacheDirectory, 0755);
+		#endif
+
+		if (!atlas->Save(atlasPath))
+			return;
+
+		std::unique_ptr<TextureAtlas> loaded = std::make_unique<TextureAtlas>();
+		if (!loaded->Load(atlasPath))
+			return;
+
+		atlas = std::move(loaded);
+		FindRegions();
+	}
+
+
+	void TestTextureAtlas::FindRegions()
+	{
+		regions.clear();
+		for (int i = 0; i < imageCount; i++)
+			regions.push_back(atlas->GetRegion("sprite" + std::to_string(i)));
+	}
+}
\ No newline at end of file
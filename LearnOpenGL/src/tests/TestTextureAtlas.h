@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Test.h"
+#include "Texture.h"
+#include "TextureAtlas.h"
+#include "BatchRenderer.h"
+
+#include <memory>
+#include <vector>
+
+
+namespace test
+{
+	//Sprite stress test: thousands of sprites using many small generated images, batched either with one texture
+	//per image (a batch holds 16 of them) or through an atlas (one texture for all), with the draw calls of both
+	class TestTextureAtlas : public Test
+	{
+	private:
+		static const int imageCount = 128;
+		static const int spriteCount = 20000;
+
+		struct Sprite
+		{
+			glm::vec2 position;
+			int image;
+		};
+
+		std::unique_ptr<BatchRenderer> batchRenderer;
+		std::vector<std::unique_ptr<Texture>> textures;		//One per image
+		std::vector<glm::ivec2> imageSizes;
+		std::unique_ptr<TextureAtlas> atlas;
+		std::vector<const AtlasRegion*> regions;		//Per image
+		std::vector<Sprite> sprites;
+
+		glm::mat4 proj;
+
+		bool useAtlas;
+		unsigned int drawCalls[2];		//Last frame with separate textures & with the atlas
+		float renderTime;		//ms
+
+	public:
+		TestTextureAtlas();
+		~TestTextureAtlas();
+
+		void OnUpdate(float delta_time) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		void SaveAndReload();
+		void FindRegions();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "imgui/imgui.h"
+
+#include "TestTextureStreaming.h"
+#include "Renderer.h"
+#include "UniformBuffer.h"
+#include "TextureStreamer.h"
+
+
+namespace test
+{
+	static const float tileSize = 10.0f;
+	static const float tileSpacing = 12.0f;
+	static const glm::vec2 viewport(1280.0f, 720.0f);
+
+
+	TestTextureStreaming::TestTextureStreaming()
+		: proj(glm::perspective(glm::radians(60.0f), viewport.x / viewport.y, 0.1f, 500.0f)),
+		cameraZ(20.0f), cameraHeight(4.0f), flyDirection(-1.0f), fly(true), previousBudget(TextureStreamer::Get().GetBudget())
+	{
+		float half = tileSize * 0.5f;
+		float positions[] = {
+			-half, -half, 0.0f, 0.0f,
+			 half, -half, 1.0f, 0.0f,
+			 half,  half, 1.0f, 1.0f,
+			-half,  half, 0.0f, 1.0f
+		};
+
+		unsigned int indices[] = {
+			0, 1, 2,
+			2, 3, 0
+		};
+
+		va = std::make_unique<VertexArray>();
+		vb = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+		VertexBufferLayout layout;
+		layout.Push<float>(2);
+		layout.Push<float>(2);
+		va->AddBuffer(*vb, layout);
+
+		ib = std::make_unique<IndexBuffer>(indices, 6);
+
+		shader = std::make_unique<Shader>("res/shaders/BaseShader.shader");
+		shader->Bind();
+		shader->SetUniform1i("u_Texture", 0);
+
+		//Far less than the ~90 MB all tiles take with every level, so the streamer has to choose
+		TextureStreamer::Get().SetBudget(24 * 1024 * 1024);
+
+		//A checkerboard with fine lines in its own colour per tile, the lines blur away in the coarse levels
+		for (int i = 0; i < gridSize * gridSize; i++)
+		{
+			glm::vec3 tint(0.4f + 0.6f * (i % 3 == 0), 0.4f + 0.6f * (i % 3 == 1), 0.4f + 0.6f * (i % 3 == 2));
+			tint *= 0.6f + 0.4f * (i % 4) / 3.0f;
+
+			TextureImage image;
+			image.width = image.height = textureSize;
+			image.levels.emplace_back(textureSize * textureSize * 4);
+			unsigned char* pixels = image.levels[0].data();
+			for (int y = 0; y < textureSize; y++)
+			{
+				for (int x = 0; x < textureSize; x++)
+				{
+					float value = ((x / 128 + y / 128) & 1) ? 1.0f : 0.35f;
+					if (x % 32 == 0 || y % 32 == 0)
+						value = 0.0f;
+
+					unsigned char* pixel = pixels + (y * textureSize + x) * 4;
+					pixel[0] = (unsigned char)(tint.r * value * 255.0f);
+					pixel[1] = (unsigned char)(tint.g * value * 255.0f);
+					pixel[2] = (unsigned char)(tint.b * value * 255.0f);
+					pixel[3] = 255;
+				}
+			}
+
+			textures.push_back(TextureStreamer::Get().Add("Tile " + std::to_string(i), std::move(image)));
+		}
+	}
+
+	TestTextureStreaming::~TestTextureStreaming()
+	{
+		TextureStreamer::Get().SetBudget(previousBudget);
+	}
+
+
+	void TestTextureStreaming::OnUpdate(float delta_time)
+	{
+		//Back & forth over the floor
+		if (fly)
+		{
+			cameraZ += flyDirection * 8.0f * ImGui::GetIO().DeltaTime;
+			if (cameraZ < -tileSpacing * gridSize)
+				flyDirection = 1.0f;
+			else if (cameraZ > 20.0f)
+				flyDirection = -1.0f;
+		}
+	}
+
+
+	void TestTextureStreaming::OnRender()
+	{
+		glErrorCall( glClearColor(0.1f, 0.1f, 0.1f, 1.0f) );
+		glErrorCall( glClear(GL_COLOR_BUFFER_BIT) );
+
+		Renderer renderer;
+		glm::mat4 view = glm::lookAt(glm::vec3(0.0f, cameraHeight, cameraZ), glm::vec3(0.0f, 0.0f, cameraZ - 12.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+		FrameUniforms::Get().SetView({ view, proj, proj * view });
+
+		float half = tileSize * 0.5f;
+		for (int i = 0; i < (int)textures.size(); i++)
+		{
+			glm::mat4 model = GetTileModel(i);
+
+			//The feedback the streamer picks levels from
+			float screenSize = TextureStreamer::GetScreenSize(proj * view * model, glm::vec2(-half), glm::vec2(half), viewport);
+			TextureStreamer::Get().Request(*textures[i], screenSize);
+
+			textures[i]->Bind();
+			FrameUniforms::Get().SetObject({ model, glm::vec4(1.0f) });
+			renderer.Draw(*va, *ib, *shader);
+		}
+	}
+
+
+	void TestTextureStreaming::OnImGuiRender()
+	{
+		ImGui::Checkbox("Fly", &fly);
+		ImGui::SliderFloat("Camera position", &cameraZ, -tileSpacing * gridSize, 20.0f);
+		ImGui::SliderFloat("Camera height", &cameraHeight, 0.5f, 40.0f);
+
+		ImGui::Separator();
+		TextureStreamer::Get().OnImGuiRender();
+	}
+
+
+	glm::mat4 TestTextureStreaming::GetTileModel(int index) const
+	{
+		float x = (index % gridSize - (gridSize - 1) * 0.5f) * tileSpacing;
+		float z = -(index / gridSize) * tileSpacing;
+		glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(x, 0.0f, z));
+		return glm::rotate(model, glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Test.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+
+#include <memory>
+#include <vector>
+
+
+namespace test
+{
+	//A floor of large generated textures the camera flies over, the TextureStreamer brings in the levels
+	//each tile needs at its on-screen size & evicts the ones behind the camera under a small budget
+	class TestTextureStreaming : public Test
+	{
+	private:
+		static const int gridSize = 4;		//Tiles per side
+		static const int textureSize = 1024;
+
+		std::unique_ptr<VertexArray> va;
+		std::unique_ptr<VertexBuffer> vb;
+		std::unique_ptr<IndexBuffer> ib;
+		std::unique_ptr<Shader> shader;
+		std::vector<std::shared_ptr<Texture>> textures;
+
+		glm::mat4 proj;
+
+		float cameraZ;
+		float cameraHeight;
+		float flyDirection;
+		bool fly;
+		unsigned int previousBudget;		//Of the streamer, given back when the test closes
+
+	public:
+		TestTextureStreaming();
+		~TestTextureStreaming();
+
+		void OnUpdate(float delta_time) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		glm::mat4 GetTileModel(int index) const;
+	};
+}
\ No newline at end of file
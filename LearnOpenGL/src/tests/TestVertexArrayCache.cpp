@@ -0,0 +1,171 @@
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "imgui/imgui.h"
+
+#include "TestVertexArrayCache.h"
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "VertexArrayCache.h"
+#include "VertexQuantizer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+
+namespace test
+{
+	static const char* modeNames[] = { "Vertex array per quad", "Cache, per buffer set", "Cache, per format (attribute binding)" };
+
+
+	TestVertexArrayCache::TestVertexArrayCache()
+		: proj(glm::ortho(0.0f, 1280.0f, 0.0f, 720.0f)), mode(CachePerFormat), sortByFormat(false),
+		attribBindingBefore(VertexArrayCache::Get().UsesAttribBinding()), renderTime(0.0f), switches(0), bufferBinds(0)
+	{
+		if (!VertexArrayCache::Get().IsAttribBindingSupported())
+			mode = CachePerBufferSet;
+
+		//16, 12 & 8 bytes per vertex
+		layouts[0].Push<float>(2);
+		layouts[0].Push<float>(2);
+		layouts[1].Push<float>(2);
+		layouts[1].Push<unsigned short>(2);
+		layouts[2].Push<Half>(2);
+		layouts[2].Push<Half>(2);
+
+		const float size = 6.0f;
+		const float positions[] = { -size, -size, size, -size, size, size, -size, size };
+		const float texCoords[] = { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f };
+
+		std::mt19937 rng(11);
+		std::uniform_real_distribution<float> x(0.0f, 1280.0f), y(0.0f, 720.0f);
+		quads.resize(quadCount);
+		for (int i = 0; i < quadCount; i++)
+		{
+			Quad& quad = quads[i];
+			quad.position = glm::vec2(x(rng), y(rng));
+			quad.format = i % formatCount;
+
+			//Every quad gets its own buffer, as separately loaded meshes would
+			std::vector<uint8_t> data(layouts[quad.format].GetStride() * 4);
+			for (int v = 0; v < 4; v++)
+			{
+				uint8_t* vertex = data.data() + v * layouts[quad.format].GetStride();
+				if (quad.format == 2)
+				{
+					uint16_t values[4] = { VertexQuantizer::FloatToHalf(positions[v * 2]), VertexQuantizer::FloatToHalf(positions[v * 2 + 1]),
+						VertexQuantizer::FloatToHalf(texCoords[v * 2]), VertexQuantizer::FloatToHalf(texCoords[v * 2 + 1]) };
+					std::copy((const uint8_t*)values, (const uint8_t*)values + sizeof(values), vertex);
+					continue;
+				}
+
+				std::copy((const uint8_t*)&positions[v * 2], (const uint8_t*)&positions[v * 2 + 2], vertex);
+				if (quad.format == 0)
+				{
+					std::copy((const uint8_t*)&texCoords[v * 2], (const uint8_t*)&texCoords[v * 2 + 2], vertex + 8);
+				}
+				else
+				{
+					unsigned short uv[2] = { (unsigned short)(texCoords[v * 2] * 65535.0f), (unsigned short)(texCoords[v * 2 + 1] * 65535.0f) };
+					std::copy((const uint8_t*)uv, (const uint8_t*)uv + sizeof(uv), vertex + 8);
+				}
+			}
+
+			quad.vb = std::make_unique<VertexBuffer>(data.data(), (unsigned int)data.size());
+			quad.va = std::make_unique<VertexArray>();
+			quad.va->AddBuffer(*quad.vb, layouts[quad.format]);
+		}
+
+		const unsigned int indices[] = { 0, 1, 2, 2, 3, 0 };
+		ib = std::make_unique<IndexBuffer>(indices, 6);
+		SetDrawOrder();
+
+		shader = std::make_unique<Shader>("res/shaders/Texture.shader");
+		shader->Bind();
+		shader->SetUniform1i("u_Texture", 0);
+		texture = std::make_unique<Texture>("res/textures/Spookzie_Logo.png");
+	}
+
+	TestVertexArrayCache::~TestVertexArrayCache()
+	{
+		VertexArrayCache::Get().SetAttribBinding(attribBindingBefore);
+	}
+
+
+	void TestVertexArrayCache::OnUpdate(float delta_time)
+	{
+	}
+
+
+	void TestVertexArrayCache::OnRender()
+	{
+		glErrorCall( glClearColor(0.0f, 0.0f, 0.0f, 1.0f) );
+		glErrorCall( glClear(GL_COLOR_BUFFER_BIT) );
+
+		VertexArrayCache& cache = VertexArrayCache::Get();
+		if (mode != VertexArrayPerQuad)
+			cache.SetAttribBinding(mode == CachePerFormat);
+
+		Renderer renderer;
+		texture->Bind();
+		shader->Bind();
+
+		unsigned int switchesBefore = GLStateCache::Get().GetStats().vertexArraySwitches;
+		unsigned int bufferBindsBefore = cache.GetStats().bufferBinds;
+		auto start = std::chrono::high_resolution_clock::now();
+
+		for (unsigned int i : drawOrder)
+		{
+			const Quad& quad = quads[i];
+			glm::mat4 mvp = proj * glm::translate(glm::mat4(1.0f), glm::vec3(quad.position, 0.0f));
+			shader->SetUniformMat4f(UNIFORM_ID("u_MVP"), mvp);
+
+			if (mode == VertexArrayPerQuad)
+				renderer.Draw(*quad.va, *ib, *shader);
+			else
+				renderer.Draw(*quad.vb, layouts[quad.format], *ib, *shader);
+		}
+
+		auto end = std::chrono::high_resolution_clock::now();
+		renderTime = std::chrono::duration<float, std::milli>(end - start).count();
+		switches = GLStateCache::Get().GetStats().vertexArraySwitches - switchesBefore;
+		bufferBinds = cache.GetStats().bufferBinds - bufferBindsBefore;
+	}
+
+
+	void TestVertexArrayCache::OnImGuiRender()
+	{
+		VertexArrayCache& cache = VertexArrayCache::Get();
+		int modes = cache.IsAttribBindingSupported() ? 3 : 2;
+		ImGui::Combo("Vertex arrays", &mode, modeNames, modes);
+		if (ImGui::Checkbox("Sort by format", &sortByFormat))
+			SetDrawOrder();
+		if (!cache.IsAttribBindingSupported())
+			ImGui::Text("No GL 4.3 / ARB_vertex_attrib_binding, one vertex array per buffer set only");
+
+		ImGui::Text("Quads: %d in %d formats", quadCount, formatCount);
+		ImGui::Text("Vertex arrays alive: %u", mode == VertexArrayPerQuad ? (unsigned int)quads.size() : cache.GetCount());
+		ImGui::Text("Vertex array switches this frame: %u", switches);
+		ImGui::Text("Vertex buffer rebinds this frame: %u", bufferBinds);
+		ImGui::Text("Draws (CPU): %.3f ms", renderTime);
+
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+
+	//Sorted, quads of one format are drawn back to back & share the format's vertex array
+	void TestVertexArrayCache::SetDrawOrder()
+	{
+		drawOrder.resize(quads.size());
+		for (unsigned int i = 0; i < drawOrder.size(); i++)
+			drawOrder[i] = i;
+
+		if (sortByFormat)
+		{
+			std::stable_sort(drawOrder.begin(), drawOrder.end(),
+				[this](unsigned int a, unsigned int b) { return quads[a].format < quads[b].format; });
+		}
+	}
+}
\ No newline at end of file
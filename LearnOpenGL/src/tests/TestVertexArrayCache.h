@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Test.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "Texture.h"
+
+#include <memory>
+#include <vector>
+
+
+namespace test
+{
+	//Thousands of quads, each with its own vertex buffer in one of three vertex formats, drawn one call each with
+	//a vertex array per quad, the VertexArrayCache with a vertex array per buffer set or per format (attribute binding):
+	//vertex arrays alive, vertex array switches & CPU time of the draws
+	class TestVertexArrayCache : public Test
+	{
+	private:
+		static const int quadCount = 3000;
+		static const int formatCount = 3;		//Float, float & normalized ushort tex coords, half
+
+		enum Mode { VertexArrayPerQuad, CachePerBufferSet, CachePerFormat };
+
+		struct Quad
+		{
+			glm::vec2 position;
+			int format;
+			std::unique_ptr<VertexBuffer> vb;
+			std::unique_ptr<VertexArray> va;		//Only used by VertexArrayPerQuad
+		};
+
+		VertexBufferLayout layouts[formatCount];
+		std::vector<Quad> quads;
+		std::vector<unsigned int> drawOrder;		//Interleaved formats or sorted by format
+		std::unique_ptr<IndexBuffer> ib;
+
+		std::unique_ptr<Shader> shader;
+		std::unique_ptr<Texture> texture;
+		glm::mat4 proj;
+
+		int mode;
+		bool sortByFormat;
+		bool attribBindingBefore;		//The cache's setting when the test started, put back on exit
+
+		float renderTime;				//CPU time of the draws in ms
+		unsigned int switches;			//Vertex array binds that reached GL during the draws
+		unsigned int bufferBinds;		//glBindVertexBuffer calls during the draws
+
+	public:
+		TestVertexArrayCache();
+		~TestVertexArrayCache();
+
+		void OnUpdate(float delta_time) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		void SetDrawOrder();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "imgui/imgui.h"
+
+#include "TestVertexFormats.h"
+#include "Renderer.h"
+#include "GLStateCache.h"
+
+#include <cmath>
+#include <vector>
+
+
+namespace test
+{
+	static const char* candidateNames[] = { "Float", "Half", "Packed" };
+
+
+	TestVertexFormats::TestVertexFormats()
+		: proj(glm::perspective(glm::radians(45.0f), 1280.0f / 720.0f, 0.1f, 100.0f)),
+		view(glm::lookAt(glm::vec3(0.0f, 0.0f, 14.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f))),
+		draws(50), preview(2)
+	{
+		//Unit sphere: position, normal, tex coord & a material index per band of slices (9 floats)
+		const float pi = 3.14159265f;
+		std::vector<float> vertices;
+		for (int stack = 0; stack <= stacks; stack++)
+		{
+			float phi = pi * stack / stacks;
+			for (int slice = 0; slice <= slices; slice++)
+			{
+				float theta = 2.0f * pi * slice / slices;
+				glm::vec3 normal(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+				vertices.insert(vertices.end(), { normal.x, normal.y, normal.z, normal.x, normal.y, normal.z,
+					(float)slice / slices, 1.0f - (float)stack / stacks, (float)(slice * 4 / (slices + 1)) });
+			}
+		}
+
+		std::vector<unsigned int> indices;
+		for (int stack = 0; stack < stacks; stack++)
+		{
+			for (int slice = 0; slice < slices; slice++)
+			{
+				unsigned int a = stack * (slices + 1) + slice, b = a + slices + 1;
+				indices.insert(indices.end(), { a, b, a + 1, a + 1, b, b + 1 });
+			}
+		}
+
+		//36, 24 & 20 bytes per vertex
+		const std::vector<VertexAttributeFormat> formats[formatCount] = {
+			{ { 3, VertexFormat::Float }, { 3, VertexFormat::Float }, { 2, VertexFormat::Float }, { 1, VertexFormat::UInt32 } },
+			{ { 3, VertexFormat::Half }, { 3, VertexFormat::Half }, { 2, VertexFormat::Half }, { 1, VertexFormat::UInt16 } },
+			{ { 3, VertexFormat::Snorm16, true }, { 3, VertexFormat::Snorm1010102 }, { 2, VertexFormat::Unorm16 }, { 1, VertexFormat::UInt8 } }
+		};
+
+		unsigned int vertexCount = (stacks + 1) * (slices + 1);
+		for (int i = 0; i < formatCount; i++)
+		{
+			Candidate& candidate = candidates[i];
+			candidate.mesh = VertexQuantizer::Quantize(vertices.data(), vertexCount, formats[i]);
+			candidate.dequantize = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(candidate.mesh.offsets[0])),
+				glm::vec3(candidate.mesh.scales[0]));
+
+			candidate.va = std::make_unique<VertexArray>();
+			candidate.vb = std::make_unique<VertexBuffer>(candidate.mesh.data.data(), candidate.mesh.GetSize());
+			candidate.va->AddBuffer(*candidate.vb, candidate.mesh.layout);
+		}
+
+		ib = std::make_unique<IndexBuffer>(indices.data(), (unsigned int)indices.size());
+
+		shader = std::make_unique<Shader>("res/shaders/Mesh.shader");
+		shader->Bind();
+		shader->SetUniform1i("u_Texture", 0);
+		texture = std::make_unique<Texture>("res/textures/Spookzie_Logo.png");
+	}
+
+	TestVertexFormats::~TestVertexFormats()
+	{
+	}
+
+
+	void TestVertexFormats::OnUpdate(float delta_time)
+	{
+	}
+
+
+	void TestVertexFormats::OnRender()
+	{
+		glErrorCall( glClearColor(0.0f, 0.0f, 0.0f, 1.0f) );
+		glErrorCall( glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT) );
+		GLStateCache::Get().Enable(GL_DEPTH_TEST);
+
+		shader->Bind();
+		texture->Bind();
+		for (Candidate& candidate : candidates)
+		{
+			if (candidate.timer.Begin())
+			{
+				DrawSpheres(candidate);
+				candidate.timer.End();
+			}
+		}
+
+		//The timed draws pile up, so the screen is cleared & only the previewed format is shown
+		glErrorCall( glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT) );
+		DrawSpheres(candidates[preview]);
+
+		GLStateCache::Get().Disable(GL_DEPTH_TEST);
+	}
+
+
+	void TestVertexFormats::OnImGuiRender()
+	{
+		ImGui::SliderInt("Spheres per format", &draws, 1, 200);
+		ImGui::Combo("Preview", &preview, candidateNames, formatCount);
+		ImGui::Text("%u vertices, %u indices per sphere", candidates[0].mesh.vertexCount, ib->GetCount());
+
+		ImGui::Separator();
+		ImGui::Columns(6, "formats");
+		ImGui::Text("Format");				ImGui::NextColumn();
+		ImGui::Text("Bytes / vertex");		ImGui::NextColumn();
+		ImGui::Text("Vertex data (KB)");	ImGui::NextColumn();
+		ImGui::Text("Max error (pos/nrm/uv)");	ImGui::NextColumn();
+		ImGui::Text("GPU (ms)");			ImGui::NextColumn();
+		ImGui::Text("Fetched (GB/s)");		ImGui::NextColumn();
+		ImGui::Separator();
+
+		for (int i = 0; i < formatCount; i++)
+		{
+			const Candidate& candidate = candidates[i];
+			const QuantizedMesh& mesh = candidate.mesh;
+			float gpuTime = candidate.timer.GetMilliseconds();
+			float fetched = gpuTime > 0.0f ? (float)mesh.GetSize() * draws / (gpuTime * 1.0e6f) : 0.0f;		//Bytes per ms * 1e-6 = GB/s
+			ImGui::Text("%s", candidateNames[i]);									ImGui::NextColumn();
+			ImGui::Text("%u", mesh.layout.GetStride());								ImGui::NextColumn();
+			ImGui::Text("%.1f (%.0f%% saved)", mesh.GetSize() / 1024.0f, 100.0f * (1.0f - (float)mesh.GetSize() / mesh.sourceSize));	ImGui::NextColumn();
+			ImGui::Text("%.1e / %.1e / %.1e", mesh.maxErrors[0], mesh.maxErrors[1], mesh.maxErrors[2]);		ImGui::NextColumn();
+			ImGui::Text("%.3f", gpuTime);											ImGui::NextColumn();
+			ImGui::Text("%.2f", fetched);											ImGui::NextColumn();
+		}
+		ImGui::Columns(1);
+
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+
+	//Spheres in rows of 10, later rows further back
+	void TestVertexFormats::DrawSpheres(const Candidate& candidate)
+	{
+		Renderer renderer;
+		for (int i = 0; i < draws; i++)
+		{
+			glm::vec3 position(((i % 10) - 4.5f) * 2.2f, ((i / 10) % 5 - 2.0f) * 2.2f, -(float)(i / 50) * 3.0f);
+			glm::mat4 mvp = proj * view * glm::translate(glm::mat4(1.0f), position) * candidate.dequantize;
+			shader->SetUniformMat4f(UNIFORM_ID("u_MVP"), mvp);
+			renderer.Draw(*candidate.va, *ib, *shader);
+		}
+	}
+}
\ No newline at end of file
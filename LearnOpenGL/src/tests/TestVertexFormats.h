@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Test.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "VertexQuantizer.h"
+#include "Texture.h"
+#include "GpuTimer.h"
+
+#include <memory>
+
+
+namespace test
+{
+	//The same sphere mesh as floats, halves & packed normalized integers (VertexQuantizer):
+	//vertex size, quantization error & vertex fetch throughput (the draws of each format timed with GL_TIME_ELAPSED)
+	class TestVertexFormats : public Test
+	{
+	private:
+		static const int formatCount = 3;		//Float, half & packed
+		static const int stacks = 128, slices = 256;
+
+		struct Candidate
+		{
+			QuantizedMesh mesh;
+			std::unique_ptr<VertexArray> va;
+			std::unique_ptr<VertexBuffer> vb;
+			glm::mat4 dequantize;		//Scale & offset of the positions
+			GpuTimer timer;				//All draws of the format
+		};
+
+		std::unique_ptr<IndexBuffer> ib;
+		std::unique_ptr<Shader> shader;
+		std::unique_ptr<Texture> texture;
+		Candidate candidates[formatCount];
+
+		glm::mat4 proj, view;
+
+		int draws;		//Spheres per format & frame
+		int preview;	//Candidate drawn on screen
+
+	public:
+		TestVertexFormats();
+		~TestVertexFormats();
+
+		void OnUpdate(float delta_time) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		void DrawSpheres(const Candidate& candidate);
+	};
+}
\ No newline at end of file
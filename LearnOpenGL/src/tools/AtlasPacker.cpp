@@ -0,0 +1,72 @@
+#include "AtlasPacker.h"
+#include "TextureAtlas.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+namespace tools
+{
+	static void PrintUsage()
+	{
+		std::cout << "Usage: LearnOpenGL --pack-atlas [--output <base>] [--page-size <texels>] [--padding <texels>] [--no-bleed]"
+			" <image>..." << std::endl;
+	}
+
+
+	int RunAtlasPacker(int argc, char** argv)
+	{
+		std::string output = "atlas";
+		TextureAtlas::Settings settings;
+		std::vector<std::string> inputs;
+
+		//  Arguments   //
+		for (int i = 0; i < argc; i++)
+		{
+			std::string argument = argv[i];
+			bool hasValue = i + 1 < argc;
+
+			if (argument == "--output" && hasValue)
+				output = argv[++i];
+			else if (argument == "--page-size" && hasValue)
+				settings.pageSize = std::atoi(argv[++i]);
+			else if (argument == "--padding" && hasValue)
+				settings.padding = std::atoi(argv[++i]);
+			else if (argument == "--no-bleed")
+				settings.bleed = false;
+			else if (argument.compare(0, 2, "--") == 0)
+			{
+				PrintUsage();
+				return 1;
+			}
+			else
+				inputs.push_back(argument);
+		}
+
+		if (inputs.empty() || settings.pageSize <= 0 || settings.padding < 0)
+		{
+			PrintUsage();
+			return 1;
+		}
+
+
+		//  Packing //
+		TextureAtlas atlas(settings);
+		for (const std::string& input : inputs)
+		{
+			if (!atlas.AddFile(input))
+				return 1;
+		}
+
+		if (!atlas.Build() || !atlas.Save(output))
+			return 1;
+
+		const TextureAtlas::Stats& stats = atlas.GetStats();
+		std::cout << stats.imageCount << " images -> " << stats.pageCount << " " << settings.pageSize << "x" << settings.pageSize
+			<< " pages (" << output << "_*.png, " << output << ".atlas), " << stats.efficiency * 100.0f << "% efficiency, "
+			<< stats.packTime << " ms" << std::endl;
+		return 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+
+namespace tools
+{
+	/*
+	Offline atlas cooking, run as: LearnOpenGL --pack-atlas [options] <image>...
+	Writes the pages as <output>_<page>.png & the UV table as <output>.atlas, TextureAtlas::Load() reads them.
+	Images are named in the table by their path as given on the command line.
+	Options:
+		--output <base>			atlas (default)
+		--page-size <texels>		2048 (default)
+		--padding <texels>		2 (default) around every image
+		--no-bleed			leaves the padding transparent instead of repeating the edges
+	Returns the process exit code.
+	*/
+	int RunAtlasPacker(int argc, char** argv);
+}
\ No newline at end of file
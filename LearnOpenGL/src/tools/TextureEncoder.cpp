@@ -0,0 +1,140 @@
+#include "TextureEncoder.h"
+#include "TextureCompressor.h"
+#include "MipGenerator.h"
+#include "stb_image/stb_image.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+namespace tools
+{
+	static void PrintUsage()
+	{
+		std::cout << "Usage: LearnOpenGL --encode-texture [--format auto|bc1|bc3] [--quality fast|high] [--container dds|ktx]"
+			" [--threads <count>] [--no-mips] [--mip-filter box|kaiser] [--srgb] <image>..." << std::endl;
+	}
+
+
+	static bool HasTransparency(const unsigned char* pixels, int width, int height)
+	{
+		for (int i = 0; i < width * height; i++)
+		{
+			if (pixels[i * 4 + 3] != 255)
+				return true;
+		}
+		return false;
+	}
+
+
+	int RunTextureEncoder(int argc, char** argv)
+	{
+		std::string format = "auto", container = "dds";
+		TextureCompressor::Quality quality = TextureCompressor::Quality::High;
+		unsigned int threadCount = 0;
+		bool mipmaps = true, srgb = false;
+		MipFilter mipFilter = MipFilter::Box;
+		std::vector<std::string> inputs;
+
+		//  Arguments   //
+		for (int i = 0; i < argc; i++)
+		{
+			std::string argument = argv[i];
+			bool hasValue = i + 1 < argc;
+
+			if (argument == "--format" && hasValue)
+				format = argv[++i];
+			else if (argument == "--quality" && hasValue)
+			{
+				std::string value = argv[++i];
+				if (value != "fast" && value != "high")
+				{
+					PrintUsage();
+					return 1;
+				}
+				quality = value == "fast" ? TextureCompressor::Quality::Fast : TextureCompressor::Quality::High;
+			}
+			else if (argument == "--container" && hasValue)
+				container = argv[++i];
+			else if (argument == "--threads" && hasValue)
+				threadCount = (unsigned int)std::atoi(argv[++i]);
+			else if (argument == "--no-mips")
+				mipmaps = false;
+			else if (argument == "--srgb")
+				srgb = true;
+			else if (argument == "--mip-filter" && hasValue)
+			{
+				std::string value = argv[++i];
+				if (value != "box" && value != "kaiser")
+				{
+					PrintUsage();
+					return 1;
+				}
+				mipFilter = value == "kaiser" ? MipFilter::Kaiser : MipFilter::Box;
+			}
+			else if (argument.compare(0, 2, "--") == 0)
+			{
+				PrintUsage();
+				return 1;
+			}
+			else
+				inputs.push_back(argument);
+		}
+
+		if (inputs.empty() || (format != "auto" && format != "bc1" && format != "bc3") || (container != "dds" && container != "ktx"))
+		{
+			PrintUsage();
+			return 1;
+		}
+
+
+		//  Encoding    //
+		//Containers are bottom-up like GL, so the images are flipped the way the texture loader flips them
+		stbi_set_flip_vertically_on_load(1);
+
+		int failures = 0;
+		for (const std::string& input : inputs)
+		{
+			int width, height, bpp;
+			unsigned char* pixels = stbi_load(input.c_str(), &width, &height, &bpp, 4);
+			if (!pixels)
+			{
+				std::cout << "ERROR::TextureEncoder.cpp::RunTextureEncoder():: Failed to decode '" << input << "'" << std::endl;
+				failures++;
+				continue;
+			}
+
+			TextureFormat textureFormat = format == "bc1" ? TextureFormat::BC1 : format == "bc3" ? TextureFormat::BC3
+				: HasTransparency(pixels, width, height) ? TextureFormat::BC3 : TextureFormat::BC1;
+
+			TextureImage source;
+			source.width = width;
+			source.height = height;
+			source.srgb = srgb;
+			source.levels.emplace_back(pixels, pixels + width * height * 4);
+			stbi_image_free(pixels);
+			if (mipmaps)
+				MipGenerator::Generate(source, mipFilter, srgb);
+
+			TextureCompressor::EncodeStats stats;
+			TextureImage image = TextureCompressor::Encode(source, textureFormat, quality, threadCount, &stats);
+
+			size_t dot = input.find_last_of('.');
+			std::string output = (dot == std::string::npos ? input : input.substr(0, dot)) + "." + container;
+			if (!TextureCompressor::Save(output, image))
+			{
+				failures++;
+				continue;
+			}
+
+			std::cout << input << " -> " << output << ": " << width << "x" << height << " " << GetTextureFormatName(textureFormat)
+				<< ", " << image.levels.size() << " levels, " << image.GetSize() / 1024 << " KB (RGBA8 " << source.GetSize() / 1024 << " KB), "
+				<< stats.time << " ms, RMSE " << stats.rmse << std::endl;
+		}
+
+		return failures ? 1 : 0;
+	}
+}
\ No newline at end of file
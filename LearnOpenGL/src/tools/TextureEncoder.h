@@ -0,0 +1,20 @@
+#pragma once
+
+
+namespace tools
+{
+	/*
+	Offline BCn encoder, run as: LearnOpenGL --encode-texture [options] <image>...
+	Every image is written next to the original with the container's extension.
+	Options:
+		--format auto|bc1|bc3		auto (default) picks BC3 for images with any transparency, BC1 otherwise
+		--quality fast|high		high (default) refines the endpoints of every block
+		--container dds|ktx		dds (default)
+		--threads <count>		0 (default) uses every hardware thread
+		--no-mips			only level 0
+		--mip-filter box|kaiser		box (default) or the sharper Kaiser filter
+		--srgb				the image is colour in sRGB, levels are averaged in linear light & stored in an sRGB format
+	Returns the process exit code.
+	*/
+	int RunTextureEncoder(int argc, char** argv);
+}
\ No newline at end of file